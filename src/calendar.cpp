@@ -0,0 +1,362 @@
+/// @brief Implementation file for classes workCalendar and calendarSet
+/// @file calendar.cpp
+
+#include "calendar.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    const long MAX_DAYS = 1L << 20;     // days per calendar, at most
+
+    const char *WEEKDAYS[] = { "Mon", "Tue", "Wed", "Thu", "Fri", "Sat",
+                               "Sun" };
+
+    // day of the week, 0 for Monday (day 0 is a Thursday)
+    int weekday(long day) {
+        return static_cast<int>(((day + 3) % 7 + 7) % 7);
+    }
+
+    // set bits of a word
+    long ones(uint64_t word) {
+        return static_cast<long>(std::bitset<64>(word).count());
+    }
+}
+
+bool parseDate(const std::string& text, long& day) {
+    static const int LENGTHS[] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30,
+                                   31 };
+    int y = 0;
+    int m = 0;
+    int d = 0;
+    char tail = 0;
+
+    if(std::sscanf(text.c_str(), "%4d-%2d-%2d%c", &y, &m, &d, &tail) != 3
+       || m < 1 || m > 12 || d < 1 || d > LENGTHS[m - 1]
+       || (m == 2 && d == 29
+           && (y % 4 != 0 || (y % 100 == 0 && y % 400 != 0)))) {
+        return false;
+    }
+
+    // days from the civil date, years starting in March
+    long year = y - (m <= 2 ? 1 : 0);
+    long era = (year >= 0 ? year : year - 399) / 400;
+    long yearOfEra = year - era * 400;
+    long dayOfYear = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100
+                    + dayOfYear;
+
+    day = era * 146097 + dayOfEra - 719468;
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+std::string formatDate(long day) {
+    char text[64];
+
+    // the civil date from days, inverse of parseDate()
+    day += 719468;
+
+    long era = (day >= 0 ? day : day - 146096) / 146097;
+    long dayOfEra = day - era * 146097;
+    long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524
+                      - dayOfEra / 146096) / 365;
+    long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4
+                                 - yearOfEra / 100);
+    long mp = (5 * dayOfYear + 2) / 153;
+    long d = dayOfYear - (153 * mp + 2) / 5 + 1;
+    long m = mp < 10 ? mp + 3 : mp - 9;
+    long y = yearOfEra + era * 400 + (m <= 2 ? 1 : 0);
+
+    std::snprintf(text, sizeof(text), "%04ld-%02ld-%02ld", y, m, d);
+
+    return text;
+}
+
+/// ----------------------------------------------------------------------------
+
+const long workCalendar::NO_DAY;
+
+workCalendar::workCalendar() {
+    first = 0;
+    days = 0;
+    before.push_back(0);
+}
+
+/// ----------------------------------------------------------------------------
+
+void workCalendar::define(const std::string& calendarName, long firstDay,
+                          long lastDay, unsigned weekMask) {
+    name = calendarName;
+    first = firstDay;
+    days = std::max(lastDay - firstDay + 1, 0L);
+    bits.assign((days + 63) / 64, 0);
+
+    for(long d = 0; d < days; d++) {
+        if(weekMask & (1u << weekday(first + d))) {
+            bits[d >> 6] |= uint64_t(1) << (d & 63);
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+void workCalendar::setDays(long firstDay, long lastDay, bool working) {
+    long from = std::max(firstDay - first, 0L);
+    long to = std::min(lastDay - first, days - 1);
+
+    for(long d = from; d <= to; d++) {
+        if(working) {
+            bits[d >> 6] |= uint64_t(1) << (d & 63);
+        } else {
+            bits[d >> 6] &= ~(uint64_t(1) << (d & 63));
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+void workCalendar::finish() {
+    before.assign(bits.size() + 1, 0);
+    workDays.clear();
+
+    for(size_t w = 0; w < bits.size(); w++) {
+        before[w + 1] = before[w] + static_cast<uint32_t>(ones(bits[w]));
+    }
+
+    for(long d = 0; d < days; d++) {
+        if(bits[d >> 6] & (uint64_t(1) << (d & 63))) {
+            workDays.push_back(static_cast<uint32_t>(d));
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+long workCalendar::rank(long day) const {
+    long d = std::min(std::max(day - first, 0L), days);
+    long word = d >> 6;
+    long bit = d & 63;
+
+    if(bit == 0) {
+        return before[word];
+    }
+
+    return before[word] + ones(bits[word] & ((uint64_t(1) << bit) - 1));
+}
+
+/// ----------------------------------------------------------------------------
+
+long workCalendar::select(long k) const {
+    if(k < 0 || k >= static_cast<long>(workDays.size())) {
+        return NO_DAY;
+    }
+
+    return first + workDays[k];
+}
+
+/// ----------------------------------------------------------------------------
+
+long workCalendar::addWork(long day, long units) const {
+    if(day < first || day > first + days) {
+        return NO_DAY;
+    }
+
+    return select(rank(day) + units);
+}
+
+/// ----------------------------------------------------------------------------
+
+long workCalendar::subtractWork(long day, long units) const {
+    if(day < first || day >= first + days) {
+        return NO_DAY;
+    }
+
+    // working days up to and including day, less the work
+    return select(rank(day + 1) - 1 - units);
+}
+
+/// ----------------------------------------------------------------------------
+
+const std::string& workCalendar::getName() const {
+    return name;
+}
+
+/// ----------------------------------------------------------------------------
+
+long workCalendar::getFirst() const {
+    return first;
+}
+
+/// ----------------------------------------------------------------------------
+
+long workCalendar::getLast() const {
+    return first + days - 1;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool calendarSet::load(const std::string& fileName) {
+    using namespace std;
+
+    ifstream inFile(fileName);
+    string line;
+    string keyword;
+    string name;
+    string text;
+    long from = 0;
+    long to = 0;
+    unsigned long long lo = 0;
+    unsigned long long hi = 0;
+    unsigned mask = 0;
+    bool valid = true;
+
+    calendars.clear();
+    ranges.clear();
+
+    if(!inFile) {
+        return false;
+    }
+
+    while(valid && getline(inFile, line)) {
+        istringstream fields(line.substr(0, line.find('#')));
+
+        if(!(fields >> keyword)) {
+            continue;
+        }
+
+        if(keyword == "calendar") {
+            valid = (fields >> name >> text) && parseDate(text, from)
+                    && (fields >> text) && parseDate(text, to) && from <= to
+                    && to - from < MAX_DAYS;
+
+            if(valid) {
+                calendars.push_back(workCalendar());
+                calendars.back().define(name, from, to, 0x1f);
+            }
+        } else if(keyword == "workdays") {
+            valid = !calendars.empty();
+            mask = 0;
+
+            while(valid && fields >> text) {
+                int d = 0;
+
+                while(d < 7 && text != WEEKDAYS[d]) {
+                    d++;
+                }
+
+                valid = d < 7;
+                mask |= 1u << d;
+            }
+
+            if(valid) {
+                workCalendar& last = calendars.back();
+
+                last.define(last.getName(), last.getFirst(), last.getLast(),
+                            mask);
+            }
+        } else if(keyword == "holiday" || keyword == "workday") {
+            valid = !calendars.empty() && (fields >> text)
+                    && parseDate(text, from);
+            to = from;
+
+            if(valid && fields >> text) {
+                valid = parseDate(text, to) && from <= to;
+            }
+
+            if(valid) {
+                calendars.back().setDays(from, to, keyword == "workday");
+            }
+        } else if(keyword == "use") {
+            calendarRange range;
+
+            valid = (fields >> name >> lo >> hi) && lo <= hi;
+            range.from = lo;
+            range.to = hi;
+            range.calendar = 0;
+
+            while(valid && range.calendar < size()
+                  && calendars[range.calendar].getName() != name) {
+                range.calendar++;
+            }
+
+            valid = valid && range.calendar < size();
+            ranges.push_back(range);
+        } else {
+            valid = false;
+        }
+
+        valid = valid && !(fields >> text);
+    }
+
+    for(size_t c = 0; c < calendars.size(); c++) {
+        calendars[c].finish();
+    }
+
+    // ranges by first milestone, which may not overlap
+    sort(ranges.begin(), ranges.end(), startsBefore);
+
+    for(size_t r = 1; valid && r < ranges.size(); r++) {
+        valid = ranges[r].from > ranges[r - 1].to;
+    }
+
+    if(!valid || calendars.empty()) {
+        calendars.clear();
+        ranges.clear();
+        return false;
+    }
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool calendarSet::startsBefore(const calendarRange& a,
+                               const calendarRange& b) {
+    return a.from < b.from;
+}
+
+/// ----------------------------------------------------------------------------
+
+int calendarSet::calendarOf(unsigned long long milestone) const {
+    int calendar = 0;
+
+    // last range starting at or before the milestone, if it reaches it
+    size_t lo = 0;
+    size_t hi = ranges.size();
+
+    while(lo < hi) {
+        size_t mid = (lo + hi) / 2;
+
+        if(ranges[mid].from <= milestone) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if(lo > 0 && ranges[lo - 1].to >= milestone) {
+        calendar = ranges[lo - 1].calendar;
+    }
+
+    return calendar;
+}
+
+/// ----------------------------------------------------------------------------
+
+const workCalendar& calendarSet::getCalendar(int index) const {
+    return calendars[index];
+}
+
+/// ----------------------------------------------------------------------------
+
+int calendarSet::size() const {
+    return static_cast<int>(calendars.size());
+}
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,190 @@
+/// @brief Header file for classes workCalendar and calendarSet
+/// @file calendar.h
+
+#ifndef H_CALENDAR
+#define H_CALENDAR
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/// ----------------------------------------------------------------------------
+/// @brief Converts a "YYYY-MM-DD" date to a day number (days since
+/// 1970-01-01, proleptic Gregorian calendar).
+///
+/// @param text Date
+/// @param day Day number
+///
+/// @return True if the date is valid, false if not
+/// ----------------------------------------------------------------------------
+bool parseDate(const std::string& text, long& day);
+
+/// ----------------------------------------------------------------------------
+/// @param day Day number
+///
+/// @return The day as "YYYY-MM-DD"
+/// ----------------------------------------------------------------------------
+std::string formatDate(long day);
+
+/// ----------------------------------------------------------------------------
+/// @class workCalendar
+///
+/// @brief Working days between two dates, stored as a bitmap (one bit per
+/// day) with the number of working days before each 64-day word, and the
+/// offset of each working day.  The working days before any day are then
+/// one lookup and a popcount, and the k-th working day one lookup, so
+/// adding working days to a date does not depend on the number of days
+/// added.
+/// ----------------------------------------------------------------------------
+class workCalendar {
+private:
+    std::string name;                 /// calendar name
+    long first;                       /// first day covered
+    long days;                        /// # of days covered
+    std::vector<uint64_t> bits;       /// bit d set if day first + d works
+    std::vector<uint32_t> before;     /// working days before each word
+    std::vector<uint32_t> workDays;   /// offset of each working day
+
+public:
+    /// day returned when a date falls outside the calendar
+    static const long NO_DAY = std::numeric_limits<long>::min();
+
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Initializes an empty calendar.
+    workCalendar();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Covers the days from first to last, the days of the week in
+    /// weekMask working (bit 0 Monday ... bit 6 Sunday).  finish() must be
+    /// called afterwards.
+    ///
+    /// @param calendarName Calendar name
+    /// @param firstDay First day covered
+    /// @param lastDay Last day covered
+    /// @param weekMask Working days of the week
+    void define(const std::string& calendarName, long firstDay, long lastDay,
+                unsigned weekMask);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Marks the days from firstDay to lastDay (clipped to the
+    /// calendar) as working or not.  finish() must be called afterwards.
+    ///
+    /// @param firstDay First day
+    /// @param lastDay Last day
+    /// @param working True for working days, false for holidays
+    void setDays(long firstDay, long lastDay, bool working);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Rebuilds the working day counts after define() or setDays().
+    void finish();
+
+    /// -----------------------------------------------------------------------
+    /// @param day Day number, clipped to the calendar
+    ///
+    /// @return # of working days before day
+    long rank(long day) const;
+
+    /// -----------------------------------------------------------------------
+    /// @param k Working day index, from 0
+    ///
+    /// @return Day of the k-th working day, NO_DAY if the calendar has fewer
+    long select(long k) const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Finish of work started on day: work starts on the first
+    /// working day from day on and the finish is the working day after the
+    /// last one worked, so a following task can start on it.
+    ///
+    /// @param day Start day
+    /// @param units Working days (may be negative)
+    ///
+    /// @return Finish day, NO_DAY if it falls outside the calendar
+    long addWork(long day, long units) const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Latest start for units of work to finish (see addWork()) by
+    /// day.
+    ///
+    /// @param day Finish day
+    /// @param units Working days (may be negative)
+    ///
+    /// @return Start day, NO_DAY if it falls outside the calendar
+    long subtractWork(long day, long units) const;
+
+    /// -----------------------------------------------------------------------
+    /// @return Calendar name
+    const std::string& getName() const;
+
+    /// -----------------------------------------------------------------------
+    /// @return First day covered
+    long getFirst() const;
+
+    /// -----------------------------------------------------------------------
+    /// @return Last day covered
+    long getLast() const;
+};
+
+/// ----------------------------------------------------------------------------
+/// @class calendarSet
+///
+/// @brief The calendars of a project and the milestones each one applies
+/// to, read from a calendar file:
+///
+///     calendar <name> <first date> <last date>
+///     workdays Mon Tue Wed Thu Fri
+///     holiday <date> [<last date>]
+///     workday <date> [<last date>]
+///     use <name> <first milestone> <last milestone>
+///
+/// "workdays", "holiday" and "workday" apply to the calendar above them;
+/// "#" starts a comment.  A task follows the calendar of the milestone it
+/// leaves, the first calendar unless a "use" range (ranges may not overlap)
+/// names another.
+/// ----------------------------------------------------------------------------
+class calendarSet {
+private:
+    /// -----------------------------------------------------------------------
+    /// @brief Milestones following one calendar.
+    struct calendarRange {
+        unsigned long long from;      /// first milestone
+        unsigned long long to;        /// last milestone
+        int calendar;                 /// calendar index
+    };
+
+    std::vector<workCalendar> calendars;    /// calendars, in file order
+    std::vector<calendarRange> ranges;      /// "use" ranges, by from
+
+    /// -----------------------------------------------------------------------
+    /// @return True if range a starts before range b
+    static bool startsBefore(const calendarRange& a, const calendarRange& b);
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief Reads a calendar file.
+    ///
+    /// @param fileName Calendar file
+    ///
+    /// @return True if the file defines at least one calendar and every
+    /// line is valid, false if not
+    bool load(const std::string& fileName);
+
+    /// -----------------------------------------------------------------------
+    /// @param milestone Milestone, as numbered in the task file
+    ///
+    /// @return Index of the calendar its tasks follow
+    int calendarOf(unsigned long long milestone) const;
+
+    /// -----------------------------------------------------------------------
+    /// @param index Calendar index
+    ///
+    /// @return The calendar
+    const workCalendar& getCalendar(int index) const;
+
+    /// -----------------------------------------------------------------------
+    /// @return # of calendars
+    int size() const;
+};
+
+#endif /* H_CALENDAR */
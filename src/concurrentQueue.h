@@ -0,0 +1,282 @@
+/// @brief Implementation file for template class concurrentQueue
+/// @file concurrentQueue.h
+
+#ifndef H_CONCURRENTQUEUE
+#define H_CONCURRENTQUEUE
+
+#include <atomic>
+#include <cstddef>
+
+#define CACHE_LINE 64    /// bytes kept between the producer and consumer index
+
+/// ----------------------------------------------------------------------------
+/// @brief queueCell for slots in the ring of a concurrentQueue
+/// ----------------------------------------------------------------------------
+template <class myType>
+struct queueCell {
+    std::atomic<std::size_t> sequence;    /// ticket of the slot's next use
+    myType data;                          /// stored element
+};
+
+/// ----------------------------------------------------------------------------
+/// @class concurrentQueue
+///
+/// @brief Bounded lock-free multi-producer/multi-consumer queue, the
+/// concurrent counterpart of linkedQueue.  Elements live in a ring of
+/// power-of-two capacity; each slot carries a sequence number so producers
+/// and consumers claim slots with one compare-and-swap on their own index
+/// and never touch a shared count.  Batch operations claim a run of slots
+/// with a single compare-and-swap.
+///
+/// Because several threads use the queue at once, front() and deleteItem()
+/// are combined: deleteItem() removes and returns the front element.
+/// ----------------------------------------------------------------------------
+template <class myType>
+class concurrentQueue {
+private:
+    queueCell<myType> *ring;            /// slots
+    std::size_t mask;                   /// capacity - 1
+
+    char pad0[CACHE_LINE];
+    std::atomic<std::size_t> enqueuePos;    /// next ticket for producers
+    char pad1[CACHE_LINE];
+    std::atomic<std::size_t> dequeuePos;    /// next ticket for consumers
+    char pad2[CACHE_LINE];
+
+    concurrentQueue(const concurrentQueue&);
+    concurrentQueue& operator=(const concurrentQueue&);
+
+public:
+    /// ------------------------------------------------------------------------
+    /// @brief (Constructor) Creates an empty queue holding at least capacity
+    /// elements (rounded up to a power of two).
+    ///
+    /// @param capacity Minimum number of elements
+    /// ------------------------------------------------------------------------
+    explicit concurrentQueue(std::size_t capacity = 1024);
+
+    /// ------------------------------------------------------------------------
+    /// @brief (Destructor) Destroys the ring.  No thread may be using the
+    /// queue.
+    /// ------------------------------------------------------------------------
+    ~concurrentQueue();
+
+    /// ------------------------------------------------------------------------
+    /// @brief Checks if queue is empty.  Only a snapshot while other threads
+    /// are adding or removing items.
+    ///
+    /// @return True if queue is empty, false if not
+    /// ------------------------------------------------------------------------
+    bool isEmptyQueue() const;
+
+    /// ------------------------------------------------------------------------
+    /// @brief Adds item to the back of the queue.
+    ///
+    /// @param newItem Item to be added to the queue
+    ///
+    /// @return False if the queue is full, true if the item was added
+    /// ------------------------------------------------------------------------
+    bool addItem(const myType& newItem);
+
+    /// ------------------------------------------------------------------------
+    /// @brief Adds up to count items to the back of the queue, in order, as
+    /// one contiguous run.
+    ///
+    /// @param items Items to be added
+    /// @param count Number of items
+    ///
+    /// @return Number of items added (fewer than count if the queue filled)
+    /// ------------------------------------------------------------------------
+    std::size_t addItems(const myType *items, std::size_t count);
+
+    /// ------------------------------------------------------------------------
+    /// @brief Removes the item at the front of the queue.
+    ///
+    /// @param item Receives the removed item
+    ///
+    /// @return False if the queue is empty, true if an item was removed
+    /// ------------------------------------------------------------------------
+    bool deleteItem(myType& item);
+
+    /// ------------------------------------------------------------------------
+    /// @brief Removes up to count items from the front of the queue.
+    ///
+    /// @param items Receives the removed items, in queue order
+    /// @param count Maximum number of items
+    ///
+    /// @return Number of items removed
+    /// ------------------------------------------------------------------------
+    std::size_t deleteItems(myType *items, std::size_t count);
+
+    /// ------------------------------------------------------------------------
+    /// @return Approximate number of elements in the queue
+    /// ------------------------------------------------------------------------
+    std::size_t queueCount() const;
+
+    /// ------------------------------------------------------------------------
+    /// @return Maximum number of elements
+    /// ------------------------------------------------------------------------
+    std::size_t capacity() const;
+};
+
+/// ----------------------------------------------------------------------------
+/// FUNCTION DEFINITIONS
+/// ----------------------------------------------------------------------------
+
+template <class myType>
+concurrentQueue<myType>::concurrentQueue(std::size_t capacity) {
+    std::size_t size = 2;
+
+    while(size < capacity) {
+        size <<= 1;
+    }
+
+    ring = new queueCell<myType>[size];
+    mask = size - 1;
+
+    for(std::size_t i = 0; i < size; i++) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    enqueuePos.store(0, std::memory_order_relaxed);
+    dequeuePos.store(0, std::memory_order_relaxed);
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class myType>
+concurrentQueue<myType>::~concurrentQueue() {
+    delete [] ring;
+    ring = nullptr;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class myType>
+bool concurrentQueue<myType>::isEmptyQueue() const {
+    return queueCount() == 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class myType>
+bool concurrentQueue<myType>::addItem(const myType& newItem) {
+    return addItems(&newItem, 1) == 1;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class myType>
+std::size_t concurrentQueue<myType>::addItems(const myType *items,
+                                              std::size_t count) {
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    std::size_t free = 0;
+    std::size_t seq = 0;
+
+    while(count > 0) {
+        // count the free slots from pos on, a slot is free for ticket t
+        // once its sequence is t
+        for(free = 0; free < count; free++) {
+            seq = ring[(pos + free) & mask].sequence
+                      .load(std::memory_order_acquire);
+
+            if(seq != pos + free) {
+                break;
+            }
+        }
+
+        if(free == 0) {
+            // full, or another producer took pos
+            if(static_cast<std::ptrdiff_t>(seq - pos) < 0) {
+                return 0;
+            }
+
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        } else if(enqueuePos.compare_exchange_weak(pos, pos + free,
+                                                   std::memory_order_relaxed)) {
+            for(std::size_t i = 0; i < free; i++) {
+                queueCell<myType>& cell = ring[(pos + i) & mask];
+
+                cell.data = items[i];
+                cell.sequence.store(pos + i + 1, std::memory_order_release);
+            }
+
+            return free;
+        }
+    }
+
+    return 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class myType>
+bool concurrentQueue<myType>::deleteItem(myType& item) {
+    return deleteItems(&item, 1) == 1;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class myType>
+std::size_t concurrentQueue<myType>::deleteItems(myType *items,
+                                                 std::size_t count) {
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    std::size_t ready = 0;
+    std::size_t seq = 0;
+
+    while(count > 0) {
+        // count the filled slots from pos on, a slot holds ticket t once its
+        // sequence is t + 1
+        for(ready = 0; ready < count; ready++) {
+            seq = ring[(pos + ready) & mask].sequence
+                      .load(std::memory_order_acquire);
+
+            if(seq != pos + ready + 1) {
+                break;
+            }
+        }
+
+        if(ready == 0) {
+            // empty, or another consumer took pos
+            if(static_cast<std::ptrdiff_t>(seq - (pos + 1)) < 0) {
+                return 0;
+            }
+
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        } else if(dequeuePos.compare_exchange_weak(pos, pos + ready,
+                                                   std::memory_order_relaxed)) {
+            for(std::size_t i = 0; i < ready; i++) {
+                queueCell<myType>& cell = ring[(pos + i) & mask];
+
+                items[i] = cell.data;
+                cell.sequence.store(pos + i + mask + 1,
+                                    std::memory_order_release);
+            }
+
+            return ready;
+        }
+    }
+
+    return 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class myType>
+std::size_t concurrentQueue<myType>::queueCount() const {
+    std::size_t back = enqueuePos.load(std::memory_order_acquire);
+    std::size_t front = dequeuePos.load(std::memory_order_acquire);
+
+    return (back > front) ? back - front : 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class myType>
+std::size_t concurrentQueue<myType>::capacity() const {
+    return mask + 1;
+}
+
+/// ----------------------------------------------------------------------------
+
+#endif /* H_CONCURRENTQUEUE */
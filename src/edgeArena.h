@@ -0,0 +1,177 @@
+/// @brief Implementation file for template class edgeArena
+/// @file edgeArena.h
+
+#ifndef H_EDGEARENA
+#define H_EDGEARENA
+
+#include <cstddef>
+#include <vector>
+
+#define ARENA_BLOCK 16384    /// list nodes per arena block
+#define CACHED_BLOCKS 16     /// max released blocks kept per thread for reuse
+
+/// ----------------------------------------------------------------------------
+/// @brief arenaBlockCache keeps released arena blocks of one thread for
+/// reuse and frees them when the thread exits
+/// ----------------------------------------------------------------------------
+template <class nodeType>
+struct arenaBlockCache {
+    std::vector<nodeType*> blocks;    /// cached blocks
+
+    ~arenaBlockCache() {
+        for(std::size_t i = 0; i < blocks.size(); i++) {
+            delete [] blocks[i];
+        }
+    }
+};
+
+/// ----------------------------------------------------------------------------
+/// @class edgeArena
+///
+/// @brief The template class edgeArena hands out adjacency list nodes from
+/// blocks of ARENA_BLOCK nodes instead of one allocation per task.  Nodes
+/// taken one after the other sit next to each other, a released node is
+/// reused by the next allocation, and all nodes are freed at once.  Freed
+/// blocks go to a per-thread cache, so the next graph built on the same
+/// worker thread reuses them.  nodeType needs a "link" member.
+/// ----------------------------------------------------------------------------
+template <class nodeType>
+class edgeArena {
+private:
+    std::vector<nodeType*> blocks;    /// blocks in use, the last one filling
+    std::size_t used;                 /// nodes handed out from the last block
+    nodeType *freeNodes;              /// released nodes, linked by "link"
+
+    /// per-thread cache of released blocks, reused by later arenas
+    static thread_local arenaBlockCache<nodeType> freeBlocks;
+
+public:
+    /// ------------------------------------------------------------------------
+    /// @brief (Constructor) Creates an arena without blocks.
+    /// ------------------------------------------------------------------------
+    edgeArena();
+
+    /// ------------------------------------------------------------------------
+    /// @brief (Destructor) Returns the blocks, see clear().
+    /// ------------------------------------------------------------------------
+    ~edgeArena();
+
+    edgeArena(const edgeArena&) = delete;
+    edgeArena& operator=(const edgeArena&) = delete;
+
+    /// ------------------------------------------------------------------------
+    /// @return Uninitialized node, valid until released or cleared
+    /// ------------------------------------------------------------------------
+    nodeType* allocate();
+
+    /// ------------------------------------------------------------------------
+    /// @brief Hands a node back for reuse by allocate().
+    ///
+    /// @param node Node taken from this arena
+    /// ------------------------------------------------------------------------
+    void release(nodeType *node);
+
+    /// ------------------------------------------------------------------------
+    /// @brief Frees every node at once, returning the blocks to the thread's
+    /// cache or deleting them if the cache is full.
+    /// ------------------------------------------------------------------------
+    void clear();
+
+    /// ------------------------------------------------------------------------
+    /// @brief Exchanges the nodes of two arenas.
+    ///
+    /// @param other Arena to swap with
+    /// ------------------------------------------------------------------------
+    void swap(edgeArena& other);
+};
+
+/// ----------------------------------------------------------------------------
+/// FUNCTION DEFINITIONS
+/// ----------------------------------------------------------------------------
+
+template <class nodeType>
+thread_local arenaBlockCache<nodeType> edgeArena<nodeType>::freeBlocks;
+
+/// ----------------------------------------------------------------------------
+
+template <class nodeType>
+edgeArena<nodeType>::edgeArena() {
+    used = ARENA_BLOCK;
+    freeNodes = nullptr;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class nodeType>
+edgeArena<nodeType>::~edgeArena() {
+    clear();
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class nodeType>
+nodeType* edgeArena<nodeType>::allocate() {
+    nodeType *node = freeNodes;
+
+    if(node != nullptr) {
+        freeNodes = node->link;
+        return node;
+    }
+
+    // last block is full, take a cached block or a new one
+    if(used == ARENA_BLOCK) {
+        if(freeBlocks.blocks.empty()) {
+            blocks.push_back(new nodeType[ARENA_BLOCK]);
+        } else {
+            blocks.push_back(freeBlocks.blocks.back());
+            freeBlocks.blocks.pop_back();
+        }
+
+        used = 0;
+    }
+
+    return &blocks.back()[used++];
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class nodeType>
+void edgeArena<nodeType>::release(nodeType *node) {
+    node->link = freeNodes;
+    freeNodes = node;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class nodeType>
+void edgeArena<nodeType>::clear() {
+    for(std::size_t i = 0; i < blocks.size(); i++) {
+        if(freeBlocks.blocks.size() < CACHED_BLOCKS) {
+            freeBlocks.blocks.push_back(blocks[i]);
+        } else {
+            delete [] blocks[i];
+        }
+    }
+
+    blocks.clear();
+    used = ARENA_BLOCK;
+    freeNodes = nullptr;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class nodeType>
+void edgeArena<nodeType>::swap(edgeArena& other) {
+    std::size_t otherUsed = other.used;
+    nodeType *otherFree = other.freeNodes;
+
+    blocks.swap(other.blocks);
+    other.used = used;
+    other.freeNodes = freeNodes;
+    used = otherUsed;
+    freeNodes = otherFree;
+}
+
+/// ----------------------------------------------------------------------------
+
+#endif /* H_EDGEARENA */
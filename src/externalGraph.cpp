@@ -0,0 +1,614 @@
+/// @brief Implementation file for class ganttExternal
+/// @file externalGraph.cpp
+
+#include "externalGraph.h"
+#include "taskStream.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+#include <unistd.h>
+
+namespace {
+    const int MAX_FANIN = 64;         // runs merged at once
+    const long MIN_BUFFER = 1 << 16;  // smallest edge buffer in bytes
+
+    // ------------------------------------------------------------------------
+    // Creates an empty temporary file in $TMPDIR (or /tmp), returns its path.
+    // ------------------------------------------------------------------------
+    std::string tempFile() {
+        const char *dir = std::getenv("TMPDIR");
+        std::string path = std::string(dir != nullptr ? dir : "/tmp")
+                           + "/ganttXXXXXX";
+        std::vector<char> name(path.begin(), path.end());
+        name.push_back('\0');
+
+        int fd = mkstemp(&name[0]);
+
+        if(fd == -1) {
+            throw std::runtime_error("can not create temporary file");
+        }
+
+        close(fd);
+
+        return std::string(&name[0]);
+    }
+
+    // ------------------------------------------------------------------------
+    // Sorts a stream of records with bounded memory: full buffers are sorted
+    // and written as run files, which merge() combines in order.
+    // ------------------------------------------------------------------------
+    template <class myType, class lessThan>
+    class runSorter {
+    private:
+        std::vector<myType> buffer;       // records of the current run
+        size_t capacity;                  // records per run
+        std::vector<std::string> runs;    // run files not yet merged
+        lessThan less;
+
+        struct runHead {
+            myType record;
+            int run;
+        };
+
+        // heap order, smallest record (then lowest run) on top
+        struct headGreater {
+            lessThan less;
+
+            bool operator()(const runHead& a, const runHead& b) const {
+                if(less(b.record, a.record)) {
+                    return true;
+                }
+
+                return !less(a.record, b.record) && a.run > b.run;
+            }
+        };
+
+        void flushRun() {
+            std::stable_sort(buffer.begin(), buffer.end(), less);
+
+            std::string name = tempFile();
+            std::FILE *file = std::fopen(name.c_str(), "wb");
+
+            std::fwrite(buffer.data(), sizeof(myType), buffer.size(), file);
+            std::fclose(file);
+
+            runs.push_back(name);
+            buffer.clear();
+        }
+
+        // merges runs [first, last) and passes each record to sink
+        template <class sinkType>
+        void mergeRuns(size_t first, size_t last, sinkType& sink) {
+            size_t count = last - first;
+            size_t chunk = std::max<size_t>(capacity / (count + 1), 256);
+            std::vector<std::FILE*> files(count);
+            std::vector<std::vector<myType> > blocks(count);
+            std::vector<size_t> used(count, 0);
+            std::vector<runHead> heap;
+            headGreater greater;
+            runHead head;
+
+            for(size_t r = 0; r < count; r++) {
+                files[r] = std::fopen(runs[first + r].c_str(), "rb");
+                blocks[r].resize(chunk);
+                blocks[r].resize(std::fread(blocks[r].data(), sizeof(myType),
+                                            chunk, files[r]));
+
+                if(!blocks[r].empty()) {
+                    head.record = blocks[r][0];
+                    head.run = static_cast<int>(r);
+                    heap.push_back(head);
+                }
+            }
+
+            std::make_heap(heap.begin(), heap.end(), greater);
+
+            while(!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), greater);
+                head = heap.back();
+                heap.pop_back();
+
+                sink(head.record);
+
+                size_t r = static_cast<size_t>(head.run);
+
+                // refill the run's block when it runs out
+                if(++used[r] == blocks[r].size()) {
+                    blocks[r].resize(chunk);
+                    blocks[r].resize(std::fread(blocks[r].data(),
+                                                sizeof(myType), chunk,
+                                                files[r]));
+                    used[r] = 0;
+                }
+
+                if(used[r] < blocks[r].size()) {
+                    head.record = blocks[r][used[r]];
+                    heap.push_back(head);
+                    std::push_heap(heap.begin(), heap.end(), greater);
+                }
+            }
+
+            for(size_t r = 0; r < count; r++) {
+                std::fclose(files[r]);
+                std::remove(runs[first + r].c_str());
+            }
+        }
+
+        // writes every record to a new run file
+        struct runWriter {
+            std::FILE *file;
+
+            void operator()(const myType& record) {
+                std::fwrite(&record, sizeof(myType), 1, file);
+            }
+        };
+
+    public:
+        explicit runSorter(long memBytes) {
+            capacity = std::max<size_t>(memBytes / sizeof(myType), 1024);
+            buffer.reserve(capacity);
+        }
+
+        ~runSorter() {
+            for(size_t r = 0; r < runs.size(); r++) {
+                std::remove(runs[r].c_str());
+            }
+        }
+
+        void add(const myType& record) {
+            buffer.push_back(record);
+
+            if(buffer.size() == capacity) {
+                flushRun();
+            }
+        }
+
+        // passes every record to sink in sorted order (stable by arrival)
+        template <class sinkType>
+        void merge(sinkType& sink) {
+            if(runs.empty()) {
+                std::stable_sort(buffer.begin(), buffer.end(), less);
+
+                for(size_t i = 0; i < buffer.size(); i++) {
+                    sink(buffer[i]);
+                }
+
+                buffer.clear();
+                return;
+            }
+
+            if(!buffer.empty()) {
+                flushRun();
+            }
+
+            std::vector<myType>().swap(buffer);
+
+            // earlier runs first keeps the merge stable
+            while(runs.size() > static_cast<size_t>(MAX_FANIN)) {
+                std::vector<std::string> merged;
+
+                for(size_t r = 0; r < runs.size(); r += MAX_FANIN) {
+                    size_t last = std::min(runs.size(), r + MAX_FANIN);
+                    runWriter writer;
+                    std::string name = tempFile();
+
+                    writer.file = std::fopen(name.c_str(), "wb");
+                    mergeRuns(r, last, writer);
+                    std::fclose(writer.file);
+                    merged.push_back(name);
+                }
+
+                runs.swap(merged);
+            }
+
+            mergeRuns(0, runs.size(), sink);
+            runs.clear();
+        }
+    };
+
+    // task as read from the file, seq keeps file order through the sort
+    struct seqRecord {
+        edgeRecord edge;
+        long seq;
+    };
+
+    struct sourceLess {
+        bool operator()(const seqRecord& a, const seqRecord& b) const {
+            if(a.edge.from != b.edge.from) {
+                return a.edge.from < b.edge.from;
+            }
+
+            return a.seq < b.seq;
+        }
+    };
+
+    struct destLess {
+        bool operator()(const edgeRecord& a, const edgeRecord& b) const {
+            if(a.to != b.to) {
+                return a.to < b.to;
+            }
+
+            return a.from < b.from;
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // Receives the source-sorted tasks, merges a task with the previous one
+    // of the same source when both have the same destination (as addEdge
+    // does with the head of the list), writes the result and feeds the
+    // destination sort.
+    // ------------------------------------------------------------------------
+    struct sourceSink {
+        std::FILE *file;
+        runSorter<edgeRecord, destLess> *destSorter;
+        std::vector<long> *outStart;
+        std::vector<int> *indeg;
+        edgeRecord last;
+        bool pending;
+        long written;
+
+        void flush() {
+            if(pending) {
+                std::fwrite(&last, sizeof(edgeRecord), 1, file);
+                destSorter->add(last);
+                (*outStart)[last.from + 1]++;
+                (*indeg)[last.to]++;
+                written++;
+                pending = false;
+            }
+        }
+
+        void operator()(const seqRecord& record) {
+            if(pending && last.from == record.edge.from
+               && last.to == record.edge.to) {
+                last.weight = record.edge.weight;
+                return;
+            }
+
+            flush();
+            last = record.edge;
+            pending = true;
+        }
+    };
+
+    struct destSink {
+        std::FILE *file;
+        std::vector<long> *inStart;
+
+        void operator()(const edgeRecord& record) {
+            std::fwrite(&record, sizeof(edgeRecord), 1, file);
+            (*inStart)[record.to + 1]++;
+        }
+    };
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttExternal::ganttExternal() {
+    milestoneCount = 0;
+    taskCount = 0;
+    sourceNode = 0;
+    memLimit = 0;
+    finalNode = 0;
+    duration = 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttExternal::~ganttExternal() {
+    if(!bySource.empty()) {
+        std::remove(bySource.c_str());
+    }
+
+    if(!byDest.empty()) {
+        std::remove(byDest.c_str());
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+bool ganttExternal::readGraph(const std::string fileName, long memBytes) {
+    using namespace std;
+
+    string ignore;
+    seqRecord record;
+    long seq = 0;
+
+    taskStream inFile(fileName);
+
+    if(!inFile) {
+        return false;
+    }
+
+    getline(inFile, title, '\n');
+
+    if(title.substr(0, 6) == "title:") {
+        title.erase(0, 6);
+    }
+
+    inFile >> ignore >> milestoneCount;
+    inFile >> ignore >> sourceNode;
+
+    if(milestoneCount <= 0) {
+        return false;
+    }
+
+    // both sorts hold a buffer at once while the first one merges
+    memLimit = max(memBytes / 2, MIN_BUFFER);
+
+    runSorter<seqRecord, sourceLess> sourceSorter(memLimit);
+    runSorter<edgeRecord, destLess> destSorter(memLimit);
+
+    while(inFile >> record.edge.from >> record.edge.to >> record.edge.weight) {
+        if(record.edge.from < milestoneCount && record.edge.to < milestoneCount
+           && record.edge.from >= 0 && record.edge.to >= 0
+           && record.edge.from != record.edge.to) {
+            record.seq = seq++;
+            sourceSorter.add(record);
+        }
+    }
+
+    if(inFile.isCorrupt()) {
+        return false;
+    }
+
+    indeg.assign(milestoneCount, 0);
+    outStart.assign(milestoneCount + 1, 0);
+    inStart.assign(milestoneCount + 1, 0);
+
+    sourceSink toSource;
+    bySource = tempFile();
+    toSource.file = fopen(bySource.c_str(), "wb");
+    toSource.destSorter = &destSorter;
+    toSource.outStart = &outStart;
+    toSource.indeg = &indeg;
+    toSource.pending = false;
+    toSource.written = 0;
+
+    sourceSorter.merge(toSource);
+    toSource.flush();
+    fclose(toSource.file);
+    taskCount = toSource.written;
+
+    destSink toDest;
+    byDest = tempFile();
+    toDest.file = fopen(byDest.c_str(), "wb");
+    toDest.inStart = &inStart;
+
+    destSorter.merge(toDest);
+    fclose(toDest.file);
+
+    // counts to offsets
+    for(int v = 0; v < milestoneCount; v++) {
+        outStart[v + 1] += outStart[v];
+        inStart[v + 1] += inStart[v];
+    }
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttExternal::readRecords(std::FILE *file, long first, long last,
+                                std::vector<edgeRecord>& records) {
+    records.resize(last - first);
+    std::fseek(file, first * static_cast<long>(sizeof(edgeRecord)), SEEK_SET);
+    records.resize(std::fread(records.data(), sizeof(edgeRecord),
+                              records.size(), file));
+}
+
+/// ----------------------------------------------------------------------------
+
+bool ganttExternal::topoSort() {
+    std::vector<int> indegCopy(indeg);
+    std::vector<edgeRecord> block;
+    long chunk = std::max<long>(memLimit / sizeof(edgeRecord), 1024);
+    long first = 0;
+    std::size_t next = 0;  // first milestone of topoNodes not yet swept
+    int v = 0;
+    int u = 0;
+
+    std::FILE *file = std::fopen(bySource.c_str(), "rb");
+
+    // topoNodes is its own queue: milestones are appended as they become
+    // ready and swept in that order, which is the order a FIFO gives
+    topoNodes.clear();
+    topoNodes.reserve(milestoneCount);
+    dist.assign(milestoneCount, 0);
+
+    for(v = 0; v < milestoneCount; v++) {
+        if(indegCopy[v] == 0) {
+            topoNodes.push_back(v);
+        }
+    }
+
+    while(next < topoNodes.size()) {
+        v = topoNodes[next];
+        next++;
+
+        // the in-memory list is newest first, so read the block backwards
+        for(long last = outStart[v + 1]; last > outStart[v]; last = first) {
+            first = std::max(outStart[v], last - chunk);
+            readRecords(file, first, last, block);
+
+            for(long i = static_cast<long>(block.size()) - 1; i >= 0; i--) {
+                u = block[i].to;
+                dist[u] = std::max(dist[u], dist[v] + block[i].weight);
+                indegCopy[u]--;
+
+                if(indegCopy[u] == 0) {
+                    topoNodes.push_back(u);
+                }
+            }
+        }
+    }
+
+    std::fclose(file);
+
+    return static_cast<int>(topoNodes.size()) == milestoneCount;
+}
+
+/// ----------------------------------------------------------------------------
+
+long ganttExternal::getTaskCount() const {
+    return taskCount;
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttExternal::criticalPath() {
+    std::vector<edgeRecord> block;
+    std::FILE *file = std::fopen(byDest.c_str(), "rb");
+    int curr = 0;
+    int last = -1;         // predecessor taken last in the current sweep
+    int next = 0;
+    int wrapped = 0;
+
+    // find final task and project duration
+    finalNode = sourceNode;
+    duration = 0;
+
+    for(int v = 0; v < milestoneCount; v++) {
+        if(dist[v] > duration) {
+            duration = dist[v];
+            finalNode = v;
+        }
+    }
+
+    // ganttUtils sweeps all vertices in order, taking every tight edge into
+    // the current milestone; so the next one is the smallest tight
+    // predecessor after the last one taken, or else the smallest overall
+    // once a new sweep starts
+    crPath.clear();
+    crPath.push_back(finalNode);
+    curr = finalNode;
+
+    // no sweep at all when the final node is the source
+    while(curr != sourceNode || last != -1) {
+        readRecords(file, inStart[curr], inStart[curr + 1], block);
+        next = -1;
+        wrapped = -1;
+
+        for(size_t i = 0; i < block.size(); i++) {
+            if(dist[curr] == dist[block[i].from] + block[i].weight) {
+                if(block[i].from > last
+                   && (next == -1 || block[i].from < next)) {
+                    next = block[i].from;
+                }
+
+                if(wrapped == -1 || block[i].from < wrapped) {
+                    wrapped = block[i].from;
+                }
+            }
+        }
+
+        // end of a sweep, stop if the source has been reached
+        if(next == -1) {
+            if(curr == sourceNode || wrapped == -1) {
+                break;
+            }
+
+            next = wrapped;
+        }
+
+        crPath.push_back(next);
+        curr = next;
+        last = next;
+    }
+
+    std::fclose(file);
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttExternal::findSlackTimes() {
+    std::vector<edgeRecord> block;
+    std::FILE *file = std::fopen(bySource.c_str(), "rb");
+
+    slackTimes.assign(milestoneCount, -1);
+
+    for(size_t i = 0; i < crPath.size(); i++) {
+        slackTimes[crPath[i]] = 0;
+    }
+
+    // the tail of the in-memory list is the first task read for a source
+    for(int u = 0; u < milestoneCount; u++) {
+        if(slackTimes[u] == -1 && outStart[u + 1] > outStart[u]) {
+            readRecords(file, outStart[u], outStart[u] + 1, block);
+            slackTimes[u] = dist[block[0].to] - (dist[u] + block[0].weight);
+        }
+    }
+
+    std::fclose(file);
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttExternal::printGraphInformation(std::ostream& out) {
+    using namespace std;
+
+    out << "------------------------------------------------------------\n"
+        << "Graph Information (external memory)\n"
+        << "   Project title: " << title << endl
+        << "   Milestone Count: " << milestoneCount << endl
+        << "   Task Count: " << taskCount << endl
+        << "   Source Milestone: " << sourceNode << endl
+        << "   Edge Buffer: " << memLimit / (1024 * 1024) << " MB\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttExternal::printTopoSort(std::ostream& out) {
+    using namespace std;
+
+    out << "------------------------------------------------------------\n"
+        << "Topological Sort: \n";
+
+    for(int i = 0; i < milestoneCount; i++) {
+        out << ' ' << topoNodes[i];
+    }
+
+    out << "\n\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttExternal::printCriticalPath(std::ostream& out) {
+    using namespace std;
+
+    out << "------------------------------------------------------------\n"
+        << "Critical Path:\n"
+        << "   Source Node: " << sourceNode << endl
+        << "   Final Task: " << finalNode << endl
+        << "   Total Duration: " << duration << endl << endl
+        << "Critical Path: \n";
+
+    for(int v = static_cast<int>(crPath.size()) - 1; v >= 0; v--) {
+        out << ' ' << crPath[v];
+    }
+
+    out << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttExternal::printSlackTimes(std::ostream& out) {
+    using namespace std;
+
+    out << "------------------------------------------------------------\n"
+        << "Slack Times (task-slacktime):\n";
+
+    for(int i = 0; i < milestoneCount && slackTimes[i] != -1; i++) {
+        if(slackTimes[i] != 0) {
+            out << ' ' << i << '-' << slackTimes[i];
+        }
+    }
+
+    out << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
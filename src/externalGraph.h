@@ -0,0 +1,129 @@
+/// @brief Header file for class ganttExternal
+/// @file externalGraph.h
+
+#ifndef H_EXTERNALGRAPH
+#define H_EXTERNALGRAPH
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// ----------------------------------------------------------------------------
+/// @brief Task record as stored in the sorted edge files.
+/// ----------------------------------------------------------------------------
+struct edgeRecord {
+    int from;      /// source vertex
+    int to;        /// destination vertex
+    int weight;    /// edge weight
+};
+
+/// ----------------------------------------------------------------------------
+/// @class ganttExternal
+///
+/// @brief Out-of-core variant of the ganttUtils topological sort, critical
+/// path and slack analysis for task files with more edges than fit in memory.
+/// The edge list is sorted externally by source and by destination into
+/// temporary files, using at most memLimit bytes for edge buffers.  Only
+/// per-milestone arrays (degrees, distances, file offsets) are kept in memory.
+/// Results match the in-memory analysis, including its tie-breaking.
+/// ----------------------------------------------------------------------------
+class ganttExternal {
+private:
+    std::string title;        /// project title
+    int milestoneCount;       /// # of milestones (vertices)
+    long taskCount;           /// # of tasks (edges)
+    int sourceNode;           /// source node
+    long memLimit;            /// edge buffer budget in bytes
+
+    std::string bySource;     /// edges sorted by source, in file order
+    std::string byDest;       /// edges sorted by destination
+    std::vector<long> outStart;   /// first record of each source (+ end)
+    std::vector<long> inStart;    /// first record of each destination
+
+    std::vector<int> indeg;       /// in-degrees
+    std::vector<int> topoNodes;   /// topologically sorted milestones
+    std::vector<int> dist;        /// distances
+    std::vector<int> crPath;      /// critical path, final node first
+    std::vector<int> slackTimes;  /// slack times
+    int finalNode;                /// final milestone
+    int duration;                 /// project duration
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Initializes class member variables.
+    ganttExternal();
+
+    /// -----------------------------------------------------------------------
+    /// @brief (Destructor) Removes the temporary edge files.
+    ~ganttExternal();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Reads a task file in the ganttUtils format and writes its
+    /// edges, sorted by source and by destination, to temporary files.
+    /// Duplicate tasks are merged the same way ganttUtils::addEdge does.
+    ///
+    /// @param fileName Project tasks file
+    /// @param memBytes Edge buffer budget in bytes
+    ///
+    /// @return True if file read was successful, false if not
+    bool readGraph(const std::string fileName, long memBytes);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Runs Kahn's topological sort over the source-sorted edges,
+    /// computing the distances (forward pass) along the way.
+    ///
+    /// @return False if the graph has a cycle, true if not
+    bool topoSort();
+
+    /// -----------------------------------------------------------------------
+    /// @return Task count
+    long getTaskCount() const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Finds the final milestone and duration, then walks back from
+    /// it over the destination-sorted edges to rebuild the critical path.
+    void criticalPath();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Computes slack times in one scan of the source-sorted edges.
+    void findSlackTimes();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Displays title, milestone count, task count and source.
+    ///
+    /// @param out Output stream
+    void printGraphInformation(std::ostream& out = std::cout);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the topological sort for the vertices in the graph.
+    ///
+    /// @param out Output stream
+    void printTopoSort(std::ostream& out = std::cout);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Prints the source node, final task, total duration, and the
+    /// vertices found in the critical path.
+    ///
+    /// @param out Output stream
+    void printCriticalPath(std::ostream& out = std::cout);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Displays slack times.
+    ///
+    /// @param out Output stream
+    void printSlackTimes(std::ostream& out = std::cout);
+
+private:
+    /// -----------------------------------------------------------------------
+    /// @brief Reads records [first, last) of an edge file.
+    ///
+    /// @param file Open edge file
+    /// @param first First record
+    /// @param last One past the last record
+    /// @param records Buffer for the records
+    void readRecords(std::FILE *file, long first, long last,
+                     std::vector<edgeRecord>& records);
+};
+
+#endif /* H_EXTERNALGRAPH */
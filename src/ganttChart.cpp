@@ -0,0 +1,360 @@
+/// @brief Implementation file for class ganttChart
+/// @file ganttChart.cpp
+
+#include "ganttChart.h"
+#include "idInterner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace {
+    const std::size_t MAX_BUCKETS = 1 << 20;   // level 0 buckets, at most
+    const int LABEL_WIDTH = 18;     // text label column
+    const int SVG_LABEL = 140;      // SVG label column, pixels
+    const int SVG_ROW = 14;         // SVG row height, pixels
+    const int SVG_AXIS = 28;        // SVG time axis height, pixels
+    const int TICKS = 10;           // time axis ticks
+
+    bool startsEarlier(const taskBar& a, const taskBar& b) {
+        return a.start < b.start;
+    }
+
+    std::string xmlEscape(const std::string& text) {
+        std::string escaped;
+
+        for(size_t i = 0; i < text.size(); i++) {
+            switch(text[i]) {
+            case '&': escaped += "&amp;"; break;
+            case '<': escaped += "&lt;"; break;
+            case '>': escaped += "&gt;"; break;
+            case '"': escaped += "&quot;"; break;
+            default: escaped += text[i];
+            }
+        }
+
+        return escaped;
+    }
+
+    // "from->to" for a task, or the task count of a summary
+    std::string rowLabel(const taskBar *task, std::size_t count,
+                         const idInterner *names) {
+        std::ostringstream label;
+
+        if(task == nullptr) {
+            label << '[' << count << " tasks]";
+        } else if(names != nullptr) {
+            names->write(label, static_cast<int>(task->from));
+            label << "->";
+            names->write(label, static_cast<int>(task->to));
+        } else {
+            label << task->from << "->" << task->to;
+        }
+
+        return label.str();
+    }
+}
+
+ganttChart::ganttChart() {
+    origin = 0;
+    span = 0;
+    width0 = 1;
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttChart::build(const std::vector<taskBar>& bars) {
+    using namespace std;
+
+    size_t count = 1;
+    double finish = 0;
+
+    tasks = bars;
+    stable_sort(tasks.begin(), tasks.end(), startsEarlier);
+    levels.clear();
+
+    origin = tasks.empty() ? 0 : tasks.front().start;
+    finish = origin;
+
+    for(size_t i = 0; i < tasks.size(); i++) {
+        finish = max(finish, tasks[i].finish);
+    }
+
+    // about four tasks per finest bucket
+    while(count < tasks.size() / 4 && count < MAX_BUCKETS) {
+        count <<= 1;
+    }
+
+    span = max(finish - origin, 1e-9);
+    width0 = span / count;
+
+    chartBucket empty = { 0, 0, 0, 0, numeric_limits<double>::max(),
+                          -numeric_limits<double>::max() };
+
+    levels.push_back(vector<chartBucket>(count, empty));
+
+    for(size_t i = 0; i < tasks.size(); i++) {
+        chartBucket& b = levels[0][bucketOf(tasks[i].start, 0)];
+
+        if(b.count == 0) {
+            b.first = i;
+        }
+
+        b.count++;
+        b.critical += tasks[i].critical ? 1 : 0;
+        b.minStart = min(b.minStart, tasks[i].start);
+        b.maxEnd = max(b.maxEnd, tasks[i].finish);
+    }
+
+    // coarser levels merge pairs of buckets, down to a single bucket
+    while(levels.back().size() > 1) {
+        const vector<chartBucket>& fine = levels.back();
+        vector<chartBucket> coarse(fine.size() / 2, empty);
+
+        for(size_t b = 0; b < coarse.size(); b++) {
+            const chartBucket& left = fine[2 * b];
+            const chartBucket& right = fine[2 * b + 1];
+
+            coarse[b].first = (left.count > 0) ? left.first : right.first;
+            coarse[b].count = left.count + right.count;
+            coarse[b].critical = left.critical + right.critical;
+            coarse[b].minStart = min(left.minStart, right.minStart);
+            coarse[b].maxEnd = max(left.maxEnd, right.maxEnd);
+        }
+
+        levels.push_back(coarse);
+    }
+
+    // reach: the first bucket whose tasks may still be running in bucket b,
+    // so a window need not look further back than reach of its first bucket
+    for(size_t level = 0; level < levels.size(); level++) {
+        vector<chartBucket>& buckets = levels[level];
+        size_t filled = 0;
+        size_t last = 0;
+
+        for(size_t a = 0; a < buckets.size(); a++) {
+            if(a >= filled) {
+                buckets[a].reach = a;
+                filled = a + 1;
+            }
+
+            if(buckets[a].count > 0) {
+                last = bucketOf(buckets[a].maxEnd, level);
+
+                for(; filled <= last; filled++) {
+                    buckets[filled].reach = a;
+                }
+            }
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+double ganttChart::getFinish() const {
+    return origin + span;
+}
+
+/// ----------------------------------------------------------------------------
+
+std::size_t ganttChart::bucketOf(double t, std::size_t level) const {
+    double index = std::floor((t - origin) / width0);
+    double last = static_cast<double>(levels[0].size() - 1);
+
+    index = std::max(0.0, std::min(index, last));
+
+    return static_cast<std::size_t>(index) >> level;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool ganttChart::findRows(const chartView& view,
+                          std::vector<chartRow>& rows) const {
+    using namespace std;
+
+    size_t level = 0;
+    size_t first = 0;
+    size_t last = 0;
+    size_t visible = 0;
+    chartRow row;
+
+    rows.clear();
+
+    if(tasks.empty() || view.rows <= 0 || view.to < view.from) {
+        return false;
+    }
+
+    // finest level whose candidate buckets fit in the rows
+    for(level = 0; level < levels.size(); level++) {
+        first = levels[level][bucketOf(view.from, level)].reach;
+        last = bucketOf(view.to, level);
+
+        if(last - first < static_cast<size_t>(view.rows)) {
+            break;
+        }
+    }
+
+    const vector<chartBucket>& buckets = levels[level];
+
+    for(size_t b = first; b <= last; b++) {
+        if(buckets[b].count > 0 && buckets[b].maxEnd >= view.from) {
+            visible += buckets[b].count;
+        }
+    }
+
+    // every task gets a bar
+    if(visible <= static_cast<size_t>(view.rows)) {
+        for(size_t b = first; b <= last; b++) {
+            if(buckets[b].count == 0 || buckets[b].maxEnd < view.from) {
+                continue;
+            }
+
+            for(size_t i = buckets[b].first;
+                i < buckets[b].first + buckets[b].count; i++) {
+                if(tasks[i].finish >= view.from && tasks[i].start <= view.to) {
+                    row.start = max(tasks[i].start, view.from);
+                    row.finish = min(tasks[i].finish, view.to);
+                    row.task = &tasks[i];
+                    row.count = 1;
+                    row.critical = tasks[i].critical ? 1 : 0;
+                    rows.push_back(row);
+                }
+            }
+        }
+
+        return false;
+    }
+
+    // one summary bar per bucket
+    for(size_t b = first; b <= last; b++) {
+        if(buckets[b].count > 0 && buckets[b].maxEnd >= view.from
+           && buckets[b].minStart <= view.to) {
+            row.start = max(buckets[b].minStart, view.from);
+            row.finish = min(buckets[b].maxEnd, view.to);
+            row.task = nullptr;
+            row.count = buckets[b].count;
+            row.critical = buckets[b].critical;
+            rows.push_back(row);
+        }
+    }
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttChart::renderSVG(std::ostream& out, const chartView& view,
+                           const std::string& title,
+                           const idInterner *names) const {
+    using namespace std;
+
+    vector<chartRow> rows;
+    bool summary = findRows(view, rows);
+    double window = max(view.to - view.from, 1e-9);
+    double scale = view.width / window;
+    int height = SVG_AXIS + static_cast<int>(rows.size()) * SVG_ROW + 4;
+    double x = 0;
+    double w = 0;
+    int y = 0;
+
+    out << fixed << setprecision(2)
+        << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\""
+        << SVG_LABEL + view.width + 10 << "\" height=\"" << height
+        << "\" font-family=\"monospace\" font-size=\"10\">\n"
+        << "<title>" << xmlEscape(title) << "</title>\n";
+
+    // time axis
+    for(int i = 0; i <= TICKS; i++) {
+        x = SVG_LABEL + static_cast<double>(view.width) * i / TICKS;
+
+        out << "<line x1=\"" << x << "\" y1=\"" << SVG_AXIS - 6
+            << "\" x2=\"" << x << "\" y2=\"" << height
+            << "\" stroke=\"#ddd\"/>\n"
+            << "<text x=\"" << x << "\" y=\"" << SVG_AXIS - 10
+            << "\" text-anchor=\"middle\">"
+            << defaultfloat << setprecision(6)
+            << view.from + window * i / TICKS
+            << fixed << setprecision(2) << "</text>\n";
+    }
+
+    // one bar per row, sub-pixel bars widened to a pixel
+    for(size_t r = 0; r < rows.size(); r++) {
+        const chartRow& row = rows[r];
+        string label = rowLabel(row.task, row.count, names);
+        const char *fill = (row.critical == 0) ? "#4682b4"
+                           : (row.critical == row.count) ? "#c0392b"
+                           : "#d98880";
+
+        if(summary) {
+            fill = (row.critical > 0) ? "#b08080" : "#999999";
+        }
+
+        x = SVG_LABEL + (row.start - view.from) * scale;
+        w = max((row.finish - row.start) * scale, 1.0);
+        y = SVG_AXIS + static_cast<int>(r) * SVG_ROW;
+
+        out << "<text x=\"2\" y=\"" << y + SVG_ROW - 4 << "\">"
+            << xmlEscape(label.substr(0, 22)) << "</text>\n"
+            << "<rect x=\"" << x << "\" y=\"" << y + 1 << "\" width=\"" << w
+            << "\" height=\"" << SVG_ROW - 2 << "\" fill=\"" << fill
+            << "\"><title>" << xmlEscape(label) << defaultfloat
+            << setprecision(12) << ": " << row.start << " - " << row.finish;
+
+        if(summary) {
+            out << ", " << row.critical << " critical";
+        }
+
+        out << fixed << setprecision(2) << "</title></rect>\n";
+    }
+
+    out << "</svg>\n" << defaultfloat << setprecision(6);
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttChart::renderText(std::ostream& out, const chartView& view,
+                            const std::string& title,
+                            const idInterner *names) const {
+    using namespace std;
+
+    vector<chartRow> rows;
+    bool summary = findRows(view, rows);
+    double window = max(view.to - view.from, 1e-9);
+    double scale = view.width / window;
+    int first = 0;
+    int last = 0;
+    char mark = '=';
+
+    out << "------------------------------------------------------------\n"
+        << "Gantt Chart:\n   Title: " << title << endl
+        << defaultfloat << setprecision(12)
+        << "   Window: " << view.from << " - " << view.to << endl
+        << "   Bars: " << rows.size()
+        << (summary ? " (summaries of tasks by start time)" : "") << "\n\n";
+
+    for(size_t r = 0; r < rows.size(); r++) {
+        const chartRow& row = rows[r];
+        string line(view.width, ' ');
+
+        // sub-column bars still take one column
+        first = static_cast<int>((row.start - view.from) * scale);
+        last = static_cast<int>(ceil((row.finish - view.from) * scale));
+        first = min(max(first, 0), view.width - 1);
+        last = min(max(last, first + 1), view.width);
+        mark = summary ? '~' : (row.critical > 0 ? '#' : '=');
+
+        for(int c = first; c < last; c++) {
+            line[c] = mark;
+        }
+
+        out << setw(LABEL_WIDTH) << left
+            << rowLabel(row.task, row.count, names).substr(0, LABEL_WIDTH)
+            << right << '|' << line << "|\n";
+    }
+
+    out << "\n" << setprecision(6);
+}
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,125 @@
+/// @brief Header file for class ganttChart
+/// @file ganttChart.h
+
+#ifndef H_GANTTCHART
+#define H_GANTTCHART
+
+#include "ganttUtils.h"
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class idInterner;
+
+/// ----------------------------------------------------------------------------
+/// @brief Portion of the chart to draw: a time window, its width in columns
+/// (text) or pixels (SVG), and the most rows to emit.
+/// ----------------------------------------------------------------------------
+struct chartView {
+    double from;      /// first time shown
+    double to;        /// last time shown
+    int width;        /// columns or pixels across the window
+    int rows;         /// maximum # of bars
+
+    chartView() : from(0), to(0), width(0), rows(0) {}
+};
+
+/// ----------------------------------------------------------------------------
+/// @brief Tasks starting in one time bucket, at one level of detail.
+/// ----------------------------------------------------------------------------
+struct chartBucket {
+    std::size_t first;        /// first task, in start order
+    std::size_t count;        /// # of tasks
+    std::size_t critical;     /// # of critical tasks
+    std::size_t reach;        /// lowest bucket with a task still running here
+    double minStart;          /// earliest start
+    double maxEnd;            /// latest finish
+};
+
+/// ----------------------------------------------------------------------------
+/// @class ganttChart
+///
+/// @brief Draws the tasks of an analysed project (early start and finish
+/// times) as an SVG or text Gantt chart, one row per task in start order.
+/// Tasks are indexed by start time into power-of-two buckets, with coarser
+/// levels built by merging pairs of buckets.  A view uses the finest level
+/// whose candidate buckets fit in the requested rows: if their tasks fit
+/// too, each visible task gets its own bar, otherwise each bucket becomes
+/// one summary bar (task count, critical tasks).  Work per view is bounded
+/// by the rows drawn, not by the task count.
+/// ----------------------------------------------------------------------------
+class ganttChart {
+private:
+    std::vector<taskBar> tasks;                   /// tasks in start order
+    std::vector<std::vector<chartBucket> > levels;    /// levels[0] finest
+    double origin;            /// start of bucket 0
+    double span;              /// length of the indexed time range
+    double width0;            /// length of a level 0 bucket
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Initializes an empty chart.
+    ganttChart();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Sorts the tasks by start time and builds the bucket levels.
+    ///
+    /// @param bars Tasks, as filled in by ganttUtils::getTaskBars()
+    void build(const std::vector<taskBar>& bars);
+
+    /// -----------------------------------------------------------------------
+    /// @return Time of the latest finish
+    double getFinish() const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Writes the view as an SVG document.
+    ///
+    /// @param out Output stream
+    /// @param view Window and size
+    /// @param title Chart title
+    /// @param names Milestone names, nullptr to show indices
+    void renderSVG(std::ostream& out, const chartView& view,
+                   const std::string& title, const idInterner *names) const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Writes the view as text, one line per bar ('=' task, '#'
+    /// critical task, '~' summary of several tasks).
+    ///
+    /// @param out Output stream
+    /// @param view Window and size
+    /// @param title Chart title
+    /// @param names Milestone names, nullptr to show indices
+    void renderText(std::ostream& out, const chartView& view,
+                    const std::string& title, const idInterner *names) const;
+
+private:
+    /// -----------------------------------------------------------------------
+    /// @brief One bar of a view, either a task or a bucket summary.
+    struct chartRow {
+        double start;             /// bar start, clipped to the window
+        double finish;            /// bar finish, clipped to the window
+        const taskBar *task;      /// task, nullptr for a summary
+        std::size_t count;        /// # of tasks summarised
+        std::size_t critical;     /// # of critical tasks summarised
+    };
+
+    /// -----------------------------------------------------------------------
+    /// @brief Selects the bars of a view.
+    ///
+    /// @param view Window and size
+    /// @param rows Bars to draw
+    ///
+    /// @return True if the bars are summaries, false if single tasks
+    bool findRows(const chartView& view, std::vector<chartRow>& rows) const;
+
+    /// -----------------------------------------------------------------------
+    /// @param t Time
+    /// @param level Level of detail
+    ///
+    /// @return Bucket containing t at that level, clamped to the index
+    std::size_t bucketOf(double t, std::size_t level) const;
+};
+
+#endif /* H_GANTTCHART */
@@ -5,18 +5,207 @@
 
 #include "ganttUtils.h"
 #include "linkedQueue.h"
+#include "idInterner.h"
+#include "radixSort.h"
+#include "calendar.h"
+#include "maxFlow.h"
+#include "concurrentQueue.h"
+#include "taskStream.h"
+#include "topSelect.h"
+#include "resourceProfile.h"
+#include "indexedHeap.h"
 
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
-#include <iomanip>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+    const std::size_t NO_TASK = static_cast<std::size_t>(-1);  // no task
+    
+    // "--top" metric names, by topMetric
+    const char *const TOP_NAMES[] = { "slack", "fan-in", "fan-out", "start",
+                                      "task" };
+    
+    // milestone as displayed: its original identifier if the graph was read
+    // with readNamedGraph(), else its index
+    struct milestoneRef {
+        const idInterner *names;
+        unsigned long long v;
+        int width;
+    };
+    
+    milestoneRef ms(const idInterner *names, unsigned long long v, 
+                    int width = 0) {
+        milestoneRef ref = { names, v, width };
+        return ref;
+    }
+    
+    std::ostream& operator<<(std::ostream& out, const milestoneRef& ref) {
+        if(ref.names != nullptr) {
+            ref.names->write(out, static_cast<int>(ref.v), ref.width);
+        } else {
+            out << std::setw(ref.width) << ref.v;
+        }
+        
+        return out;
+    }
+    
+    // weights are read as long long (or double) so that values too wide
+    // for the chosen weight type are still parsed and detected
+    template <class wgtType>
+    struct weightTraits {
+        typedef long long raw;
+    };
+    
+    template <>
+    struct weightTraits<double> {
+        typedef double raw;
+    };
+    
+    long long parseWeight(const char *token, char **end, long long) {
+        return strtoll(token, end, 10);
+    }
+    
+    double parseWeight(const char *token, char **end, double) {
+        return strtod(token, end);
+    }
+    
+    // true if a path length could exceed the range of an integral wgtType
+    template <class wgtType>
+    bool overflowsWeight(double total) {
+        return std::numeric_limits<wgtType>::is_integer 
+               && total > static_cast<double>(std::numeric_limits<wgtType>::max());
+    }
+    
+    // order-preserving unsigned keys for the radix sort, and back
+    uint64_t sortKey(long long value) {
+        return static_cast<uint64_t>(value) ^ (1ULL << 63);
+    }
+    
+    uint64_t sortKey(double value) {
+        uint64_t bits = 0;
+        
+        memcpy(&bits, &value, sizeof(bits));
+        
+        return (bits >> 63) ? ~bits : bits | (1ULL << 63);
+    }
+    
+    template <class wgtType>
+    wgtType fromKey(uint64_t key, long long) {
+        return static_cast<wgtType>(static_cast<long long>(key ^ (1ULL << 63)));
+    }
+    
+    template <class wgtType>
+    wgtType fromKey(uint64_t key, double) {
+        double value = 0;
+        
+        key = (key >> 63) ? key & ~(1ULL << 63) : ~key;
+        memcpy(&value, &key, sizeof(value));
+        
+        return value;
+    }
+    
+    // compressed tasks: LEB128 varints, zigzag for signed values
+    void putVarint(std::vector<unsigned char>& bytes, uint64_t value) {
+        while(value >= 0x80) {
+            bytes.push_back(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        
+        bytes.push_back(static_cast<unsigned char>(value));
+    }
+    
+    uint64_t getVarint(const unsigned char *&pos) {
+        uint64_t value = *pos & 0x7F;
+        int shift = 7;
+        
+        while(*pos++ & 0x80) {
+            value |= static_cast<uint64_t>(*pos & 0x7F) << shift;
+            shift += 7;
+        }
+        
+        return value;
+    }
+    
+    uint64_t zigzag(long long value) {
+        return (static_cast<uint64_t>(value) << 1) ^ (value < 0 ? ~0ULL : 0);
+    }
+    
+    long long unzigzag(uint64_t value) {
+        return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+    }
+    
+    void putWeight(std::vector<unsigned char>& bytes, long long weight) {
+        putVarint(bytes, zigzag(weight));
+    }
+    
+    void putWeight(std::vector<unsigned char>& bytes, double weight) {
+        unsigned char raw[sizeof(double)];
+        
+        memcpy(raw, &weight, sizeof(raw));
+        bytes.insert(bytes.end(), raw, raw + sizeof(raw));
+    }
+    
+    long long getWeight(const unsigned char *&pos, long long) {
+        return unzigzag(getVarint(pos));
+    }
+    
+    double getWeight(const unsigned char *&pos, double) {
+        double weight = 0;
+        
+        memcpy(&weight, pos, sizeof(weight));
+        pos += sizeof(weight);
+        
+        return weight;
+    }
+    
+    // skips the optional "weights: <type>" header line (see readLayout()) of
+    // a file of numbered milestones, where no task line starts with a letter
+    void skipLayoutLine(std::istream& inFile) {
+        std::string ignore;
+        
+        inFile >> std::ws;
+        
+        if(std::isalpha(inFile.peek())) {
+            std::getline(inFile, ignore);
+        }
+    }
+}
 
-ganttUtils::ganttUtils() {
+template <class idxType, class wgtType>
+ganttUtils<idxType, wgtType>::ganttUtils() {
     adjList = nullptr;
+    edgeBytes = nullptr;
+    edgeOffset = nullptr;
+    listBytes = 0;
+    label = nullptr;
+    rank = nullptr;
+    chainEnd = nullptr;
+    chainLength = nullptr;
+    chainCount = 0;
+    foldedCount = 0;
+    names = nullptr;
     milestoneCount = 0;
     taskCount = 0;
+    removedTasks = 0;
+    reduced = false;
     sourceNode = 0;
+    weightOverflow = false;
     
     tasksMSRatio = 0;
     tasksDensity = 0;
@@ -49,31 +238,63 @@ ganttUtils::ganttUtils() {
     lowODCount = 0;
 
     slackTimes = nullptr;
+    
+    tailDist = nullptr;
+    nearLimit = 0;
+    
+    peakTasks = 0;
+    peakStart = 0;
+    taskTime = 0;
+    
+    calendars = nullptr;
+    startDay = 0;
+    finishDay = 0;
+    
+    crashGoal = 0;
+    
+    rcRule = PRIORITY_SLACK;
+    rcDuration = 0;
+    rcDelayed = 0;
+    
+    resultMap = nullptr;
+    resultBytes = 0;
 }
 
 /// ----------------------------------------------------------------------------
 
-ganttUtils::~ganttUtils() {
+template <class idxType, class wgtType>
+ganttUtils<idxType, wgtType>::~ganttUtils() {
+    // arrays mapped by readResults() are not the heap's
+    if(resultMap != nullptr) {
+        munmap(resultMap, resultBytes);
+        resultMap = nullptr;
+        indeg = nullptr;
+        outdeg = nullptr;
+        independentMS = nullptr;
+        aps = nullptr;
+        topoNodes = nullptr;
+        crPath = nullptr;
+        slackTimes = nullptr;
+    }
+    
+    if(edgeBytes != nullptr) {
+        delete [] edgeBytes;
+        delete [] edgeOffset;
+        edgeBytes = nullptr;
+        edgeOffset = nullptr;
+    }
+    
+    // the list nodes all go back at once with their arena
     if(adjList != nullptr) {
-        listNode *curr = nullptr;
-        listNode *temp = nullptr;
-
-        for(int i = 0; i < milestoneCount; i++) {
-            curr = adjList[i].head;
-            
-            while(curr != nullptr) {
-                temp = curr;
-                curr = curr->link;
-                delete temp;
-            }
-            
-            adjList[i].head = nullptr;
-        }
+        listNodes.clear();
         
         delete [] adjList;
         adjList = nullptr;
-        curr = nullptr;
-        temp = nullptr;
+    }
+    
+    if(names != nullptr) {
+        delete names;
+        names = nullptr;
     }
     
     if(indeg != nullptr) {
@@ -115,738 +336,5082 @@ ganttUtils::~ganttUtils() {
         delete [] slackTimes;
         slackTimes = nullptr;
     }
-}
-
-/// ----------------------------------------------------------------------------
-
-bool ganttUtils::getArguments(int argc, char *argv[], 
-                              std::string& fileName, bool& printFlag) {
-                                  
-    using namespace std;
     
-    if(argc == 1) {
-        cout << "Usage: ./projectInfo -f <filename> [-p]\n";
-        return false;
-    }
-
-    if(argc != 3 && argc != 4) {
-        cout << "Error, invalid command line options.\n";
-        return false;
+    if(tailDist != nullptr) {
+        delete [] tailDist;
+        tailDist = nullptr;
     }
     
-    string current;         // current argument
-    bool fnFlag = false;    // flag for filename specifier
-    printFlag = false;
-    
-    for(int i = 0; i < argc; i++) {
-        current = string(argv[i]);
-        
-        // filename specifier
-        if(current == "-f") {
-            fnFlag = true;
-            
-            // filename argument
-            if(i < argc - 1) {
-                fileName = string(argv[i + 1]);
-            }
-            
-            // check if file exists
-            ifstream inFile;
-            inFile.open(fileName);
-            
-            if(inFile) {
-                inFile.close();
-            } else {
-                cout << "Error, can not find project file.\n";
-                return false;
-            }
-        }
-        
-        // print flag
-        if(current == "-p") {
-            printFlag = true;
-        }
-
-    }
-        
-    if(!fnFlag) {
-        cout << "Error, invalid project file name specifier.\n";
-        return false;
+    if(label != nullptr) {
+        delete [] label;
+        delete [] rank;
+        label = nullptr;
+        rank = nullptr;
     }
     
-    if(argc == 4 && !printFlag) {
-        cout << "Error, invalid print specifier.\n";
-        return false;
+    if(chainEnd != nullptr) {
+        delete [] chainEnd;
+        delete [] chainLength;
+        chainEnd = nullptr;
+        chainLength = nullptr;
     }
-
-    return true;
 }
 
 /// ----------------------------------------------------------------------------
 
-bool ganttUtils::readGraph(const std::string fileName) {
-    using namespace std;
-    
-    bool valid = false;
-    string ignore;
-    int from = 0;          // source vertex
-    int to = 0;            // destination vertex
-    int edge = 0;          // edge weight
-    
-    ifstream inFile;
-    inFile.open(fileName);
-    
-    if(inFile) {
-        getline(inFile, title, '\n');
-        
-        //? where is the extra "title:" coming from
-        if(title.substr(0, 6) == "title:") {
-            title.erase(0, 6);
-        }
-        
-        inFile >> ignore >> milestoneCount;
-        inFile >> ignore >> sourceNode;
-        
-        if(milestoneCount > 0) {
-            // create list
-            adjList = new headNode[milestoneCount];
-            
-            for(int i = 0; i < milestoneCount; i++) {
-                adjList[i].head = nullptr;
-            }
-            
-            // add edges
-            while(inFile >> from >> to >> edge) { 
-                addEdge(from, to, edge);
-            }
-            
-            valid = true;
-        }
-        
-        inFile.close();
-    }
-    
-    return valid;
-}
+template <class idxType, class wgtType>
+ganttUtils<idxType, wgtType>::edgeCursor::edgeCursor() 
+    : node(nullptr), pos(nullptr), end(nullptr), to(0), w(0), packed(false),
+      more(false), chainEnd(nullptr), chainLength(nullptr) {}
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::addEdge(int from, int to, int edge) {
-    if(from < milestoneCount && to < milestoneCount 
-       && from >= 0 && to >= 0 && from != to) {
-           
-        listNode *temp = new listNode;
-        temp->dest = to;
-        temp->weight = edge;
-        temp->link = nullptr;
-        
-        // first connection
-        if(adjList[from].head == nullptr) {
-            adjList[from].head = temp;
-            taskCount++;
-        } else {
-            listNode *curr = adjList[from].head;
-            
-            // existing connection
-            if(curr->dest == to) {
-                curr->weight = edge;
-                delete temp;
-                temp = nullptr;
-                
-            // new connection
-            } else {
-                temp->link = adjList[from].head;
-                adjList[from].head = temp;
-                taskCount++;
-            }
-        }
-    }
-}
+template <class idxType, class wgtType>
+ganttUtils<idxType, wgtType>::edgeCursor::edgeCursor(const edgeNode *head) 
+    : node(head), pos(nullptr), end(nullptr), to(0), w(0), packed(false),
+      more(false), chainEnd(nullptr), chainLength(nullptr) {}
 
 /// ----------------------------------------------------------------------------
 
-bool ganttUtils::isValidProject() {
-    bool *visited = new bool[milestoneCount]{};
-    bool *marked = new bool[milestoneCount]{};
-    
-    for(int i = 0; i < milestoneCount; i++) {
-        visited[i] = false;
-        marked[i] = false;
-    }
-
-    // check each node for an edge to itself or to one of its ancestors
-    for(int v = 0; v < milestoneCount; v++) {
-        if(!visited[v]) {
-            if(isCycle(v, visited, marked)) {
-                
-                delete [] visited;
-                visited = nullptr;
-                
-                delete [] marked;
-                marked = nullptr;
-                
-                return false;
-            }
-        } 
-    }
-    
-    delete [] visited;
-    visited = nullptr;
-    
-    delete [] marked;
-    marked = nullptr;
-
-    return true;
+template <class idxType, class wgtType>
+ganttUtils<idxType, wgtType>::edgeCursor::edgeCursor(const unsigned char *first,
+                                                     const unsigned char *last,
+                                                     idxType from) 
+    : node(nullptr), pos(first), end(last), to(from), w(0), packed(true),
+      more(false), chainEnd(nullptr), chainLength(nullptr) {
+    next();
 }
 
 /// ----------------------------------------------------------------------------
 
-bool ganttUtils::isCycle(int v, bool *visited, bool *marked) {
-    if(!visited[v]) {
-        visited[v] = true;
-        marked[v] = true;
-        
-        listNode *curr = adjList[v].head;
-        int u = 0;
-        
-        while(curr != nullptr) {            
-            u = curr->dest;
-            
-            if(isCycle(u, visited, marked)) {
-                return true;
-            } else if(marked[u]) {
-                return true;
-            }
-            
-            curr = curr->link;
-        }
-        
-        marked[v] = false;
-        return false;
-    }
-
-    return false;
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::edgeCursor::valid() const {
+    return packed ? more : node != nullptr;
 }
 
 /// ----------------------------------------------------------------------------
 
-int ganttUtils::getTaskCount() const {
-    return taskCount;
+template <class idxType, class wgtType>
+idxType ganttUtils<idxType, wgtType>::edgeCursor::dest() const {
+    idxType head = packed ? to : node->dest;
+    
+    return (chainEnd != nullptr && chainEnd[head] != NONE) 
+           ? chainEnd[head] : head;
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::findGraphInformation() {
-    double t = static_cast<double>(taskCount);
-    double m = static_cast<double>(milestoneCount);
+template <class idxType, class wgtType>
+wgtType ganttUtils<idxType, wgtType>::edgeCursor::weight() const {
+    idxType head = packed ? to : node->dest;
+    wgtType first = packed ? w : node->weight;
     
-    tasksMSRatio = t / m;
-    tasksDensity = (2 * t) / (m * (m - 1));
+    return (chainEnd != nullptr && chainEnd[head] != NONE) 
+           ? first + chainLength[head] : first;
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::findKeyMilestone() {
-    // find in-degrees and keep track of key milestone
-    // keyMS: latest milestone with the maximum in-degree
+template <class idxType, class wgtType>
+idxType ganttUtils<idxType, wgtType>::edgeCursor::via() const {
+    idxType head = packed ? to : node->dest;
     
-    indeg = new int[milestoneCount]{};
-    listNode *curr = nullptr;
-    
-    for(int i = 0; i < milestoneCount; i++) {
-        indeg[i] = 0;
-    }
-    
-    for(int v = 0; v < milestoneCount; v++) {
-        curr = adjList[v].head;
-        
-        while(curr != nullptr) {
-            indeg[curr->dest]++;
-            curr = curr->link;
-        }
-        
-        if(indeg[v] >= indeg[keyMS]) {
-            keyMS = v;
-        }
-    }    
+    return (chainEnd != nullptr && chainEnd[head] != NONE) ? head : NONE;
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::findNodePoint() {
-    // find out-degrees and keep track of node point
-    // nodePoint: first milestone with the maximum out-degree
-
-    outdeg = new int[milestoneCount]{};
-    listNode *curr = nullptr;
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::edgeCursor::next() {
+    typedef typename weightTraits<wgtType>::raw raw;
     
-    for(int i = 0; i < milestoneCount; i++) {
-        outdeg[i] = 0;
+    if(!packed) {
+        node = node->link;
+        return;
     }
     
-    for(int v = 0; v < milestoneCount; v++) {
-        curr = adjList[v].head;
-        
-        while(curr != nullptr) {
-            outdeg[v]++;
-            curr = curr->link;
-        }
-        
-        if(outdeg[v] > outdeg[nodePoint]) {
-            nodePoint = v;
-        }
+    more = pos < end;
+    
+    if(more) {
+        to = static_cast<idxType>(static_cast<long long>(to) 
+                                  + unzigzag(getVarint(pos)));
+        w = static_cast<wgtType>(getWeight(pos, raw()));
     }
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::findIndependentMilestones() {
-    independentMS = new int[milestoneCount]{};
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::edgeCursor::fold(const idxType *ends,
+                                                    const wgtType *lengths) {
+    chainEnd = ends;
+    chainLength = lengths;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+typename ganttUtils<idxType, wgtType>::edgeCursor 
+ganttUtils<idxType, wgtType>::edges(idxType v, bool contracted) const {
+    edgeCursor curr;
     
-    for(int i = 0; i < milestoneCount; i++) {
+    // a folded milestone's task is part of the chain's task
+    if(contracted && chainEnd != nullptr && chainEnd[v] != NONE) {
+        return curr;
+    }
+    
+    if(edgeBytes != nullptr) {
+        curr = edgeCursor(edgeBytes + edgeOffset[v], 
+                          edgeBytes + edgeOffset[v + 1], v);
+    } else {
+        curr = edgeCursor(adjList[v].head);
+    }
+    
+    if(contracted) {
+        curr.fold(chainEnd, chainLength);
+    }
+    
+    return curr;
+}
+
+/// ----------------------------------------------------------------------------
+
+namespace {
+    // options that pick a mode or that only some modes take, one bit each
+    enum optionBit {
+        OPT_FILE = 1UL << 0,            // -f
+        OPT_BATCH = 1UL << 1,           // -b
+        OPT_OUTPUT = 1UL << 2,          // -o
+        OPT_THREADS = 1UL << 3,         // -j
+        OPT_MEM_LIMIT = 1UL << 4,       // --mem-limit
+        OPT_CACHE = 1UL << 5,           // --cache
+        OPT_PARTITIONS = 1UL << 6,      // --partitions
+        OPT_DIFF = 1UL << 7,            // --diff
+        OPT_PRINT = 1UL << 8,           // -p
+        OPT_NEAR_CRITICAL = 1UL << 9,   // --near-critical
+        OPT_STRING_IDS = 1UL << 10,     // --string-ids
+        OPT_RELABEL = 1UL << 11,        // --relabel
+        OPT_CHART = 1UL << 12,          // --chart
+        OPT_CONCURRENCY = 1UL << 13,    // --concurrency
+        OPT_COMPRESS = 1UL << 14,       // --compress
+        OPT_REDUCE = 1UL << 15,         // --reduce
+        OPT_CONTRACT = 1UL << 16,       // --contract
+        OPT_SNAPSHOT = 1UL << 17,       // --snapshot
+        OPT_DOMINATORS = 1UL << 18,     // --dominators
+        OPT_CALENDAR = 1UL << 19,       // --calendar
+        OPT_CRASH = 1UL << 20,          // --crash
+        OPT_EDITS = 1UL << 21,          // --edits
+        OPT_TOP = 1UL << 22,            // --top
+        OPT_DELIVERABLES = 1UL << 23,   // --deliverables
+        OPT_RESOURCES = 1UL << 24       // --resources
+    };
+    
+    // a mode of projectInfo and the options it takes besides its own
+    struct modeOptions {
+        unsigned long selects;          // option picking the mode, 0 if none
+        unsigned long allowed;          // other options the mode takes
+    };
+    
+    // the first mode whose option is given applies, the single project
+    // analysis if none is
+    const modeOptions MODES[] = {
+        // portfolio of task files
+        { OPT_BATCH, OPT_OUTPUT | OPT_THREADS | OPT_MEM_LIMIT | OPT_RELABEL 
+                     | OPT_COMPRESS | OPT_REDUCE | OPT_CONTRACT },
+        // cached results cover only the plain (or reduced) analysis
+        { OPT_CACHE, OPT_FILE | OPT_THREADS | OPT_REDUCE },
+        // out-of-core analysis
+        { OPT_MEM_LIMIT, OPT_FILE | OPT_THREADS },
+        // plain analysis in worker processes
+        { OPT_PARTITIONS, OPT_FILE },
+        // plain analysis of two numbered task files
+        { OPT_DIFF, OPT_FILE | OPT_THREADS },
+        // single project and its reports
+        { 0, OPT_FILE | OPT_THREADS | OPT_PRINT | OPT_NEAR_CRITICAL 
+             | OPT_STRING_IDS | OPT_RELABEL | OPT_CHART | OPT_CONCURRENCY 
+             | OPT_COMPRESS | OPT_REDUCE | OPT_CONTRACT | OPT_SNAPSHOT 
+             | OPT_DOMINATORS | OPT_CALENDAR | OPT_CRASH | OPT_EDITS 
+             | OPT_TOP | OPT_DELIVERABLES | OPT_RESOURCES }
+    };
+    
+    // bits of the options given
+    unsigned long optionsGiven(const ganttOptions& options, bool fnFlag) {
+        unsigned long bits = 0;
+        
+        bits |= fnFlag ? OPT_FILE : 0;
+        bits |= !options.batchPath.empty() ? OPT_BATCH : 0;
+        bits |= !options.outputDir.empty() ? OPT_OUTPUT : 0;
+        bits |= (options.threadCount != 0) ? OPT_THREADS : 0;
+        bits |= (options.memLimit != 0) ? OPT_MEM_LIMIT : 0;
+        bits |= !options.cacheDir.empty() ? OPT_CACHE : 0;
+        bits |= (options.partitions != 0) ? OPT_PARTITIONS : 0;
+        bits |= !options.diffFile.empty() ? OPT_DIFF : 0;
+        bits |= options.printFlag ? OPT_PRINT : 0;
+        bits |= (options.nearCritical >= 0) ? OPT_NEAR_CRITICAL : 0;
+        bits |= options.stringIDs ? OPT_STRING_IDS : 0;
+        bits |= options.relabel ? OPT_RELABEL : 0;
+        bits |= !options.chartFile.empty() ? OPT_CHART : 0;
+        bits |= options.concurrency ? OPT_CONCURRENCY : 0;
+        bits |= options.compress ? OPT_COMPRESS : 0;
+        bits |= options.reduce ? OPT_REDUCE : 0;
+        bits |= options.contract ? OPT_CONTRACT : 0;
+        bits |= !options.snapshotFile.empty() ? OPT_SNAPSHOT : 0;
+        bits |= options.dominators ? OPT_DOMINATORS : 0;
+        bits |= !options.calendarFile.empty() ? OPT_CALENDAR : 0;
+        bits |= !options.crashFile.empty() ? OPT_CRASH : 0;
+        bits |= !options.editsFile.empty() ? OPT_EDITS : 0;
+        bits |= !options.topQueries.empty() ? OPT_TOP : 0;
+        bits |= options.deliverables ? OPT_DELIVERABLES : 0;
+        bits |= !options.resourceFile.empty() ? OPT_RESOURCES : 0;
+        
+        return bits;
+    }
+}
+
+bool getArguments(int argc, char *argv[], ganttOptions& options) {
+                                  
+    using namespace std;
+    
+    if(argc == 1) {
+        cout << "Usage: ./projectInfo -f <filename> [-p]"
+             << " [--near-critical <margin>[%]] [--max-paths <k>]"
+             << " [--string-ids] [--relabel]\n"
+             << "           [--chart <file.svg|file|->]"
+             << " [--chart-window <from>:<to>] [--chart-width <n>]"
+             << " [--chart-rows <n>]\n"
+             << "           [--concurrency] [--reduce] [-j <threads>]"
+             << " [--compress] [--snapshot <file>] [--contract]\n"
+             << "           [--dominators] [--calendar <file> --start <date>"
+             << " [--schedule <file.csv>]]\n"
+             << "           [--crash <file> [--crash-by <units>]]"
+             << " [--edits <file>] [--deliverables]\n"
+             << "           [--resources <file> [--priority <slack|path>]"
+             << " [--resource-csv <file>]]\n"
+             << "           [--top <metric>:<k>]... [--top-csv <file>]"
+             << " (metrics: slack, fan-in, fan-out, start, task)\n"
+             << "       ./projectInfo -f <filename> --cache <dir>"
+             << " [--cache-size <MB>] [--reduce] [-j <threads>]\n"
+             << "       ./projectInfo -f <filename> --mem-limit <MB>\n"
+             << "       ./projectInfo -f <filename> --partitions <n>\n"
+             << "       ./projectInfo -f <filename> --diff <old filename>"
+             << " [-j <threads>]\n"
+             << "       ./projectInfo -b <directory|listfile> [-o <dir>]"
+             << " [-j <threads>] [--mem-limit <MB>] [--relabel]"
+             << " [--compress] [--reduce] [--contract]\n";
+        return false;
+    }
+    
+    string current;         // current argument
+    bool fnFlag = false;    // flag for filename specifier
+    bool cacheSized = false;    // flag for cache size
+    bool prioritySet = false;   // flag for priority rule
+    bool maxPathsSet = false;   // flag for near-critical path count
+    bool chartSet = false;      // flag for chart window, width or rows
+    unsigned long given = 0;    // bits of the options given
+    size_t mode = 0;            // MODES entry that applies
+    options = ganttOptions();
+    
+    for(int i = 1; i < argc; i++) {
+        current = string(argv[i]);
+        
+        // filename specifier
+        if(current == "-f") {
+            fnFlag = true;
+            
+            // filename argument
+            if(i < argc - 1) {
+                options.fileName = string(argv[++i]);
+            }
+            
+            // check if file exists
+            ifstream inFile;
+            inFile.open(options.fileName);
+            
+            if(inFile) {
+                inFile.close();
+            } else {
+                cout << "Error, can not find project file.\n";
+                return false;
+            }
+            
+            if(!canDecompress(detectCompression(options.fileName))) {
+                cout << "Error, zstd task files need a build with ZSTD=1.\n";
+                return false;
+            }
+            
+        // print flag
+        } else if(current == "-p") {
+            options.printFlag = true;
+            
+        // batch (portfolio) specifier
+        } else if(current == "-b" && i < argc - 1) {
+            options.batchPath = string(argv[++i]);
+            
+        // report directory
+        } else if(current == "-o" && i < argc - 1) {
+            options.outputDir = string(argv[++i]);
+            
+        // worker threads
+        } else if(current == "-j" && i < argc - 1) {
+            options.threadCount = atoi(argv[++i]);
+            
+            if(options.threadCount <= 0) {
+                cout << "Error, invalid thread count.\n";
+                return false;
+            }
+            
+        // near-critical margin, absolute or % of duration
+        } else if(current == "--near-critical" && i < argc - 1) {
+            current = string(argv[++i]);
+            options.nearPercent = !current.empty() 
+                                  && current[current.size() - 1] == '%';
+            options.nearCritical = atof(current.c_str());
+            
+            if(options.nearCritical < 0) {
+                cout << "Error, invalid near-critical margin.\n";
+                return false;
+            }
+            
+        // max near-critical paths
+        } else if(current == "--max-paths" && i < argc - 1) {
+            options.maxPaths = atoi(argv[++i]);
+            
+            if(options.maxPaths <= 0) {
+                cout << "Error, invalid path count.\n";
+                return false;
+            }
+            
+            maxPathsSet = true;
+            
+        // named milestones
+        } else if(current == "--string-ids") {
+            options.stringIDs = true;
+            
+        // topological relabelling
+        } else if(current == "--relabel") {
+            options.relabel = true;
+            
+        // Gantt chart
+        } else if(current == "--chart" && i < argc - 1) {
+            options.chartFile = string(argv[++i]);
+            
+        } else if(current == "--chart-window" && i < argc - 1) {
+            current = string(argv[++i]);
+            size_t colon = current.find(':');
+            
+            if(colon == string::npos) {
+                cout << "Error, invalid chart window.\n";
+                return false;
+            }
+            
+            options.chartFrom = atof(current.substr(0, colon).c_str());
+            options.chartTo = atof(current.substr(colon + 1).c_str());
+            
+            if(options.chartFrom < 0 || options.chartTo <= options.chartFrom) {
+                cout << "Error, invalid chart window.\n";
+                return false;
+            }
+            
+            chartSet = true;
+            
+        } else if(current == "--chart-width" && i < argc - 1) {
+            options.chartWidth = atoi(argv[++i]);
+            
+            if(options.chartWidth <= 0) {
+                cout << "Error, invalid chart width.\n";
+                return false;
+            }
+            
+            chartSet = true;
+            
+        // compressed task storage
+        } else if(current == "--compress") {
+            options.compress = true;
+            
+        // task concurrency profile
+        } else if(current == "--concurrency") {
+            options.concurrency = true;
+            
+        // transitive reduction
+        } else if(current == "--reduce") {
+            options.reduce = true;
+            
+        // must-pass milestones
+        } else if(current == "--dominators") {
+            options.dominators = true;
+            
+        // chain contraction
+        } else if(current == "--contract") {
+            options.contract = true;
+            
+        // binary snapshot of the task list
+        } else if(current == "--snapshot" && i < argc - 1) {
+            options.snapshotFile = string(argv[++i]);
+            
+        // working-day calendars
+        } else if(current == "--calendar" && i < argc - 1) {
+            options.calendarFile = string(argv[++i]);
+            
+        } else if(current == "--start" && i < argc - 1) {
+            long day = 0;
+            
+            options.startDate = string(argv[++i]);
+            
+            if(!parseDate(options.startDate, day)) {
+                cout << "Error, invalid start date.\n";
+                return false;
+            }
+            
+        } else if(current == "--schedule" && i < argc - 1) {
+            options.scheduleFile = string(argv[++i]);
+            
+        // time-cost trade-off
+        } else if(current == "--crash" && i < argc - 1) {
+            options.crashFile = string(argv[++i]);
+            
+        } else if(current == "--crash-by" && i < argc - 1) {
+            options.crashBy = atof(argv[++i]);
+            
+            if(options.crashBy <= 0) {
+                cout << "Error, invalid crashing target.\n";
+                return false;
+            }
+            
+        // edit script for versioned copies
+        } else if(current == "--edits" && i < argc - 1) {
+            options.editsFile = string(argv[++i]);
+            
+        // critical path to each deliverable
+        } else if(current == "--deliverables") {
+            options.deliverables = true;
+            
+        // resource-constrained schedule
+        } else if(current == "--resources" && i < argc - 1) {
+            options.resourceFile = string(argv[++i]);
+            
+        } else if(current == "--priority" && i < argc - 1) {
+            current = string(argv[++i]);
+            
+            if(current == "slack") {
+                options.priority = PRIORITY_SLACK;
+            } else if(current == "path") {
+                options.priority = PRIORITY_PATH;
+            } else {
+                cout << "Error, invalid priority rule.\n";
+                return false;
+            }
+            
+            prioritySet = true;
+            
+        } else if(current == "--resource-csv" && i < argc - 1) {
+            options.resourceCsv = string(argv[++i]);
+            
+        // top-k queries, "<metric>:<k>"
+        } else if(current == "--top" && i < argc - 1) {
+            topQuery query = { TOP_SLACK, 0 };
+            int metric = 0;
+            
+            current = string(argv[++i]);
+            size_t colon = current.find(':');
+            string name = current.substr(0, colon);
+            long k = (colon == string::npos) 
+                     ? 0 : atol(current.substr(colon + 1).c_str());
+            
+            while(metric <= TOP_TASK && name != TOP_NAMES[metric]) {
+                metric++;
+            }
+            
+            if(metric > TOP_TASK || k <= 0) {
+                cout << "Error, invalid top-k query.\n";
+                return false;
+            }
+            
+            query.metric = static_cast<topMetric>(metric);
+            query.k = static_cast<size_t>(k);
+            options.topQueries.push_back(query);
+            
+        } else if(current == "--top-csv" && i < argc - 1) {
+            options.topFile = string(argv[++i]);
+            
+        // older version to compare with
+        } else if(current == "--diff" && i < argc - 1) {
+            options.diffFile = string(argv[++i]);
+            
+        // result cache
+        } else if(current == "--cache" && i < argc - 1) {
+            options.cacheDir = string(argv[++i]);
+            
+        } else if(current == "--cache-size" && i < argc - 1) {
+            options.cacheSize = atol(argv[++i]);
+            cacheSized = true;
+            
+            if(options.cacheSize <= 0) {
+                cout << "Error, invalid cache size.\n";
+                return false;
+            }
+            
+        // worker processes of the partitioned analysis
+        } else if(current == "--partitions" && i < argc - 1) {
+            options.partitions = atoi(argv[++i]);
+            
+            if(options.partitions <= 0) {
+                cout << "Error, invalid partition count.\n";
+                return false;
+            }
+            
+        } else if(current == "--chart-rows" && i < argc - 1) {
+            options.chartRows = atoi(argv[++i]);
+            
+            if(options.chartRows <= 0) {
+                cout << "Error, invalid chart row count.\n";
+                return false;
+            }
+            
+            chartSet = true;
+            
+        // memory budget
+        } else if(current == "--mem-limit" && i < argc - 1) {
+            options.memLimit = atol(argv[++i]);
+            
+            if(options.memLimit <= 0) {
+                cout << "Error, invalid memory limit.\n";
+                return false;
+            }
+            
+        } else {
+            cout << "Error, invalid command line options.\n";
+            return false;
+        }
+    }
+    
+    // a calendar schedule needs a start date, a crashing target crash costs
+    // and a near-critical path count a margin; the chart layout options
+    // need a chart
+    if((options.compress && options.relabel)
+       || options.calendarFile.empty() != options.startDate.empty()
+       || (options.calendarFile.empty() && !options.scheduleFile.empty())
+       || (options.crashFile.empty() && options.crashBy > 0)
+       || (options.nearCritical < 0 && maxPathsSet)
+       || (options.chartFile.empty() && chartSet)
+       || (options.cacheDir.empty() && cacheSized)
+       || (options.topQueries.empty() && !options.topFile.empty())
+       || (options.resourceFile.empty() 
+           && (prioritySet || !options.resourceCsv.empty()))) {
+        cout << "Error, invalid command line options.\n";
+        return false;
+    }
+    
+    given = optionsGiven(options, fnFlag);
+    
+    while(MODES[mode].selects != 0 && (given & MODES[mode].selects) == 0) {
+        mode++;
+    }
+    
+    if(options.batchPath.empty() && !fnFlag) {
+        cout << "Error, invalid project file name specifier.\n";
+        return false;
+    }
+    
+    // threads only parse numbered task files, sort the concurrency events,
+    // reduce a single project and rank its top-k queries; snapshots do not
+    // keep milestone names, and calendars, crash costs, resource demands
+    // and edit scripts number them
+    if((given & ~(MODES[mode].selects | MODES[mode].allowed)) != 0
+       || (options.threadCount != 0 && options.stringIDs 
+           && !options.concurrency && !options.reduce 
+           && options.topQueries.empty())
+       || (options.stringIDs && (!options.snapshotFile.empty()
+                                 || !options.calendarFile.empty()
+                                 || !options.crashFile.empty()
+                                 || !options.editsFile.empty()
+                                 || !options.resourceFile.empty()))) {
+        cout << "Error, invalid command line options.\n";
+        return false;
+    }
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool readLayout(const std::string fileName, ganttLayout& layout) {
+    using namespace std;
+    
+    string line;
+    string ignore;
+    string key;
+    string value;
+    long long count = 0;
+    
+    taskStream inFile(fileName);
+    
+    if(!inFile) {
+        return false;
+    }
+    
+    getline(inFile, line);
+    inFile >> ignore >> count;
+    inFile >> ignore >> ignore;   // source, possibly a named milestone
+    
+    if(!inFile) {
+        return false;
+    }
+    
+    layout.wideIndex = count >= 0xFFFFFFFFLL;
+    layout.weights = WEIGHT_INT32;
+    
+    inFile >> ws;
+    
+    if(isalpha(inFile.peek()) && inFile >> key >> value && key == "weights:") {
+        if(value == "int64") {
+            layout.weights = WEIGHT_INT64;
+        } else if(value == "double") {
+            layout.weights = WEIGHT_DOUBLE;
+        }
+    }
+    
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+namespace {
+    const std::size_t READ_BLOCK = 1 << 20;    // bytes read at a time
+    
+    // task as written, before the milestone count check of addEdge()
+    template <class wgtType>
+    struct parsedTask {
+        long long from;
+        long long to;
+        typename weightTraits<wgtType>::raw weight;
+    };
+    
+    // one block of whole task lines and, once parsed, its tasks; slots go
+    // round from the reader to a parser to the builder and back
+    template <class wgtType>
+    struct readSlot {
+        std::vector<char> text;                     // NUL-terminated lines
+        std::size_t size;                           // bytes of text
+        std::size_t sequence;                       // block # in the file
+        std::vector<parsedTask<wgtType> > tasks;    // tasks, in line order
+        bool malformed;                             // the block ends the list
+    };
+    
+    // true if c ends a task file token
+    bool endsToken(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\0';
+    }
+    
+    // bounded queue of slot numbers that a stage sleeps on while it is
+    // empty; the slots go through the lock-free ring and the mutex only
+    // guards the sleep, so a waiting stage leaves its core to the others
+    class slotQueue {
+    private:
+        concurrentQueue<std::size_t> slots;
+        std::mutex sleep;
+        std::condition_variable added;      // a slot was added, or closed
+        bool closed;                        // no more slots will be added
+        
+    public:
+        explicit slotQueue(std::size_t capacity) : slots(capacity) {
+            closed = false;
+        }
+        
+        // never full, the ring holds every slot of the pipeline
+        void addItem(std::size_t slot) {
+            slots.addItem(slot);
+            
+            // a stage that found the ring empty is asleep or still holds
+            // the mutex, so taking it here means the wakeup is not lost
+            {
+                std::lock_guard<std::mutex> guard(sleep);
+            }
+            
+            added.notify_one();
+        }
+        
+        // waits for a slot; false once closed and empty
+        bool deleteItem(std::size_t& slot) {
+            if(slots.deleteItem(slot)) {
+                return true;
+            }
+            
+            std::unique_lock<std::mutex> guard(sleep);
+            
+            while(!slots.deleteItem(slot)) {
+                if(closed) {
+                    return false;
+                }
+                
+                added.wait(guard);
+            }
+            
+            return true;
+        }
+        
+        // wakes every waiting stage once the ring is drained
+        void close() {
+            {
+                std::lock_guard<std::mutex> guard(sleep);
+                closed = true;
+            }
+            
+            added.notify_all();
+        }
+    };
+    
+    // readGraph()'s stages: a reader fills free slots with blocks of the
+    // file, parsers turn the blocks into tasks and the builder (the calling
+    // thread) adds them in file order.  Bounded queues of slot numbers join
+    // the stages, so no more than the slots' blocks are ever in memory, and
+    // a stage with nothing to do sleeps on its queue.  Each stage closes
+    // the queue after it once done.  A compressed file is read from its
+    // stream rather than its descriptor.
+    template <class wgtType>
+    struct readPipeline {
+        int file;                                   // task file descriptor
+        std::istream *stream;                       // or decompressed text
+        std::vector<readSlot<wgtType> > slots;
+        slotQueue *freeSlots;                       // to the reader
+        slotQueue *readSlots;                       // to the parsers
+        slotQueue *parsedSlots;                     // to the builder
+        std::atomic<bool> stop;                     // a malformed line built
+        std::atomic<int> parsers;                   // parsers still running
+        
+        void readBlocks() {
+            using namespace std;
+            
+            vector<char> carry;     // partial last line of the last block
+            size_t sequence = 0;
+            size_t slot = 0;
+            ssize_t bytes = 0;
+            
+            while(!stop.load(memory_order_relaxed) 
+                  && freeSlots->deleteItem(slot)) {
+                readSlot<wgtType>& block = slots[slot];
+                size_t size = carry.size();
+                
+                block.text.resize(max(block.text.size(), 
+                                      size + READ_BLOCK + 1));
+                copy(carry.begin(), carry.end(), block.text.begin());
+                
+                do {
+                    if(stream != nullptr) {
+                        stream->read(&block.text[size], 
+                                     carry.size() + READ_BLOCK - size);
+                        bytes = stream->gcount();
+                    } else {
+                        bytes = ::read(file, &block.text[size], 
+                                       carry.size() + READ_BLOCK - size);
+                    }
+                    size += (bytes > 0) ? static_cast<size_t>(bytes) : 0;
+                } while(bytes > 0 && size < carry.size() + READ_BLOCK);
+                
+                // the blocks end at a line break, but for the file's last
+                if(bytes > 0) {
+                    size_t end = size;
+                    
+                    while(end > 0 && block.text[end - 1] != '\n') {
+                        end--;
+                    }
+                    
+                    carry.assign(block.text.begin() + end, 
+                                 block.text.begin() + size);
+                    
+                    // a line longer than a block is carried whole
+                    if(end == 0) {
+                        freeSlots->addItem(slot);
+                        continue;
+                    }
+                    
+                    size = end;
+                } else {
+                    carry.clear();
+                }
+                
+                if(size == 0) {
+                    freeSlots->addItem(slot);
+                    break;
+                }
+                
+                block.text[size] = '\0';
+                block.size = size;
+                block.sequence = sequence++;
+                readSlots->addItem(slot);
+                
+                if(bytes <= 0) {
+                    break;
+                }
+            }
+            
+            readSlots->close();
+        }
+        
+        void parseBlocks() {
+            std::size_t slot = 0;
+            
+            while(readSlots->deleteItem(slot)) {
+                parse(slots[slot]);
+                parsedSlots->addItem(slot);
+            }
+            
+            // the last parser out tells the builder every block is parsed
+            if(parsers.fetch_sub(1) == 1) {
+                parsedSlots->close();
+            }
+        }
+        
+        // from, to, weight; stops at the first malformed line like
+        // readNamedGraph(), anything after the weight is ignored
+        void parse(readSlot<wgtType>& block) {
+            const char *p = &block.text[0];
+            char *end = nullptr;
+            parsedTask<wgtType> task = { 0, 0, 0 };
+            
+            block.tasks.clear();
+            block.malformed = false;
+            
+            while(*p != '\0') {
+                while(*p == ' ' || *p == '\t' || *p == '\r') {
+                    p++;
+                }
+                
+                if(*p == '\n') {
+                    p++;
+                    continue;
+                }
+                
+                if(*p == '\0') {
+                    break;
+                }
+                
+                task.from = strtoll(p, &end, 10);
+                block.malformed = (end == p || !endsToken(*end));
+                p = skipBlanks(end);
+                
+                if(!block.malformed) {
+                    task.to = strtoll(p, &end, 10);
+                    block.malformed = (end == p || !endsToken(*end));
+                    p = skipBlanks(end);
+                }
+                
+                if(!block.malformed) {
+                    task.weight = parseWeight(p, &end, task.weight);
+                    block.malformed = (end == p || !endsToken(*end));
+                    p = end;
+                }
+                
+                if(block.malformed) {
+                    break;
+                }
+                
+                block.tasks.push_back(task);
+                
+                while(*p != '\0' && *p != '\n') {
+                    p++;
+                }
+            }
+        }
+        
+        // blanks, but not line breaks, are skipped so that a token is
+        // never taken from the next line
+        static const char *skipBlanks(const char *p) {
+            while(*p == ' ' || *p == '\t' || *p == '\r') {
+                p++;
+            }
+            
+            return (*p == '\n') ? "" : p;
+        }
+    };
+}
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::readGraph(const std::string fileName, 
+                                             int threads) {
+    using namespace std;
+    
+    string ignore;
+    long long count = 0;   // milestone count as written
+    long long source = 0;  // source node as written
+    streamoff offset = 0;  // first task line
+    double total = 0;      // sum of weight magnitudes
+    readPipeline<wgtType> pipeline;
+    vector<thread> workers;
+    vector<size_t> ready;  // parsed slot + 1 by sequence, 0 if not yet
+    size_t next = 0;       // sequence of the next block to build
+    size_t slot = 0;
+    idxType from = 0;      // task milestones, once range checked
+    idxType to = 0;
+    idxType before = 0;
+    
+    taskStream inFile(fileName);
+    
+    if(!inFile) {
+        return false;
+    }
+    
+    getline(inFile, title, '\n');
+    
+    //? where is the extra "title:" coming from
+    if(title.substr(0, 6) == "title:") {
+        title.erase(0, 6);
+    }
+    
+    inFile >> ignore >> count;
+    inFile >> ignore >> source;
+    skipLayoutLine(inFile);
+    
+    milestoneCount = static_cast<idxType>(count);
+    sourceNode = static_cast<idxType>(source);
+    
+    // a compressed file can not seek, its tasks are read on from the stream
+    if(inFile.compression() == COMPRESSION_NONE) {
+        offset = inFile ? static_cast<streamoff>(inFile.tellg()) : -1;
+        pipeline.stream = nullptr;
+    } else {
+        offset = inFile ? 0 : -1;
+        pipeline.stream = &inFile;
+    }
+    
+    if(count <= 0 || static_cast<long long>(milestoneCount) != count) {
+        return false;
+    }
+    
+    // create list, the degrees are counted as the tasks are added
+    adjList = new vertexNode[milestoneCount];
+    indeg = new idxType[milestoneCount]{};
+    outdeg = new idxType[milestoneCount]{};
+    
+    for(idxType i = 0; i < milestoneCount; i++) {
+        adjList[i].head = nullptr;
+    }
+    
+    // a header without tasks leaves no task lines
+    if(offset < 0) {
+        return true;
+    }
+    
+    if(pipeline.stream == nullptr) {
+        pipeline.file = ::open(fileName.c_str(), O_RDONLY);
+        
+        if(pipeline.file < 0 
+           || ::lseek(pipeline.file, offset, SEEK_SET) != offset) {
+            if(pipeline.file >= 0) {
+                ::close(pipeline.file);
+            }
+            
+            return true;
+        }
+        
+        posix_fadvise(pipeline.file, offset, 0, POSIX_FADV_SEQUENTIAL);
+    } else {
+        pipeline.file = -1;
+    }
+    
+    if(threads <= 0) {
+        threads = max(1, static_cast<int>(thread::hardware_concurrency()) - 2);
+    }
+    
+    // two blocks per parser, one being read and one being built
+    pipeline.slots.resize(2 * static_cast<size_t>(threads) + 2);
+    pipeline.freeSlots = new slotQueue(pipeline.slots.size());
+    pipeline.readSlots = new slotQueue(pipeline.slots.size());
+    pipeline.parsedSlots = new slotQueue(pipeline.slots.size());
+    pipeline.stop.store(false);
+    pipeline.parsers.store(threads);
+    ready.assign(pipeline.slots.size(), 0);
+    
+    for(size_t i = 0; i < pipeline.slots.size(); i++) {
+        pipeline.freeSlots->addItem(i);
+    }
+    
+    workers.push_back(thread(&readPipeline<wgtType>::readBlocks, &pipeline));
+    
+    for(int t = 0; t < threads; t++) {
+        workers.push_back(thread(&readPipeline<wgtType>::parseBlocks, 
+                                 &pipeline));
+    }
+    
+    // add edges in file order, until the parsers close their queue; after
+    // a malformed line the remaining blocks are only handed back
+    while(pipeline.parsedSlots->deleteItem(slot)) {
+        ready[pipeline.slots[slot].sequence % ready.size()] = slot + 1;
+        
+        while(ready[next % ready.size()] != 0) {
+            readSlot<wgtType>& block = pipeline.slots[ready[next 
+                                                      % ready.size()] - 1];
+            
+            for(size_t i = 0; !pipeline.stop.load(memory_order_relaxed) 
+                              && i < block.tasks.size(); i++) {
+                const parsedTask<wgtType>& task = block.tasks[i];
+                
+                // range checked before the narrowing, which would wrap
+                if(task.from >= 0 && task.to >= 0 
+                   && task.from < count && task.to < count) {
+                    from = static_cast<idxType>(task.from);
+                    to = static_cast<idxType>(task.to);
+                    before = taskCount;
+                    addEdge(from, to, static_cast<wgtType>(task.weight));
+                    
+                    if(taskCount != before) {
+                        outdeg[from]++;
+                        indeg[to]++;
+                    }
+                }
+                
+                total += fabs(static_cast<double>(task.weight));
+            }
+            
+            if(block.malformed) {
+                pipeline.stop.store(true, memory_order_relaxed);
+            }
+            
+            pipeline.freeSlots->addItem(ready[next % ready.size()] - 1);
+            ready[next % ready.size()] = 0;
+            next++;
+        }
+    }
+    
+    for(size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    
+    if(pipeline.file >= 0) {
+        ::close(pipeline.file);
+    }
+    
+    delete pipeline.freeSlots;
+    delete pipeline.readSlots;
+    delete pipeline.parsedSlots;
+    
+    weightOverflow = overflowsWeight<wgtType>(total);
+    
+    // a damaged file is only noticed once its tasks were read; a malformed
+    // line may have stopped the reading first
+    return !inFile.isCorrupt();
+}
+
+/// ----------------------------------------------------------------------------
+
+namespace {
+    // task between interned milestones, kept until the count is known
+    template <class wgtType>
+    struct namedTask {
+        int from;
+        int to;
+        typename weightTraits<wgtType>::raw weight;
+    };
+    
+    // advances past blanks, returns the length of the token that follows
+    size_t nextToken(const char *&p) {
+        while(*p == ' ' || *p == '\t' || *p == '\r') {
+            p++;
+        }
+        
+        const char *start = p;
+        
+        while(*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r') {
+            p++;
+        }
+        
+        return static_cast<size_t>(p - start);
+    }
+}
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::readNamedGraph(const std::string fileName) {
+    using namespace std;
+    
+    string ignore;
+    string line;           // reused for every task line
+    string source;
+    long hint = 0;         // milestone count, a size hint only
+    vector<namedTask<wgtType> > tasks;
+    namedTask<wgtType> task;
+    const char *p = nullptr;
+    const char *token = nullptr;
+    size_t length = 0;
+    char *end = nullptr;
+    double total = 0;      // sum of weight magnitudes
+    bool first = true;     // no line read past the header yet
+    
+    taskStream inFile(fileName);
+    
+    if(!inFile) {
+        return false;
+    }
+    
+    getline(inFile, title, '\n');
+    
+    if(title.substr(0, 6) == "title:") {
+        title.erase(0, 6);
+    }
+    
+    inFile >> ignore >> hint;
+    inFile >> ignore >> source;
+    getline(inFile, line);
+    
+    if(!inFile || source.empty()) {
+        return false;
+    }
+    
+    names = new idInterner(hint > 0 ? static_cast<size_t>(hint) : 0);
+    sourceNode = names->intern(source.data(), source.size());
+    
+    // from, to, weight; stops at the first malformed line like readGraph
+    while(getline(inFile, line)) {
+        p = line.c_str();
+        length = nextToken(p);
+        
+        if(length == 0) {
+            if(*p == '\0') {
+                continue;
+            }
+            
+            break;
+        }
+        
+        token = p - length;
+        
+        // a task line may start with a letter too, so only a first line of
+        // "weights: <type>" is the layout line (see readLayout())
+        if(first && length == 8 && strncmp(token, "weights:", 8) == 0) {
+            first = false;
+            continue;
+        }
+        
+        first = false;
+        task.from = names->intern(token, length);
+        
+        length = nextToken(p);
+        token = p - length;
+        
+        if(length == 0) {
+            break;
+        }
+        
+        task.to = names->intern(token, length);
+        
+        length = nextToken(p);
+        token = p - length;
+        task.weight = parseWeight(token, &end, task.weight);
+        
+        if(length == 0 || end != p) {
+            break;
+        }
+        
+        tasks.push_back(task);
+    }
+    
+    if(inFile.isCorrupt()) {
+        return false;
+    }
+    
+    milestoneCount = static_cast<idxType>(names->size());
+    adjList = new vertexNode[milestoneCount];
+    
+    for(idxType i = 0; i < milestoneCount; i++) {
+        adjList[i].head = nullptr;
+    }
+    
+    for(size_t i = 0; i < tasks.size(); i++) {
+        addEdge(static_cast<idxType>(tasks[i].from), 
+                static_cast<idxType>(tasks[i].to), 
+                static_cast<wgtType>(tasks[i].weight));
+        total += fabs(static_cast<double>(tasks[i].weight));
+    }
+    
+    weightOverflow = overflowsWeight<wgtType>(total);
+    
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::addEdge(idxType from, idxType to, 
+                                           wgtType edge) {
+    if(from < milestoneCount && to < milestoneCount && from != to) {
+           
+        edgeNode *temp = listNodes.allocate();
+        temp->dest = to;
+        temp->weight = edge;
+        temp->link = nullptr;
+        
+        // first connection
+        if(adjList[from].head == nullptr) {
+            adjList[from].head = temp;
+            taskCount++;
+        } else {
+            edgeNode *curr = adjList[from].head;
+            
+            // existing connection
+            if(curr->dest == to) {
+                curr->weight = edge;
+                listNodes.release(temp);
+                temp = nullptr;
+                
+            // new connection
+            } else {
+                temp->link = adjList[from].head;
+                adjList[from].head = temp;
+                taskCount++;
+            }
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::isValidProject() {
+    bool *visited = new bool[milestoneCount]{};
+    bool *marked = new bool[milestoneCount]{};
+    
+    for(idxType i = 0; i < milestoneCount; i++) {
+        visited[i] = false;
+        marked[i] = false;
+    }
+
+    // check each node for an edge to itself or to one of its ancestors
+    for(idxType v = 0; v < milestoneCount; v++) {
+        if(!visited[v]) {
+            if(isCycle(v, visited, marked)) {
+                
+                delete [] visited;
+                visited = nullptr;
+                
+                delete [] marked;
+                marked = nullptr;
+                
+                return false;
+            }
+        } 
+    }
+    
+    delete [] visited;
+    visited = nullptr;
+    
+    delete [] marked;
+    marked = nullptr;
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::isCycle(idxType v, bool *visited, 
+                                           bool *marked) {
+    if(!visited[v]) {
+        visited[v] = true;
+        marked[v] = true;
+        
+        edgeCursor curr = edges(v);
+        idxType u = 0;
+        
+        while(curr.valid()) {            
+            u = curr.dest();
+            
+            if(isCycle(u, visited, marked)) {
+                return true;
+            } else if(marked[u]) {
+                return true;
+            }
+            
+            curr.next();
+        }
+        
+        marked[v] = false;
+        return false;
+    }
+
+    return false;
+}
+
+/// ----------------------------------------------------------------------------
+
+namespace {
+    const char SNAPSHOT_MAGIC[8] = { 'G', 'A', 'N', 'T', 'T', 'S', 'N', 'P' };
+    const uint32_t SNAPSHOT_VERSION = 1;
+    
+    // size and modification time of the task file a snapshot stands for
+    bool fileStamp(const std::string& fileName, uint64_t& size, 
+                   uint64_t& time) {
+        struct stat info;
+        
+        if(stat(fileName.c_str(), &info) != 0) {
+            return false;
+        }
+        
+        size = static_cast<uint64_t>(info.st_size);
+        time = static_cast<uint64_t>(info.st_mtim.tv_sec) * 1000000000ULL
+               + static_cast<uint64_t>(info.st_mtim.tv_nsec);
+        
+        return true;
+    }
+    
+    template <class valueType>
+    void putRaw(std::ostream& out, const valueType& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    
+    template <class valueType>
+    void getRaw(std::istream& in, valueType& value) {
+        in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    }
+}
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::readSnapshot(const std::string snapshotFile,
+                                                const std::string fileName, 
+                                                bool reduce) {
+    using namespace std;
+    
+    char magic[sizeof(SNAPSHOT_MAGIC)] = {};
+    uint32_t version = 0;
+    uint32_t idxBytes = 0;
+    uint32_t wgtBytes = 0;
+    uint32_t integral = 0;
+    uint64_t size = 0;
+    uint64_t time = 0;
+    uint64_t fileSize = 0;
+    uint64_t fileTime = 0;
+    unsigned char isReduced = 0;
+    unsigned char overflow = 0;
+    uint64_t count = 0;     // milestones
+    uint64_t source = 0;
+    uint64_t tasks = 0;     // tasks kept
+    uint64_t removed = 0;   // tasks dropped by reduceTasks()
+    uint64_t length = 0;    // title length
+    uint64_t degree = 0;
+    string text;
+    vector<uint64_t> degrees;
+    vector<idxType> dests;
+    vector<wgtType> weights;
+    idxType to = 0;
+    wgtType edge = 0;
+    size_t next = 0;
+    edgeNode *tail = nullptr;
+    
+    if(adjList != nullptr || edgeBytes != nullptr
+       || !fileStamp(fileName, fileSize, fileTime)) {
+        return false;
+    }
+    
+    ifstream inFile(snapshotFile, ios::binary);
+    
+    inFile.read(magic, sizeof(magic));
+    getRaw(inFile, version);
+    getRaw(inFile, idxBytes);
+    getRaw(inFile, wgtBytes);
+    getRaw(inFile, integral);
+    getRaw(inFile, size);
+    getRaw(inFile, time);
+    getRaw(inFile, isReduced);
+    getRaw(inFile, overflow);
+    getRaw(inFile, count);
+    getRaw(inFile, source);
+    getRaw(inFile, tasks);
+    getRaw(inFile, removed);
+    getRaw(inFile, length);
+    
+    // stale, or written by another version or layout
+    if(!inFile || memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0
+       || version != SNAPSHOT_VERSION || idxBytes != sizeof(idxType)
+       || wgtBytes != sizeof(wgtType) 
+       || (integral != 0) != numeric_limits<wgtType>::is_integer
+       || size != fileSize || time != fileTime || (isReduced != 0) != reduce
+       || count == 0 || static_cast<uint64_t>(static_cast<idxType>(count)) 
+                        != count
+       || length > size) {
+        return false;
+    }
+    
+    text.resize(length);
+    inFile.read(&text[0], length);
+    degrees.resize(count);
+    
+    for(uint64_t v = 0; v < count && inFile; v++) {
+        getRaw(inFile, degree);
+        degrees[v] = degree;
+        
+        for(uint64_t d = 0; d < degree && inFile; d++) {
+            getRaw(inFile, to);
+            getRaw(inFile, edge);
+            dests.push_back(to);
+            weights.push_back(edge);
+        }
+    }
+    
+    if(!inFile || dests.size() != tasks) {
+        return false;
+    }
+    
+    title = text;
+    milestoneCount = static_cast<idxType>(count);
+    sourceNode = static_cast<idxType>(source);
+    taskCount = static_cast<size_t>(tasks);
+    removedTasks = static_cast<size_t>(removed);
+    reduced = isReduced != 0;
+    weightOverflow = overflow != 0;
+    adjList = new vertexNode[milestoneCount];
+    
+    // rebuild each list in its saved order
+    for(idxType v = 0; v < milestoneCount; v++) {
+        adjList[v].head = nullptr;
+        tail = nullptr;
+        
+        for(uint64_t d = 0; d < degrees[v]; d++, next++) {
+            edgeNode *temp = listNodes.allocate();
+            temp->dest = dests[next];
+            temp->weight = weights[next];
+            temp->link = nullptr;
+            
+            if(tail == nullptr) {
+                adjList[v].head = temp;
+            } else {
+                tail->link = temp;
+            }
+            
+            tail = temp;
+        }
+    }
+    
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::writeSnapshot(
+        const std::string snapshotFile, const std::string fileName) const {
+    using namespace std;
+    
+    uint64_t size = 0;
+    uint64_t time = 0;
+    uint64_t degree = 0;
+    edgeCursor curr;
+    
+    // milestones must still have their original numbers
+    if((adjList == nullptr && edgeBytes == nullptr) || label != nullptr
+       || !fileStamp(fileName, size, time)) {
+        return false;
+    }
+    
+    ofstream outFile(snapshotFile, ios::binary | ios::trunc);
+    
+    outFile.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    putRaw(outFile, SNAPSHOT_VERSION);
+    putRaw(outFile, static_cast<uint32_t>(sizeof(idxType)));
+    putRaw(outFile, static_cast<uint32_t>(sizeof(wgtType)));
+    putRaw(outFile, static_cast<uint32_t>(
+                        numeric_limits<wgtType>::is_integer ? 1 : 0));
+    putRaw(outFile, size);
+    putRaw(outFile, time);
+    putRaw(outFile, static_cast<unsigned char>(reduced ? 1 : 0));
+    putRaw(outFile, static_cast<unsigned char>(weightOverflow ? 1 : 0));
+    putRaw(outFile, static_cast<uint64_t>(milestoneCount));
+    putRaw(outFile, static_cast<uint64_t>(sourceNode));
+    putRaw(outFile, static_cast<uint64_t>(taskCount));
+    putRaw(outFile, static_cast<uint64_t>(removedTasks));
+    putRaw(outFile, static_cast<uint64_t>(title.size()));
+    outFile.write(title.data(), title.size());
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        for(degree = 0, curr = edges(v, false); curr.valid(); curr.next()) {
+            degree++;
+        }
+        
+        putRaw(outFile, degree);
+        
+        for(curr = edges(v, false); curr.valid(); curr.next()) {
+            putRaw(outFile, curr.dest());
+            putRaw(outFile, curr.weight());
+        }
+    }
+    
+    return static_cast<bool>(outFile);
+}
+
+
+/// ----------------------------------------------------------------------------
+
+namespace {
+    const char RESULT_MAGIC[8] = { 'G', 'A', 'N', 'T', 'T', 'R', 'E', 'S' };
+    const uint32_t RESULT_VERSION = 1;
+    
+    // arrays of a result file, each at an 8-byte aligned offset
+    enum resultSection {
+        RESULT_TITLE, RESULT_INDEG, RESULT_OUTDEG, RESULT_INDEPENDENT, 
+        RESULT_APS, RESULT_TOPO, RESULT_CRPATH, RESULT_SLACK, RESULT_SECTIONS
+    };
+    
+    // fixed head of a result file, followed by the sections
+    struct resultHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t idxBytes;
+        uint32_t wgtBytes;
+        uint32_t integral;
+        uint64_t hash;              // XXH64 of the task file
+        uint64_t size;              // task file bytes
+        uint64_t reduced;
+        uint64_t fileBytes;         // result file bytes
+        uint64_t milestones;
+        uint64_t tasks;
+        uint64_t removed;
+        uint64_t source;
+        uint64_t keyMS;
+        uint64_t nodePoint;
+        uint64_t independent;
+        uint64_t finalNode;
+        uint64_t pathCount;
+        uint64_t degrees[8];        // highID ... lowODCount
+        double ratio;
+        double density;
+        unsigned char duration[8];  // wgtType
+        uint64_t offset[RESULT_SECTIONS];
+        uint64_t bytes[RESULT_SECTIONS];
+    };
+}
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::readResults(const std::string resultFile, 
+                                               uint64_t hash, uint64_t size, 
+                                               bool reduce) {
+    using namespace std;
+    
+    resultHeader head;
+    struct stat info;
+    char *base = nullptr;
+    uint64_t counts[RESULT_SECTIONS];
+    size_t widths[RESULT_SECTIONS] = { 1, sizeof(idxType), sizeof(idxType), 
+                                       sizeof(idxType), sizeof(bool), 
+                                       sizeof(idxType), sizeof(idxType), 
+                                       sizeof(wgtType) };
+    bool valid = false;
+    int file = -1;
+    
+    if(adjList != nullptr || edgeBytes != nullptr || resultMap != nullptr) {
+        return false;
+    }
+    
+    file = ::open(resultFile.c_str(), O_RDONLY);
+    
+    if(file < 0) {
+        return false;
+    }
+    
+    if(fstat(file, &info) == 0 
+       && static_cast<size_t>(info.st_size) >= sizeof(head)) {
+        base = static_cast<char*>(mmap(nullptr, info.st_size, 
+                                       PROT_READ | PROT_WRITE, MAP_PRIVATE, 
+                                       file, 0));
+    }
+    
+    ::close(file);
+    
+    if(base == nullptr || base == MAP_FAILED) {
+        return false;
+    }
+    
+    memcpy(&head, base, sizeof(head));
+    counts[RESULT_TITLE] = head.bytes[RESULT_TITLE];
+    counts[RESULT_INDEG] = head.milestones;
+    counts[RESULT_OUTDEG] = head.milestones;
+    counts[RESULT_INDEPENDENT] = head.independent;
+    counts[RESULT_APS] = head.milestones;
+    counts[RESULT_TOPO] = head.milestones;
+    counts[RESULT_CRPATH] = head.pathCount;
+    counts[RESULT_SLACK] = head.milestones;
+    
+    // stale, or written by another version or layout
+    valid = memcmp(head.magic, RESULT_MAGIC, sizeof(head.magic)) == 0
+            && head.version == RESULT_VERSION 
+            && head.idxBytes == sizeof(idxType)
+            && head.wgtBytes == sizeof(wgtType)
+            && (head.integral != 0) == numeric_limits<wgtType>::is_integer
+            && head.hash == hash && head.size == size
+            && (head.reduced != 0) == reduce
+            && head.fileBytes == static_cast<uint64_t>(info.st_size)
+            && head.milestones > 0 
+            && static_cast<uint64_t>(static_cast<idxType>(head.milestones)) 
+               == head.milestones
+            && head.independent <= head.milestones
+            && head.pathCount <= head.milestones
+            && head.keyMS < head.milestones 
+            && head.nodePoint < head.milestones;
+    
+    for(int k = 0; valid && k < RESULT_SECTIONS; k++) {
+        valid = head.offset[k] % 8 == 0 && head.offset[k] >= sizeof(head)
+                && head.bytes[k] == counts[k] * widths[k]
+                && head.offset[k] <= head.fileBytes
+                && head.bytes[k] <= head.fileBytes - head.offset[k];
+    }
+    
+    if(!valid) {
+        munmap(base, info.st_size);
+        return false;
+    }
+    
+    // the arrays are used in place, the mapping is private so they may
+    // still be written to
+    resultMap = base;
+    resultBytes = static_cast<size_t>(info.st_size);
+    
+    title.assign(base + head.offset[RESULT_TITLE], head.bytes[RESULT_TITLE]);
+    milestoneCount = static_cast<idxType>(head.milestones);
+    taskCount = static_cast<size_t>(head.tasks);
+    removedTasks = static_cast<size_t>(head.removed);
+    reduced = head.reduced != 0;
+    sourceNode = static_cast<idxType>(head.source);
+    tasksMSRatio = head.ratio;
+    tasksDensity = head.density;
+    keyMS = static_cast<idxType>(head.keyMS);
+    nodePoint = static_cast<idxType>(head.nodePoint);
+    iMSCount = static_cast<idxType>(head.independent);
+    finalNode = static_cast<idxType>(head.finalNode);
+    crPathCount = static_cast<idxType>(head.pathCount);
+    memcpy(&duration, head.duration, sizeof(duration));
+    highID = static_cast<idxType>(head.degrees[0]);
+    highIDCount = static_cast<idxType>(head.degrees[1]);
+    lowID = static_cast<idxType>(head.degrees[2]);
+    lowIDCount = static_cast<idxType>(head.degrees[3]);
+    highOD = static_cast<idxType>(head.degrees[4]);
+    highODCount = static_cast<idxType>(head.degrees[5]);
+    lowOD = static_cast<idxType>(head.degrees[6]);
+    lowODCount = static_cast<idxType>(head.degrees[7]);
+    
+    indeg = reinterpret_cast<idxType*>(base + head.offset[RESULT_INDEG]);
+    outdeg = reinterpret_cast<idxType*>(base + head.offset[RESULT_OUTDEG]);
+    independentMS = reinterpret_cast<idxType*>(
+                        base + head.offset[RESULT_INDEPENDENT]);
+    aps = reinterpret_cast<bool*>(base + head.offset[RESULT_APS]);
+    topoNodes = reinterpret_cast<idxType*>(base + head.offset[RESULT_TOPO]);
+    crPath = reinterpret_cast<idxType*>(base + head.offset[RESULT_CRPATH]);
+    slackTimes = reinterpret_cast<wgtType*>(base + head.offset[RESULT_SLACK]);
+    
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::writeResults(const std::string resultFile, 
+                                                uint64_t hash, 
+                                                uint64_t size) const {
+    using namespace std;
+    
+    resultHeader head;
+    const char *data[RESULT_SECTIONS] = {
+        title.data(), 
+        reinterpret_cast<const char*>(indeg), 
+        reinterpret_cast<const char*>(outdeg), 
+        reinterpret_cast<const char*>(independentMS), 
+        reinterpret_cast<const char*>(aps), 
+        reinterpret_cast<const char*>(topoNodes), 
+        reinterpret_cast<const char*>(crPath), 
+        reinterpret_cast<const char*>(slackTimes) 
+    };
+    const char padding[8] = {};
+    uint64_t end = sizeof(head);
+    string temporary = resultFile + ".tmp";
+    
+    // only after the analysis, on the original milestone numbers
+    if(indeg == nullptr || outdeg == nullptr || independentMS == nullptr 
+       || aps == nullptr || topoNodes == nullptr || crPath == nullptr 
+       || slackTimes == nullptr || label != nullptr) {
+        return false;
+    }
+    
+    memset(&head, 0, sizeof(head));
+    memcpy(head.magic, RESULT_MAGIC, sizeof(head.magic));
+    head.version = RESULT_VERSION;
+    head.idxBytes = sizeof(idxType);
+    head.wgtBytes = sizeof(wgtType);
+    head.integral = numeric_limits<wgtType>::is_integer ? 1 : 0;
+    head.hash = hash;
+    head.size = size;
+    head.reduced = reduced ? 1 : 0;
+    head.milestones = milestoneCount;
+    head.tasks = taskCount;
+    head.removed = removedTasks;
+    head.source = sourceNode;
+    head.keyMS = keyMS;
+    head.nodePoint = nodePoint;
+    head.independent = iMSCount;
+    head.finalNode = finalNode;
+    head.pathCount = crPathCount;
+    head.degrees[0] = highID;
+    head.degrees[1] = highIDCount;
+    head.degrees[2] = lowID;
+    head.degrees[3] = lowIDCount;
+    head.degrees[4] = highOD;
+    head.degrees[5] = highODCount;
+    head.degrees[6] = lowOD;
+    head.degrees[7] = lowODCount;
+    head.ratio = tasksMSRatio;
+    head.density = tasksDensity;
+    memcpy(head.duration, &duration, sizeof(duration));
+    head.bytes[RESULT_TITLE] = title.size();
+    head.bytes[RESULT_INDEG] = milestoneCount * sizeof(idxType);
+    head.bytes[RESULT_OUTDEG] = milestoneCount * sizeof(idxType);
+    head.bytes[RESULT_INDEPENDENT] = iMSCount * sizeof(idxType);
+    head.bytes[RESULT_APS] = milestoneCount * sizeof(bool);
+    head.bytes[RESULT_TOPO] = milestoneCount * sizeof(idxType);
+    head.bytes[RESULT_CRPATH] = crPathCount * sizeof(idxType);
+    head.bytes[RESULT_SLACK] = milestoneCount * sizeof(wgtType);
+    
+    for(int k = 0; k < RESULT_SECTIONS; k++) {
+        head.offset[k] = end;
+        end = (end + head.bytes[k] + 7) / 8 * 8;
+    }
+    
+    head.fileBytes = end;
+    
+    // written aside and renamed, so a reader never maps half a file
+    ofstream outFile(temporary, ios::binary | ios::trunc);
+    
+    outFile.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    
+    for(int k = 0; k < RESULT_SECTIONS; k++) {
+        outFile.write(data[k], head.bytes[k]);
+        outFile.write(padding, (8 - head.bytes[k] % 8) % 8);
+    }
+    
+    outFile.close();
+    
+    if(!outFile || rename(temporary.c_str(), resultFile.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return false;
+    }
+    
+    return true;
+}
+
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+std::size_t ganttUtils<idxType, wgtType>::getTaskCount() const {
+    return taskCount;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+idxType ganttUtils<idxType, wgtType>::getMilestoneCount() const {
+    return milestoneCount;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::getTasks(std::vector<idxType>& from,
+                                            std::vector<idxType>& to,
+                                            std::vector<wgtType>& weight) 
+                                            const {
+    from.clear();
+    to.clear();
+    weight.clear();
+    from.reserve(taskCount);
+    to.reserve(taskCount);
+    weight.reserve(taskCount);
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        for(edgeCursor curr = edges(v, false); curr.valid(); curr.next()) {
+            from.push_back(original(v));
+            to.push_back(original(curr.dest()));
+            weight.push_back(curr.weight());
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::hasWeightOverflow() const {
+    return weightOverflow;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+const idInterner* ganttUtils<idxType, wgtType>::getNames() const {
+    return names;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::getTaskBars(std::vector<taskBar>& bars) 
+                                               const {
+    idxType *next = new idxType[milestoneCount];
+    edgeCursor curr;
+    taskBar bar;
+    
+    // successor of each milestone on the critical path (stored final first)
+    for(idxType v = 0; v < milestoneCount; v++) {
+        next[v] = NONE;
+    }
+    
+    for(idxType i = 1; i < crPathCount; i++) {
+        next[crPath[i]] = crPath[i - 1];
+    }
+    
+    bars.clear();
+    bars.reserve(taskCount);
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        for(curr = edges(v, false); curr.valid(); curr.next()) {
+            bar.start = static_cast<double>(dist[v]);
+            bar.finish = static_cast<double>(dist[v] + curr.weight());
+            bar.from = original(v);
+            bar.to = original(curr.dest());
+            bar.critical = next[original(v)] == original(curr.dest())
+                           && dist[v] + curr.weight() == dist[curr.dest()];
+            bars.push_back(bar);
+        }
+    }
+    
+    delete [] next;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+std::string ganttUtils<idxType, wgtType>::getTitle() const {
+    return title;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+wgtType ganttUtils<idxType, wgtType>::getDuration() const {
+    return duration;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+idxType ganttUtils<idxType, wgtType>::getFinalNode() const {
+    return finalNode;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+idxType ganttUtils<idxType, wgtType>::getCriticalPathCount() const {
+    return crPathCount;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+idxType ganttUtils<idxType, wgtType>::getSourceNode() const {
+    return sourceNode;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+const wgtType* ganttUtils<idxType, wgtType>::getDistances() const {
+    return dist;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+const idxType* ganttUtils<idxType, wgtType>::getTopoOrder() const {
+    return topoNodes;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+const idxType* ganttUtils<idxType, wgtType>::getCriticalPath() const {
+    return crPath;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+const wgtType* ganttUtils<idxType, wgtType>::getSlackTimes() const {
+    return slackTimes;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+const idxType* ganttUtils<idxType, wgtType>::getInDegrees() const {
+    return indeg;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+const idxType* ganttUtils<idxType, wgtType>::getOutDegrees() const {
+    return outdeg;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+const bool* ganttUtils<idxType, wgtType>::getAPs() const {
+    return aps;
+}
+
+/// ----------------------------------------------------------------------------
+
+namespace {
+    const std::size_t REACH_WORDS = 1 << 22;    // reach bitset words per thread
+    
+    // one thread's share of reduceTasks(): target milestones are taken in
+    // blocks of 64 * words topological positions, and for each block the
+    // strict descendants of every milestone within it are OR-ed together in
+    // reverse topological order
+    template <class idxType, class wgtType>
+    struct reductionJob {
+        idxType count;                          // milestones
+        std::size_t words;                      // bitset words per block
+        const std::vector<std::size_t> *first;  // tasks of u: [first[u], first[u + 1])
+        const std::vector<idxType> *to;         // task destinations
+        const std::vector<wgtType> *weight;     // task weights
+        const std::vector<std::size_t> *heavy;  // tasks of u, heaviest first
+        const std::vector<idxType> *order;      // topological order
+        const std::vector<idxType> *pos;        // topological position
+        const std::vector<wgtType> *early;      // early start times
+        std::vector<char> *redundant;           // tasks to drop, out
+        
+        void run(std::size_t block, std::size_t step) {
+            using namespace std;
+            
+            size_t blocks = (static_cast<size_t>(count) + 64 * words - 1) 
+                            / (64 * words);
+            vector<uint64_t> reach;
+            vector<uint64_t> acc(words);
+            
+            for(; block < blocks; block += step) {
+                size_t lo = block * 64 * words;
+                size_t hi = min(static_cast<size_t>(count), lo + 64 * words);
+                
+                reach.assign(hi * words, 0);
+                
+                // milestones from hi on only reach milestones after hi
+                for(size_t p = hi; p-- > 0; ) {
+                    idxType u = (*order)[p];
+                    uint64_t *r = &reach[p * words];
+                    
+                    for(size_t e = (*first)[u]; e < (*first)[u + 1]; e++) {
+                        size_t s = (*pos)[(*to)[e]];
+                        
+                        if(s >= hi) {
+                            continue;
+                        }
+                        
+                        if(s >= lo) {
+                            r[(s - lo) >> 6] |= 1ULL << ((s - lo) & 63);
+                        }
+                        
+                        for(size_t k = 0; k < words; k++) {
+                            r[k] |= reach[s * words + k];
+                        }
+                    }
+                }
+                
+                // u->v is implied if v is reachable from a successor of u
+                // whose task is at least as heavy; u's last listed task
+                // stays, findSlackTimes() reads u's slack from it
+                for(size_t p = 0; p < hi; p++) {
+                    idxType u = (*order)[p];
+                    size_t last = (*first)[u + 1];
+                    size_t i = (*first)[u];
+                    
+                    if(last - i < 2) {
+                        continue;
+                    }
+                    
+                    fill(acc.begin(), acc.end(), 0);
+                    
+                    while(i < last) {
+                        size_t j = i;
+                        wgtType w = (*weight)[(*heavy)[i]];
+                        
+                        // tasks of equal weight imply each other
+                        for(; j < last && (*weight)[(*heavy)[j]] == w; j++) {
+                            size_t s = (*pos)[(*to)[(*heavy)[j]]];
+                            
+                            for(size_t k = 0; s < hi && k < words; k++) {
+                                acc[k] |= reach[s * words + k];
+                            }
+                        }
+                        
+                        for(; i < j; i++) {
+                            size_t e = (*heavy)[i];
+                            idxType v = (*to)[e];
+                            size_t s = (*pos)[v];
+                            
+                            if(s >= lo && s < hi && e + 1 != last
+                               && ((acc[(s - lo) >> 6] >> ((s - lo) & 63)) & 1)
+                               && (*early)[u] + w != (*early)[v]) {
+                                (*redundant)[e] = 1;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+    
+    template <class idxType, class wgtType>
+    struct heavierTask {
+        const std::vector<wgtType> *weight;
+        
+        bool operator()(std::size_t a, std::size_t b) const {
+            return (*weight)[a] > (*weight)[b];
+        }
+    };
+}
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::reduceTasks(int threads) {
+    using namespace std;
+    
+    vector<size_t> first(static_cast<size_t>(milestoneCount) + 1, 0);
+    vector<idxType> to;
+    vector<wgtType> weight;
+    vector<size_t> heavy;
+    vector<idxType> inCount(milestoneCount, 0);
+    vector<idxType> order;
+    vector<idxType> pos(milestoneCount, 0);
+    vector<wgtType> early(milestoneCount, 0);
+    vector<char> redundant;
+    vector<thread> workers;
+    reductionJob<idxType, wgtType> job;
+    heavierTask<idxType, wgtType> heavier = { &weight };
+    edgeNode *curr = nullptr;
+    edgeNode *prev = nullptr;
+    edgeNode *temp = nullptr;
+    size_t e = 0;
+    
+    // only on the original lists, before any pass
+    if(adjList == nullptr || edgeBytes != nullptr || label != nullptr 
+       || reduced || milestoneCount == 0) {
+        return;
+    }
+    
+    reduced = true;
+    
+    // tasks in list order
+    for(idxType u = 0; u < milestoneCount; u++) {
+        first[u] = to.size();
+        
+        for(curr = adjList[u].head; curr != nullptr; curr = curr->link) {
+            if(curr->weight < 0) {
+                return;
+            }
+            
+            to.push_back(curr->dest);
+            weight.push_back(curr->weight);
+            inCount[curr->dest]++;
+        }
+    }
+    
+    first[milestoneCount] = to.size();
+    
+    // Kahn's order and early start times, as in criticalPath()
+    for(idxType v = 0; v < milestoneCount; v++) {
+        if(inCount[v] == 0) {
+            order.push_back(v);
+        }
+    }
+    
+    for(size_t i = 0; i < order.size(); i++) {
+        idxType u = order[i];
+        
+        pos[u] = static_cast<idxType>(i);
+        
+        for(e = first[u]; e < first[u + 1]; e++) {
+            early[to[e]] = max(early[to[e]], early[u] + weight[e]);
+            
+            if(--inCount[to[e]] == 0) {
+                order.push_back(to[e]);
+            }
+        }
+    }
+    
+    heavy.resize(to.size());
+    
+    for(idxType u = 0; u < milestoneCount; u++) {
+        for(e = first[u]; e < first[u + 1]; e++) {
+            heavy[e] = e;
+        }
+        
+        stable_sort(heavy.begin() + first[u], heavy.begin() + first[u + 1], 
+                    heavier);
+    }
+    
+    redundant.assign(to.size(), 0);
+    
+    job.count = milestoneCount;
+    job.words = max(static_cast<size_t>(1), 
+                    min((static_cast<size_t>(milestoneCount) + 63) / 64, 
+                        REACH_WORDS / milestoneCount));
+    
+    if(threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    
+    // no more threads than blocks
+    threads = static_cast<int>(min(static_cast<size_t>(threads), 
+                                   (static_cast<size_t>(milestoneCount) 
+                                    + 64 * job.words - 1) / (64 * job.words)));
+    job.first = &first;
+    job.to = &to;
+    job.weight = &weight;
+    job.heavy = &heavy;
+    job.order = &order;
+    job.pos = &pos;
+    job.early = &early;
+    job.redundant = &redundant;
+    
+    for(int t = 0; t < threads; t++) {
+        workers.push_back(thread(&reductionJob<idxType, wgtType>::run, &job,
+                                 static_cast<size_t>(t), 
+                                 static_cast<size_t>(threads)));
+    }
+    
+    for(size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    
+    // unlink the redundant tasks, the others keep their order
+    e = 0;
+    
+    for(idxType u = 0; u < milestoneCount; u++) {
+        prev = nullptr;
+        
+        for(curr = adjList[u].head; curr != nullptr; curr = temp, e++) {
+            temp = curr->link;
+            
+            if(!redundant[e]) {
+                prev = curr;
+                continue;
+            }
+            
+            if(prev == nullptr) {
+                adjList[u].head = temp;
+            } else {
+                prev->link = temp;
+            }
+            
+            // the degrees readGraph() counted
+            if(indeg != nullptr) {
+                indeg[curr->dest]--;
+                outdeg[u]--;
+            }
+            
+            listNodes.release(curr);
+            removedTasks++;
+            taskCount--;
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printReduction(std::ostream& out) {
+    out << "------------------------------------------------------------\n"
+        << "Transitive Reduction:\n"
+        << "   Redundant Tasks Removed: " << removedTasks << "\n"
+        << "   Tasks Kept: " << taskCount << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::compress() {
+    using namespace std;
+    
+    typedef typename weightTraits<wgtType>::raw raw;
+    
+    vector<unsigned char> bytes;
+    edgeNode *curr = nullptr;
+    edgeNode *temp = nullptr;
+    idxType prev = 0;
+    
+    if(adjList == nullptr || edgeBytes != nullptr || label != nullptr) {
+        return;
+    }
+    
+    edgeOffset = new size_t[milestoneCount + 1];
+    listBytes = milestoneCount * sizeof(vertexNode);
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        edgeOffset[v] = bytes.size();
+        prev = v;
+        
+        // list order is kept, the passes' tie-breaking depends on it
+        for(curr = adjList[v].head; curr != nullptr; curr = temp) {
+            putVarint(bytes, zigzag(static_cast<long long>(curr->dest)
+                                    - static_cast<long long>(prev)));
+            putWeight(bytes, static_cast<raw>(curr->weight));
+            prev = curr->dest;
+            
+            temp = curr->link;
+            listBytes += sizeof(edgeNode);
+        }
+    }
+    
+    edgeOffset[milestoneCount] = bytes.size();
+    edgeBytes = new unsigned char[bytes.size() > 0 ? bytes.size() : 1];
+    copy(bytes.begin(), bytes.end(), edgeBytes);
+    
+    listNodes.clear();
+    delete [] adjList;
+    adjList = nullptr;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printStorage(std::ostream& out) {
+    using namespace std;
+    
+    size_t packed = 0;
+    
+    if(edgeBytes != nullptr) {
+        packed = edgeOffset[milestoneCount] 
+                 + (milestoneCount + 1) * sizeof(size_t);
+    }
+    
+    out << "------------------------------------------------------------\n"
+        << "Task Storage:\n"
+        << "   Adjacency List: " << listBytes << " bytes\n"
+        << "   Compressed: " << packed << " bytes\n"
+        << "   Bytes per Task: " << setprecision(2)
+        << (taskCount > 0 ? static_cast<double>(packed) / taskCount : 0.0)
+        << setprecision(6) << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findGraphInformation() {
+    double t = static_cast<double>(taskCount);
+    double m = static_cast<double>(milestoneCount);
+    
+    tasksMSRatio = t / m;
+    tasksDensity = (2 * t) / (m * (m - 1));
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findKeyMilestone() {
+    // find in-degrees and keep track of key milestone
+    // keyMS: latest milestone with the maximum in-degree
+    
+    edgeCursor curr;
+    
+    // readGraph() counts the degrees as it adds the tasks
+    if(indeg == nullptr) {
+        indeg = new idxType[milestoneCount]{};
+        
+        for(idxType v = 0; v < milestoneCount; v++) {
+            for(curr = edges(v); curr.valid(); curr.next()) {
+                indeg[curr.dest()]++;
+            }
+        }
+    }
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        if(indeg[v] >= indeg[keyMS]) {
+            keyMS = v;
+        }
+    }    
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findNodePoint() {
+    // find out-degrees and keep track of node point
+    // nodePoint: first milestone with the maximum out-degree
+
+    edgeCursor curr;
+    
+    if(outdeg == nullptr) {
+        outdeg = new idxType[milestoneCount]{};
+        
+        for(idxType v = 0; v < milestoneCount; v++) {
+            for(curr = edges(v); curr.valid(); curr.next()) {
+                outdeg[v]++;
+            }
+        }
+    }
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        if(outdeg[v] > outdeg[nodePoint]) {
+            nodePoint = v;
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findIndependentMilestones() {
+    independentMS = new idxType[milestoneCount]{};
+    
+    for(idxType i = 0; i < milestoneCount; i++) {
         independentMS[i] = 0;
     }
     
-    for(int v = 0; v < milestoneCount; v++) {
-        if(outdeg[v] == 0) {
-            independentMS[iMSCount] = v;
-            iMSCount++;
+    for(idxType v = 0; v < milestoneCount; v++) {
+        if(outdeg[v] == 0) {
+            independentMS[iMSCount] = v;
+            iMSCount++;
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printGraphInformation(std::ostream& out) {
+    using namespace std;
+    
+    out << "------------------------------------------------------------\n"
+         << fixed
+         << "Graph Information\n"
+         << "   Project title: " << title << endl
+         << "   Milestone Count: " << milestoneCount << endl
+         << "   Task Count: " << taskCount << endl
+         << "   Source Milestone: " << ms(names, sourceNode) << endl
+         << "   Tasks/Milestones Ratio: " << tasksMSRatio << endl
+         << "   Project Tasks Density: " << tasksDensity << endl << endl
+         << "   Key Milestone: " << ms(names, keyMS)
+         << ", in-degree: " << indeg[keyMS] << " tasks\n"
+         << "   Node Point: " << ms(names, nodePoint)
+         << ", out-degree: " << outdeg[nodePoint] << " tasks\n" 
+         << "   Independent Milestones" << endl;
+         
+    for(idxType i = 0; i < iMSCount; i++) {
+        out << ' ' << ms(names, independentMS[i]);
+    }
+    
+    out << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findAPs() {
+    aps = new bool[milestoneCount]{};
+    
+    bool *visited = new bool[milestoneCount]{};
+    idxType *parent = new idxType[milestoneCount]{};
+    idxType *low = new idxType[milestoneCount]{};
+    idxType *discovered = new idxType[milestoneCount]{};
+
+    
+    for(idxType i = 0; i < milestoneCount; i++) {
+        aps[i] = false;
+        visited[i] = false;
+        parent[i] = NONE;
+        low[i] = 0;
+        discovered[i] = 0;
+    }
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        if(!visited[v]) {
+            findAPsHelper(v, visited, discovered, low, parent, aps);
+        }
+    }
+    
+    delete [] visited;
+    visited = nullptr;
+    
+    delete [] parent;
+    parent = nullptr;
+    
+    delete [] low;
+    low = nullptr;
+    
+    delete [] discovered;
+    discovered = nullptr;
+    
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findAPsHelper(idxType v, bool *visited, 
+                                                 idxType *disc, idxType *low, 
+                                                 idxType *parent, bool *aps) {
+    idxType children = 0;
+    idxType time = 0;
+    
+    visited[v] = true;
+    
+    disc[v] = low[v] = ++time;
+    
+    edgeCursor curr = edges(v);
+    idxType u = 0;
+        
+    while(curr.valid()) {            
+        u = curr.dest();
+        
+        if(!visited[u]) {
+            children++;
+            parent[u] = v;
+            
+            findAPsHelper(u, visited, disc, low, parent, aps);
+            
+            low[v] = std::min(low[v], low[u]);
+            
+            if(parent[v] == NONE && children > 1) {
+                aps[v] = true;
+            }
+            
+            if(parent[v] != NONE && low[u] >= disc[v]) {
+                aps[v] = true;
+            }
+        } else if(v != parent[v]) {
+            low[v] = std::min(low[v], disc[u]);
+        }
+        
+        curr.next();
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printAPs(std::ostream& out) {
+    using namespace std;
+    
+    out << "------------------------------------------------------------\n"
+         << "Articulation Points:\n";
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        if(aps[v]) {
+            out << ' ' << ms(names, v);
+        }
+    }
+    
+    out << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+namespace {
+    // nearest common ancestor of a and d in a dominator tree over places,
+    // where a parent's place is below its child's
+    template <class idxType>
+    idxType commonDominator(idxType a, idxType d, 
+                            const std::vector<idxType>& parent) {
+        // climb from whichever finger is later until they meet
+        while(a != d) {
+            while(a > d) {
+                a = parent[a];
+            }
+            
+            while(d > a) {
+                d = parent[d];
+            }
+        }
+        
+        return d;
+    }
+    
+    // one dominator tree, built over places in topological order from the
+    // successors' places of each place and stored by milestone; the
+    // post-dominator tree is the dominator tree of the reversed graph,
+    // over places counted from the back
+    template <class idxType>
+    struct dominatorPass {
+        const std::vector<idxType> *order;          // milestone at each place
+        const std::vector<std::size_t> *succStart;
+        const std::vector<idxType> *succ;           // successors' places
+        std::size_t first;                          // place of the root
+        bool reversed;                              // places from the back
+        std::vector<idxType> *treeParent;           // the tree by milestone
+        std::vector<idxType> *pre;
+        std::vector<idxType> *size;
+        
+        idxType milestone(std::size_t i) const {
+            return (*order)[reversed ? order->size() - 1 - i : i];
+        }
+        
+        void run() {
+            const idxType none = static_cast<idxType>(-1);
+            std::size_t n = order->size();
+            std::vector<idxType> parent(n, none);   // immediate dominator's
+                                                    // place
+            std::vector<idxType> next(n, 0);        // subtree size, then the
+                                                    // next free preorder #
+            idxType d = none;
+            idxType j = 0;
+            
+            parent[first] = static_cast<idxType>(first);
+            
+            // a place's predecessors all come before it, so pushing each
+            // reached place to its successors settles its immediate
+            // dominator before it is reached; places before the root can
+            // not be reached from it
+            for(std::size_t i = first; !reversed && i < n; i++) {
+                if(parent[i] == none) {
+                    continue;
+                }
+                
+                for(std::size_t e = (*succStart)[i]; 
+                    e < (*succStart)[i + 1]; e++) {
+                    j = (*succ)[e];
+                    parent[j] = (parent[j] == none) 
+                                ? static_cast<idxType>(i) 
+                                : commonDominator(parent[j], 
+                                                  static_cast<idxType>(i), 
+                                                  parent);
+                }
+            }
+            
+            // reversed, a place's successors come before it, so its
+            // immediate post-dominator is pulled from them
+            for(std::size_t r = first + 1; reversed && r < n; r++) {
+                std::size_t i = n - 1 - r;
+                
+                d = none;
+                
+                for(std::size_t e = (*succStart)[i]; 
+                    e < (*succStart)[i + 1]; e++) {
+                    j = static_cast<idxType>(n - 1 - (*succ)[e]);
+                    
+                    if(parent[j] != none) {
+                        d = (d == none) ? j : commonDominator(d, j, parent);
+                    }
+                }
+                
+                parent[r] = d;
+            }
+            
+            treeParent->assign(n, none);
+            pre->assign(n, none);
+            size->assign(n, 0);
+            
+            // children come after their parent, so a place's subtree is
+            // complete once the sweep reaches it
+            for(std::size_t i = n; i-- > first; ) {
+                if(parent[i] != none) {
+                    next[i]++;
+                    (*size)[milestone(i)] = next[i];
+                    
+                    if(i != first) {
+                        next[parent[i]] += next[i];
+                    }
+                }
+            }
+            
+            // each child takes the next free preorder block under its
+            // parent, milestones outside the tree keep parent and
+            // preorder -1
+            (*treeParent)[milestone(first)] = milestone(first);
+            (*pre)[milestone(first)] = 0;
+            next[first] = 1;
+            
+            for(std::size_t i = first + 1; i < n; i++) {
+                if(parent[i] != none) {
+                    d = milestone(i);
+                    (*treeParent)[d] = milestone(parent[i]);
+                    (*pre)[d] = next[parent[i]];
+                    next[parent[i]] += next[i];
+                    next[i] = (*pre)[d] + 1;
+                }
+            }
+        }
+    };
+}
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findDominators(int threads) {
+    using namespace std;
+    
+    size_t n = static_cast<size_t>(milestoneCount);
+    vector<idxType> order(n);
+    vector<idxType> pos(n);                 // place of each milestone
+    vector<size_t> succStart(n + 1);
+    vector<idxType> succ;
+    dominatorPass<idxType> dom;
+    dominatorPass<idxType> postDom;
+    edgeCursor curr;
+    
+    if(topoNodes == nullptr || dist == nullptr) {
+        return;
+    }
+    
+    for(size_t i = 0; i < n; i++) {
+        order[i] = (label != nullptr) ? static_cast<idxType>(i) 
+                                      : topoNodes[i];
+        pos[order[i]] = static_cast<idxType>(i);
+    }
+    
+    // the successors' places in one sweep over the task storage, every
+    // task, also those folded by contractChains()
+    succ.reserve(taskCount);
+    
+    for(size_t i = 0; i < n; i++) {
+        succStart[i] = succ.size();
+        
+        for(curr = edges(order[i], false); curr.valid(); curr.next()) {
+            succ.push_back(pos[curr.dest()]);
+        }
+    }
+    
+    succStart[n] = succ.size();
+    
+    dom.order = &order;
+    dom.succStart = &succStart;
+    dom.succ = &succ;
+    dom.first = pos[(label != nullptr) ? rank[sourceNode] : sourceNode];
+    dom.reversed = false;
+    dom.treeParent = &domParent;
+    dom.pre = &domPre;
+    dom.size = &domSize;
+    
+    postDom = dom;
+    postDom.first = n - 1 - pos[(label != nullptr) ? rank[finalNode] 
+                                                   : finalNode];
+    postDom.reversed = true;
+    postDom.treeParent = &pdomParent;
+    postDom.pre = &pdomPre;
+    postDom.size = &pdomSize;
+    
+    if(threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    
+    // the trees only share the successors, a second thread builds one
+    if(threads > 1) {
+        thread worker(&dominatorPass<idxType>::run, &postDom);
+        
+        dom.run();
+        worker.join();
+    } else {
+        dom.run();
+        postDom.run();
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+idxType ganttUtils<idxType, wgtType>::getDominator(idxType v) const {
+    idxType d = domParent.empty() ? NONE 
+                : domParent[(label != nullptr) ? rank[v] : v];
+    
+    return (d == NONE) ? NONE : original(d);
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+idxType ganttUtils<idxType, wgtType>::getPostDominator(idxType v) const {
+    idxType d = pdomParent.empty() ? NONE 
+                : pdomParent[(label != nullptr) ? rank[v] : v];
+    
+    return (d == NONE) ? NONE : original(d);
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::dominates(idxType a, idxType b) const {
+    if(domPre.empty()) {
+        return false;
+    }
+    
+    a = (label != nullptr) ? rank[a] : a;
+    b = (label != nullptr) ? rank[b] : b;
+    
+    return domPre[a] != NONE && domPre[b] != NONE 
+           && domPre[a] <= domPre[b] && domPre[b] - domPre[a] < domSize[a];
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::postDominates(idxType a, idxType b) const {
+    if(pdomPre.empty()) {
+        return false;
+    }
+    
+    a = (label != nullptr) ? rank[a] : a;
+    b = (label != nullptr) ? rank[b] : b;
+    
+    return pdomPre[a] != NONE && pdomPre[b] != NONE 
+           && pdomPre[a] <= pdomPre[b] 
+           && pdomPre[b] - pdomPre[a] < pdomSize[a];
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printDominators(std::ostream& out) {
+    using namespace std;
+    
+    vector<idxType> mustPass;
+    idxType v = (label != nullptr) ? rank[finalNode] : finalNode;
+    idxType source = (label != nullptr) ? rank[sourceNode] : sourceNode;
+    
+    // the final node's dominators, back to the source
+    if(!domParent.empty() && domParent[v] != NONE) {
+        for(; v != source; v = domParent[v]) {
+            mustPass.push_back(original(v));
+        }
+        
+        mustPass.push_back(sourceNode);
+    }
+    
+    out << "------------------------------------------------------------\n"
+        << "Dominators:\n"
+        << "   Must-Pass Milestones:";
+    
+    for(size_t i = mustPass.size(); i-- > 0; ) {
+        out << ' ' << ms(names, mustPass[i]);
+    }
+    
+    if(mustPass.empty()) {
+        out << " none, final milestone not reached from source";
+    }
+    
+    out << "\n   Reached from Source: " 
+        << (domSize.empty() ? 0 : domSize[source]) << "\n"
+        << "   Reaching Final Milestone: " 
+        << (pdomSize.empty() ? 0 : pdomSize[(label != nullptr) 
+                                            ? rank[finalNode] : finalNode]) 
+        << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::topoSort() {
+    topoNodes = new idxType[milestoneCount]{};
+    idxType topoCount = 0;
+    idxType next = 0;      // first vertex of topoNodes not yet visited
+    idxType *indegCopy = new idxType[milestoneCount]{};
+    idxType v = 0;
+    idxType u = 0;
+    edgeCursor curr;
+    
+    // topoNodes is its own queue: vertices are appended once their in-degree
+    // drops to 0 and visited in that order, the order a FIFO gives
+    for(idxType v = 0; v < milestoneCount; v++) {
+        indegCopy[v] = indeg[v];
+        
+        if(indegCopy[v] == 0) {
+            topoNodes[topoCount] = v;
+            topoCount++;
+        }
+    }
+    
+    while(next < topoCount) {
+        v = topoNodes[next];
+        next++;
+        
+        curr = edges(v);
+        
+        // decrease in-degree by 1 for all of vertex's neighbors
+        while(curr.valid()) {
+            u = curr.dest();
+            indegCopy[u]--;
+            
+            // if in-degree of neighbor is set to 0, append it
+            if(indegCopy[u] == 0) {
+                topoNodes[topoCount] = u;
+                topoCount++;
+            }
+            
+            curr.next();
+        }
+    }
+    
+    delete [] indegCopy;
+    indegCopy = nullptr;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::relabel() {
+    vertexNode *newList = nullptr;
+    edgeNode *curr = nullptr;
+    edgeNode *temp = nullptr;
+    edgeNode *tail = nullptr;
+    edgeArena<edgeNode> ordered;    // nodes in the new order
+    
+    // only once, and before any pass has used the old numbering
+    if(label != nullptr || topoNodes == nullptr || dist != nullptr 
+       || edgeBytes != nullptr) {
+        return;
+    }
+    
+    label = new idxType[milestoneCount];
+    rank = new idxType[milestoneCount];
+    
+    for(idxType i = 0; i < milestoneCount; i++) {
+        label[i] = topoNodes[i];
+        rank[topoNodes[i]] = i;
+    }
+    
+    // copy each list, in its original order, into a fresh arena so that the
+    // lists follow each other in memory
+    newList = new vertexNode[milestoneCount];
+    
+    for(idxType i = 0; i < milestoneCount; i++) {
+        newList[i].head = nullptr;
+        tail = nullptr;
+        
+        for(curr = adjList[label[i]].head; curr != nullptr; curr = curr->link) {
+            temp = ordered.allocate();
+            temp->dest = rank[curr->dest];
+            temp->weight = curr->weight;
+            temp->link = nullptr;
+            
+            if(tail == nullptr) {
+                newList[i].head = temp;
+            } else {
+                tail->link = temp;
+            }
+            
+            tail = temp;
+        }
+    }
+    
+    // the old nodes go back with ordered
+    listNodes.swap(ordered);
+    delete [] adjList;
+    adjList = newList;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+idxType ganttUtils<idxType, wgtType>::original(idxType v) const {
+    return (label != nullptr) ? label[v] : v;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::contractChains() {
+    edgeCursor curr;
+    edgeCursor link;
+    idxType x = 0;
+    idxType end = 0;
+    wgtType length = 0;
+    
+    // once, between the degree counts and the forward pass
+    if(chainEnd != nullptr || indeg == nullptr || outdeg == nullptr 
+       || dist != nullptr || !std::numeric_limits<wgtType>::is_integer) {
+        return;
+    }
+    
+    chainEnd = new idxType[milestoneCount];
+    chainLength = new wgtType[milestoneCount];
+    
+    // interior milestones: one task in, one task out
+    for(idxType v = 0; v < milestoneCount; v++) {
+        idxType m = original(v);
+        
+        chainEnd[v] = (indeg[m] == 1 && outdeg[m] == 1 && m != sourceNode) 
+                      ? v : NONE;
+        chainLength[v] = 0;
+    }
+    
+    // every chain starts with a task from a milestone that is not interior
+    for(idxType v = 0; v < milestoneCount; v++) {
+        if(chainEnd[v] != NONE) {
+            continue;
+        }
+        
+        for(curr = edges(v, false); curr.valid(); curr.next()) {
+            if(chainEnd[curr.dest()] == NONE) {
+                continue;
+            }
+            
+            length = 0;
+            
+            for(x = curr.dest(); chainEnd[x] != NONE; x = link.dest()) {
+                link = edges(x, false);
+                length += link.weight();
+            }
+            
+            end = x;
+            chainLength[curr.dest()] = length;
+            chainCount++;
+            
+            for(x = curr.dest(); x != end; x = link.dest()) {
+                link = edges(x, false);
+                chainEnd[x] = end;
+                foldedCount++;
+            }
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::expandChains() {
+    edgeCursor curr;
+    edgeCursor link;
+    idxType x = 0;
+    wgtType start = 0;
+    
+    // the same sums, in the same order, as a forward pass over every task
+    for(idxType v = 0; v < milestoneCount; v++) {
+        if(chainEnd[v] != NONE) {
+            continue;
+        }
+        
+        for(curr = edges(v, false); curr.valid(); curr.next()) {
+            start = dist[v] + curr.weight();
+            
+            for(x = curr.dest(); chainEnd[x] != NONE; x = link.dest()) {
+                dist[x] = start;
+                link = edges(x, false);
+                start = dist[x] + link.weight();
+            }
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printContraction(std::ostream& out) {
+    out << "------------------------------------------------------------\n"
+        << "Chain Contraction:\n"
+        << "   Chains Folded: " << chainCount << "\n"
+        << "   Milestones Folded: " << foldedCount << "\n"
+        << "   Milestones Walked: " << milestoneCount - foldedCount << "\n"
+        << "   Tasks Walked: " << taskCount - foldedCount << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printTopoSort(std::ostream& out) {
+    using namespace std;
+    
+    out << "------------------------------------------------------------\n"
+         << "Topological Sort: \n";
+    
+    for(idxType i = 0; i < milestoneCount; i++) {
+        out << ' ' << ms(names, topoNodes[i]);
+    }
+    
+    out << "\n\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::criticalPath() {
+    dist = new wgtType[milestoneCount]{};
+    idxType *indegCopy = new idxType[milestoneCount]{};
+    linkedQueue<idxType> critQ;
+    idxType v = 0;
+    idxType u = 0;
+    edgeCursor curr;
+    
+    crPath = new idxType[milestoneCount]{};
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        dist[v] = 0;
+        indegCopy[v] = indeg[v];
+        crPath[v] = NONE;
+        
+        if(indegCopy[v] == 0 && label == nullptr) {
+            critQ.addItem(v);
+        }
+    }
+    
+    // relabelled vertices are already in topological order
+    for(v = 0; label != nullptr && v < milestoneCount; v++) {
+        for(curr = edges(v); curr.valid(); curr.next()) {
+            dist[curr.dest()] = std::max(dist[curr.dest()], 
+                                        dist[v] + curr.weight());
+        }
+    }
+
+    while(!critQ.isEmptyQueue()) {
+        v = critQ.front();
+        critQ.deleteItem();
+        
+        curr = edges(v);
+        
+        while(curr.valid()) {
+            u = curr.dest();
+            
+            dist[u] = std::max(dist[u], dist[v] + curr.weight());
+            indegCopy[u]--;
+            
+            if(indegCopy[u] == 0) {
+                critQ.addItem(u);
+            }
+            
+            curr.next();
+        }
+    }
+    
+    if(chainEnd != nullptr) {
+        expandChains();
+    }
+
+    // find final task and project duration, the lowest numbered milestone
+    // on a tie
+    finalNode = sourceNode;
+    
+    for(v = 0; v < milestoneCount; v++) {
+        if(dist[v] > duration || (dist[v] == duration && duration > 0 
+                                  && original(v) < finalNode)) {
+            duration = dist[v];
+            finalNode = original(v);
+        }
+    }
+    
+    if(label != nullptr || chainEnd != nullptr) {
+        traceCriticalPath();
+        
+        delete [] indegCopy;
+        indegCopy = nullptr;
+        return;
+    }
+
+    // reconstruct critical path
+    crPath[crPathCount] = finalNode;
+    crPathCount++;
+
+    while(finalNode != sourceNode) {
+        for(v = 0, u = 0; v < milestoneCount; v++) {
+            curr = edges(v);
+            
+            while(curr.valid()) {
+                u = curr.dest();
+                
+                if(finalNode == u) {
+                    if(dist[finalNode] == dist[v] + curr.weight()) {
+                        crPath[crPathCount] = v;
+                        crPathCount++;
+                        finalNode = v;
+                    }
+                }
+                
+                curr.next();
+            }
+        }
+    }
+    
+    finalNode = crPath[0];
+
+    delete [] indegCopy;
+    indegCopy = nullptr;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::traceCriticalPath() {
+    std::vector<std::size_t> inStart(milestoneCount + 1, 0);
+    std::vector<idxType> inFrom;
+    std::vector<wgtType> inWeight;
+    edgeCursor curr;
+    idxType v = (label != nullptr) ? rank[finalNode] : finalNode;
+    idxType next = 0;
+    idxType wrapped = 0;
+    idxType last = 0;
+    bool sweeping = false;  // a predecessor was taken in the current sweep
+    bool haveNext = false;
+    bool haveWrapped = false;
+    
+    // in-edges grouped by destination
+    for(idxType u = 0; u < milestoneCount; u++) {
+        for(curr = edges(u, false); curr.valid(); curr.next()) {
+            inStart[curr.dest() + 1]++;
+        }
+    }
+    
+    for(idxType u = 0; u < milestoneCount; u++) {
+        inStart[u + 1] += inStart[u];
+    }
+    
+    inFrom.resize(inStart[milestoneCount]);
+    inWeight.resize(inStart[milestoneCount]);
+    std::vector<std::size_t> fill(inStart.begin(), inStart.end() - 1);
+    
+    for(idxType u = 0; u < milestoneCount; u++) {
+        for(curr = edges(u, false); curr.valid(); curr.next()) {
+            inFrom[fill[curr.dest()]] = u;
+            inWeight[fill[curr.dest()]++] = curr.weight();
+        }
+    }
+    
+    // the unrelabelled sweep visits milestones in original order, taking
+    // every tight task into the current one; so the next milestone is the
+    // lowest numbered tight predecessor after the last one taken, or the
+    // lowest overall once a new sweep starts
+    crPath[crPathCount] = finalNode;
+    crPathCount++;
+    
+    while(original(v) != sourceNode || sweeping) {
+        haveNext = false;
+        haveWrapped = false;
+        
+        for(std::size_t i = inStart[v]; i < inStart[v + 1]; i++) {
+            if(dist[v] == dist[inFrom[i]] + inWeight[i]) {
+                idxType p = original(inFrom[i]);
+                
+                if((!sweeping || p > last) 
+                   && (!haveNext || p < original(next))) {
+                    next = inFrom[i];
+                    haveNext = true;
+                }
+                
+                if(!haveWrapped || p < original(wrapped)) {
+                    wrapped = inFrom[i];
+                    haveWrapped = true;
+                }
+            }
+        }
+        
+        // end of a sweep, stop if the source has been reached
+        if(!haveNext) {
+            if(original(v) == sourceNode || !haveWrapped) {
+                break;
+            }
+            
+            next = wrapped;
+        }
+        
+        v = next;
+        last = original(v);
+        sweeping = true;
+        crPath[crPathCount] = last;
+        crPathCount++;
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printCriticalPath(std::ostream& out) {
+    using namespace std;
+    
+    out << "------------------------------------------------------------\n"
+         << "Critical Path:\n"
+         << "   Source Node: " << ms(names, sourceNode) << endl
+         << "   Final Task: " << ms(names, finalNode) << endl
+         << "   Total Duration: " << duration << endl << endl
+         << "Critical Path: \n";
+    
+    for(idxType v = crPathCount; v-- > 0; ) {
+        out << ' ' << ms(names, crPath[v]);
+    }
+    
+    out << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findDependencyStats() {
+    highID = indeg[1];
+    lowID = indeg[1];
+    highOD = outdeg[0];
+    lowOD = outdeg[0];
+    
+    // find highest and lowest ID and OD
+    for(idxType v = 0; v < milestoneCount; v++) {
+        if(v != sourceNode) {
+            if(indeg[v] > highID) {
+                highID = indeg[v];
+            } else if(indeg[v] < lowID) {
+                lowID = indeg[v];
+            }
+        }
+        
+        if(v != finalNode) {
+            if(outdeg[v] > highOD) {
+                highOD = outdeg[v];
+            } else if(outdeg[v] < lowOD) {
+                lowOD = outdeg[v];
+            }
+        }
+    }
+    
+    // find # of MS with highest and lowest ID and OD
+    for(idxType v = 0; v < milestoneCount; v++) {
+        if(v != sourceNode) {
+            if(indeg[v] == highID) {
+                highIDCount++;
+            } else if(indeg[v] == lowID) {
+                lowIDCount++;
+            }
+        }
+        
+        if(v != finalNode) {
+            if(outdeg[v] == highOD) {
+                highODCount++;
+            } else if(outdeg[v] == lowOD) {
+                lowODCount++;
+            }
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printDependencyStats(std::ostream& out) {
+    using namespace std;
+    
+    out << "------------------------------------------------------------\n"
+         << "Dependency Statistics (in-degree):\n"
+         << "   Highest In-Degree: " << highID << endl
+         << "   Lowest In-Degree: " << lowID << endl
+         << "   Count of Highest Degree: " << highIDCount << endl
+         << "   Count of Lowest Degree: " << lowIDCount << endl << endl
+         << "Dependency Statistics (out-degree):\n"
+         << "   Highest Out-Degree: " << highOD << endl
+         << "   Lowest Out-Degree: " << lowOD << endl
+         << "   Count of Highest Degree: " << highODCount << endl
+         << "   Count of Lowest Degree: " << lowODCount << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findSlackTimes() {
+    slackTimes = new wgtType[milestoneCount]{};
+    
+    for(idxType i = 0; i < milestoneCount; i++) {
+        slackTimes[i] = -1;
+    }
+    
+    for(idxType i = 0; i < crPathCount; i++) {
+        slackTimes[crPath[i]] = 0;
+    }
+    
+    edgeCursor curr;
+    
+    for(idxType u = 0; u < milestoneCount; u++) {
+        if(slackTimes[original(u)] == -1) {
+            curr = edges(u, false);
+            
+            while(curr.valid()) {
+                slackTimes[original(u)] = dist[curr.dest()] 
+                                          - (dist[u] + curr.weight());
+                
+                curr.next();
+            }
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printSlackTimes(std::ostream& out) {
+    using namespace std;
+    
+    out << "------------------------------------------------------------\n"
+         << "Slack Times (task-slacktime):\n";
+    
+    for(idxType i = 0; i < milestoneCount && slackTimes[i] != -1; i++) {
+        if(slackTimes[i] != 0) {
+            out << ' ' << ms(names, i) << '-' << slackTimes[i];
+        }
+    }
+    
+    out << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findTailDistances() {
+    tailDist = new wgtType[milestoneCount]{};
+    edgeCursor curr;
+    idxType v = 0;
+    
+    // sinks keep 0, every other milestone takes its longest outgoing path
+    for(idxType i = milestoneCount; i-- > 0; ) {
+        v = (label != nullptr) ? i : topoNodes[i];
+        curr = edges(v);
+        
+        while(curr.valid()) {
+            tailDist[v] = std::max(tailDist[v], 
+                                   curr.weight() + tailDist[curr.dest()]);
+            curr.next();
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+namespace {
+    // partial path waiting in the best-first heap
+    template <class idxType, class wgtType>
+    struct pathEntry {
+        wgtType bound;     // length of the best path through this prefix
+        wgtType length;    // length of the prefix
+        idxType vertex;    // last milestone of the prefix
+        idxType via;       // first milestone of the folded chain it ends
+                           // with, if any
+        long parent;       // expanded prefix it extends, -1 for a source
+        
+        bool operator<(const pathEntry& other) const {
+            return bound < other.bound;
+        }
+    };
+    
+    template <class entryType>
+    bool higherBound(const entryType& a, const entryType& b) {
+        return a.bound > b.bound;
+    }
+}
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findNearCriticalPaths(wgtType margin, 
+                                                         int maxPaths) {
+    using namespace std;
+    
+    typedef pathEntry<idxType, wgtType> entry;
+    
+    vector<entry> heap;              // partial paths, max-heap on bound
+    vector<idxType> expandedVertex;  // expanded prefixes as parent-linked 
+    vector<long> expandedParent;     // lists
+    entry top;
+    entry next;
+    edgeCursor curr;
+    idxType key = 0;
+    int found = 0;
+    long p = 0;
+    long expansion = 0;
+    vector<long> stamp(milestoneCount, -1);    // expansion that saw a dest
+    vector<wgtType> best(milestoneCount, 0);   // longest task to that dest
+    
+    findTailDistances();
+    nearLimit = duration - margin;
+    
+    ncPaths.clear();
+    ncPathStart.clear();
+    ncPathLength.clear();
+    
+    // every source with a path long enough starts a prefix
+    for(idxType i = 0; i < milestoneCount; i++) {
+        idxType v = (label != nullptr) ? rank[i] : i;
+        
+        if(indeg[i] == 0 && edges(v).valid() 
+           && tailDist[v] >= nearLimit) {
+            top.bound = tailDist[v];
+            top.length = 0;
+            top.vertex = v;
+            top.via = NONE;
+            top.parent = -1;
+            heap.push_back(top);
+        }
+    }
+    
+    make_heap(heap.begin(), heap.end());
+    
+    while(!heap.empty() && found < maxPaths) {
+        pop_heap(heap.begin(), heap.end());
+        top = heap.back();
+        heap.pop_back();
+        
+        // the milestones of a folded chain, in order
+        for(idxType c = top.via; c != NONE && c != top.vertex; 
+            c = edges(c, false).dest()) {
+            expandedVertex.push_back(c);
+            expandedParent.push_back(top.parent);
+            top.parent = static_cast<long>(expandedVertex.size()) - 1;
+        }
+        
+        expandedVertex.push_back(top.vertex);
+        expandedParent.push_back(top.parent);
+        curr = edges(top.vertex);
+        
+        // a sink completes a path, bounds are exact so paths come out
+        // longest first
+        if(!curr.valid()) {
+            ncPathStart.push_back(ncPaths.size());
+            ncPathLength.push_back(top.length);
+            
+            for(p = static_cast<long>(expandedVertex.size()) - 1; p != -1;
+                p = expandedParent[p]) {
+                ncPaths.push_back(original(expandedVertex[p]));
+            }
+            
+            reverse(ncPaths.begin() + ncPathStart.back(), ncPaths.end());
+            found++;
+            continue;
+        }
+        
+        // parallel tasks to the same milestone give the same milestone
+        // sequence, only the longest of them is followed (a folded chain
+        // is told apart by its first milestone)
+        expansion++;
+        
+        for(curr = edges(top.vertex); curr.valid(); 
+            curr.next()) {
+            key = (curr.via() != NONE) ? curr.via() : curr.dest();
+            
+            if(stamp[key] != expansion || curr.weight() > best[key]) {
+                stamp[key] = expansion;
+                best[key] = curr.weight();
+            }
+        }
+        
+        // extend by every task that can still reach the limit
+        for(curr = edges(top.vertex); curr.valid(); 
+            curr.next()) {
+            key = (curr.via() != NONE) ? curr.via() : curr.dest();
+            next.length = top.length + curr.weight();
+            next.bound = next.length + tailDist[curr.dest()];
+            
+            if(stamp[key] == expansion && curr.weight() == best[key]
+               && next.bound >= nearLimit) {
+                stamp[key] = -1;
+                next.vertex = curr.dest();
+                next.via = curr.via();
+                next.parent = static_cast<long>(expandedVertex.size()) - 1;
+                heap.push_back(next);
+                push_heap(heap.begin(), heap.end());
+            }
+        }
+        
+        // each entry completes at least one path of its own bound, so only
+        // the best (maxPaths - found) entries can still be reported
+        size_t keep = static_cast<size_t>(maxPaths - found);
+        
+        if(heap.size() > 2 * keep) {
+            nth_element(heap.begin(), heap.begin() + keep, heap.end(),
+                        higherBound<entry>);
+            heap.resize(keep);
+            make_heap(heap.begin(), heap.end());
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printNearCriticalPaths(std::ostream& out) {
+    using namespace std;
+    
+    size_t count = ncPathStart.size();
+    size_t end = 0;
+    
+    out << "------------------------------------------------------------\n"
+        << "Near-Critical Paths:\n"
+        << "   Total Duration: " << duration << endl
+        << "   Minimum Length: " << nearLimit << endl
+        << "   Paths Found: " << count << endl << endl
+        << "Length (shortfall): milestones\n";
+    
+    for(size_t i = 0; i < count; i++) {
+        end = (i + 1 < count) ? ncPathStart[i + 1] : ncPaths.size();
+        
+        out << setw(6) << ncPathLength[i] 
+            << " (" << duration - ncPathLength[i] << "):";
+        
+        for(size_t j = ncPathStart[i]; j < end; j++) {
+            out << ' ' << ms(names, ncPaths[j]);
+        }
+        
+        out << endl;
+    }
+    
+    out << "\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findDeliverables() {
+    using namespace std;
+    
+    // deliverables sharing a sweep, a cache line of tail distances per
+    // milestone
+    const size_t lanes = max<size_t>(CACHE_LINE / sizeof(wgtType), 1);
+    const wgtType unreached = numeric_limits<wgtType>::lowest();
+    
+    vector<wgtType> tail;   // longest distance to the deliverable of each
+                            // lane, by milestone and lane
+    vector<wgtType> finish(lanes);      // duration of each lane's
+    vector<idxType> critical(lanes);    // deliverable, its # of critical
+    vector<idxType> start(lanes);       // milestones and path start
+    edgeCursor curr;
+    idxType v = 0;
+    idxType next = NONE;
+    idxType sink = 0;
+    size_t active = 0;
+    
+    dlvNodes.clear();
+    dlvDuration.clear();
+    dlvCritical.clear();
+    dlvPaths.clear();
+    dlvPathStart.clear();
+    
+    for(idxType i = 0; i < milestoneCount; i++) {
+        if(outdeg[i] == 0) {
+            dlvNodes.push_back(i);
+        }
+    }
+    
+    for(size_t first = 0; first < dlvNodes.size(); first += lanes) {
+        active = min(lanes, dlvNodes.size() - first);
+        tail.assign(static_cast<size_t>(milestoneCount) * lanes, unreached);
+        
+        for(size_t l = 0; l < active; l++) {
+            sink = (label != nullptr) ? rank[dlvNodes[first + l]] 
+                                      : dlvNodes[first + l];
+            tail[sink * lanes + l] = 0;
+        }
+        
+        // one backward pass for every lane, each task read once
+        for(idxType i = milestoneCount; i-- > 0; ) {
+            v = (label != nullptr) ? i : topoNodes[i];
+            wgtType *to = &tail[v * lanes];
+            
+            for(curr = edges(v, false); curr.valid(); curr.next()) {
+                const wgtType *from = &tail[curr.dest() * lanes];
+                wgtType weight = curr.weight();
+                
+                // branch free, so the lanes are updated in vector
+                // registers
+                for(size_t l = 0; l < lanes; l++) {
+                    wgtType through = (from[l] != unreached) 
+                                      ? from[l] + weight : unreached;
+                    
+                    to[l] = max(to[l], through);
+                }
+            }
+        }
+        
+        for(size_t l = 0; l < active; l++) {
+            sink = (label != nullptr) ? rank[dlvNodes[first + l]] 
+                                      : dlvNodes[first + l];
+            finish[l] = dist[sink];
+            critical[l] = 0;
+            start[l] = NONE;
+        }
+        
+        // critical if the longest paths to and from it fill the
+        // deliverable's duration; a path starts at the milestone with no
+        // tasks in that is furthest from the deliverable (lowest numbered
+        // on a tie), which is exact for double weights too
+        for(idxType u = 0; u < milestoneCount; u++) {
+            const wgtType *row = &tail[u * lanes];
+            bool source = (indeg[original(u)] == 0);
+            
+            for(size_t l = 0; l < active; l++) {
+                if(row[l] == unreached) {
+                    continue;
+                }
+                
+                if(dist[u] + row[l] == finish[l]) {
+                    critical[l]++;
+                }
+                
+                if(source && (start[l] == NONE 
+                              || row[l] > tail[start[l] * lanes + l]
+                              || (row[l] == tail[start[l] * lanes + l]
+                                  && original(u) < original(start[l])))) {
+                    start[l] = u;
+                }
+            }
+        }
+        
+        for(size_t l = 0; l < active; l++) {
+            sink = (label != nullptr) ? rank[dlvNodes[first + l]] 
+                                      : dlvNodes[first + l];
+            v = start[l];
+            dlvDuration.push_back(finish[l]);
+            dlvCritical.push_back(critical[l]);
+            dlvPathStart.push_back(dlvPaths.size());
+            
+            // follow the lowest numbered task that stays critical
+            while(v != NONE) {
+                dlvPaths.push_back(original(v));
+                next = NONE;
+                
+                for(curr = edges(v, false); v != sink && curr.valid(); 
+                    curr.next()) {
+                    wgtType rest = tail[curr.dest() * lanes + l];
+                    
+                    if(rest != unreached 
+                       && curr.weight() + rest == tail[v * lanes + l]
+                       && (next == NONE 
+                           || original(curr.dest()) < original(next))) {
+                        next = curr.dest();
+                    }
+                }
+                
+                v = next;
+            }
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printDeliverables(std::ostream& out) {
+    using namespace std;
+    
+    size_t count = dlvNodes.size();
+    size_t end = 0;
+    
+    out << "------------------------------------------------------------\n"
+        << "Deliverables:\n"
+        << "   Deliverables: " << count << endl
+        << "   Super-Sink Duration: " << duration << endl
+        << "   Final Deliverable: " << ms(names, finalNode) << endl << endl
+        << "Deliverable (duration, critical milestones): critical path\n";
+    
+    for(size_t i = 0; i < count; i++) {
+        end = (i + 1 < count) ? dlvPathStart[i + 1] : dlvPaths.size();
+        
+        out << ms(names, dlvNodes[i], 6) << " (" << dlvDuration[i] << ", " 
+            << dlvCritical[i] << "):";
+        
+        for(size_t j = dlvPathStart[i]; j < end; j++) {
+            out << ' ' << ms(names, dlvPaths[j]);
+        }
+        
+        out << endl;
+    }
+    
+    out << "\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findConcurrency(int threads) {
+    using namespace std;
+    
+    typedef typename weightTraits<wgtType>::raw raw;
+    
+    vector<uint64_t> starts;
+    vector<uint64_t> ends;
+    vector<uint64_t> scratch;
+    edgeCursor curr;
+    size_t i = 0;
+    size_t j = 0;
+    size_t n = 0;
+    long long running = 0;
+    uint64_t now = 0;
+    uint64_t next = 0;
+    
+    starts.reserve(taskCount);
+    ends.reserve(taskCount);
+    taskTime = 0;
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        for(curr = edges(v, false); curr.valid(); curr.next()) {
+            starts.push_back(sortKey(static_cast<raw>(dist[v])));
+            ends.push_back(sortKey(static_cast<raw>(dist[v] + curr.weight())));
+            taskTime += curr.weight();
+        }
+    }
+    
+    n = starts.size();
+    scratch.resize(n);
+    parallelRadixSort(starts.data(), scratch.data(), n, threads);
+    parallelRadixSort(ends.data(), scratch.data(), n, threads);
+    
+    peakTasks = 0;
+    peakStart = 0;
+    concurrencyTime.assign(1, 0);
+    
+    // keys sort like times; at each event time apply every end and start,
+    // the count then holds until the next event time
+    while(i < n || j < n) {
+        now = (i < n && starts[i] < ends[j]) ? starts[i] : ends[j];
+        
+        while(j < n && ends[j] == now) {
+            running--;
+            j++;
+        }
+        
+        while(i < n && starts[i] == now) {
+            running++;
+            i++;
+        }
+        
+        if(j == n) {
+            break;
+        }
+        
+        next = (i < n && starts[i] < ends[j]) ? starts[i] : ends[j];
+        
+        if(running <= 0) {
+            continue;
+        }
+        
+        if(static_cast<size_t>(running) > peakTasks) {
+            peakTasks = static_cast<size_t>(running);
+            peakStart = fromKey<wgtType>(now, raw());
+        }
+        
+        if(static_cast<size_t>(running) >= concurrencyTime.size()) {
+            concurrencyTime.resize(running + 1, 0);
+        }
+        
+        concurrencyTime[running] += fromKey<wgtType>(next, raw()) 
+                                    - fromKey<wgtType>(now, raw());
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printConcurrency(std::ostream& out) {
+    using namespace std;
+    
+    const size_t ROWS = 20;     // histogram rows, at most
+    size_t levels = concurrencyTime.size();
+    size_t step = (levels + ROWS - 1) / ROWS;
+    wgtType time = 0;
+    
+    out << "------------------------------------------------------------\n"
+        << "Concurrency Profile:\n"
+        << "   Peak Concurrent Tasks: " << peakTasks << endl
+        << "   Peak Start: " << peakStart << endl
+        << "   Average Concurrent Tasks: " << setprecision(3) 
+        << (duration > 0 ? static_cast<double>(taskTime) / duration : 0.0) 
+        << setprecision(6) << endl << endl
+        << "Tasks Running    Time\n";
+    
+    // one row per level, or per range of levels for a large peak
+    for(size_t k = 1; k < levels; k += step) {
+        time = 0;
+        
+        for(size_t l = k; l < k + step && l < levels; l++) {
+            time += concurrencyTime[l];
+        }
+        
+        if(step == 1) {
+            out << setw(13) << k;
+        } else {
+            out << setw(6) << k << " - " 
+                << setw(4) << min(k + step, levels) - 1;
+        }
+        
+        out << "    " << time << endl;
+    }
+    
+    out << "\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+namespace {
+    const std::size_t TOP_RANGE = 1 << 16;  // fewest milestones per thread
+    
+    // section titles, by topMetric
+    const char *const TOP_TITLES[] = { 
+        "Least Float (milestone-float)", 
+        "Highest In-Degree (milestone-indegree)", 
+        "Highest Out-Degree (milestone-outdegree)", 
+        "Latest Early Start (milestone-start)", 
+        "Longest Tasks (from>to-weight)" };
+    
+    // milestone or task being ranked
+    template <class idxType, class keyType>
+    struct topCandidate {
+        keyType key;
+        idxType from;
+        idxType to;
+    };
+    
+    // a ranks before b by key, then by lower milestone and destination, so
+    // the result does not depend on how the milestones were shared out
+    template <class candidateType>
+    struct topOrder {
+        bool ascending;
+        
+        bool operator()(const candidateType& a, const candidateType& b) const {
+            if(a.key != b.key) {
+                return ascending ? a.key < b.key : a.key > b.key;
+            }
+            
+            return (a.from != b.from) ? a.from < b.from : a.to < b.to;
+        }
+    };
+}
+
+template <class idxType, class wgtType>
+template <class heapType>
+void ganttUtils<idxType, wgtType>::rankRange(topMetric metric, idxType lo, 
+                                             idxType hi, 
+                                             heapType *heap) const {
+    topCandidate<idxType, typename weightTraits<wgtType>::raw> item;
+    edgeCursor curr;
+    
+    for(idxType v = lo; v < hi; v++) {
+        item.from = original(v);
+        item.to = item.from;
+        
+        switch(metric) {
+        case TOP_SLACK:
+            if(slackTimes[item.from] == -1) {
+                continue;
+            }
+            
+            item.key = slackTimes[item.from];
+            break;
+        case TOP_FAN_IN:
+            item.key = indeg[item.from];
+            break;
+        case TOP_FAN_OUT:
+            item.key = outdeg[item.from];
+            break;
+        case TOP_START:
+            item.key = dist[v];
+            break;
+        case TOP_TASK:
+            for(curr = edges(v, false); curr.valid(); curr.next()) {
+                item.key = curr.weight();
+                item.to = original(curr.dest());
+                heap->push(item);
+            }
+            
+            continue;
+        }
+        
+        heap->push(item);
+    }
+}
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::findTop(const topQuery& query, 
+                                           int threads) {
+    using namespace std;
+    
+    typedef topCandidate<idxType, typename weightTraits<wgtType>::raw> 
+            candidate;
+    typedef topOrder<candidate> order;
+    typedef boundedHeap<candidate, order> heap;
+    
+    order ranking = { query.metric == TOP_SLACK };
+    vector<heap> heaps;
+    vector<thread> workers;
+    vector<candidate> top;
+    topList result;
+    size_t count = static_cast<size_t>(milestoneCount);
+    size_t step = 0;
+    
+    if(slackTimes == nullptr) {
+        return;
+    }
+    
+    if(threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    
+    // no more threads than ranges worth one
+    threads = static_cast<int>(max(static_cast<size_t>(1), 
+                                   min(static_cast<size_t>(threads), 
+                                       count / TOP_RANGE)));
+    step = (count + threads - 1) / threads;
+    heaps.assign(threads, heap(query.k, ranking));
+    
+    for(int t = 0; t < threads; t++) {
+        workers.push_back(thread(&ganttUtils::template rankRange<heap>, this, 
+                                 query.metric, 
+                                 static_cast<idxType>(min(count, t * step)), 
+                                 static_cast<idxType>(min(count, 
+                                                          (t + 1) * step)), 
+                                 &heaps[t]));
+    }
+    
+    for(size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    
+    mergeTop(heaps, query.k, ranking, top);
+    result.query = query;
+    result.entries.resize(top.size());
+    
+    for(size_t i = 0; i < top.size(); i++) {
+        result.entries[i].from = top[i].from;
+        result.entries[i].to = top[i].to;
+        result.entries[i].value = static_cast<wgtType>(top[i].key);
+    }
+    
+    topLists.push_back(result);
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printTop(std::ostream& out) {
+    for(std::size_t l = 0; l < topLists.size(); l++) {
+        const topList& list = topLists[l];
+        
+        out << "------------------------------------------------------------\n"
+            << "Top " << list.entries.size() << ' ' 
+            << TOP_TITLES[list.query.metric] << ":\n";
+        
+        for(std::size_t i = 0; i < list.entries.size(); i++) {
+            out << ' ' << ms(names, list.entries[i].from);
+            
+            if(list.query.metric == TOP_TASK) {
+                out << '>' << ms(names, list.entries[i].to);
+            }
+            
+            out << '-' << list.entries[i].value;
         }
+        
+        out << "\n\n";
     }
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::printGraphInformation() {
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::writeTop(const std::string fileName) const {
     using namespace std;
     
-    cout << "------------------------------------------------------------\n"
-         << fixed
-         << "Graph Information\n"
-         << "   Project title: " << title << endl
-         << "   Milestone Count: " << milestoneCount << endl
-         << "   Task Count: " << taskCount << endl
-         << "   Source Milestone: " << sourceNode << endl
-         << "   Tasks/Milestones Ratio: " << tasksMSRatio << endl
-         << "   Project Tasks Density: " << tasksDensity << endl << endl
-         << "   Key Milestone: " << keyMS 
-         << ", in-degree: " << indeg[keyMS] << " tasks\n"
-         << "   Node Point: " << nodePoint
-         << ", out-degree: " << outdeg[nodePoint] << " tasks\n" 
-         << "   Independent Milestones" << endl;
-         
-    for(int i = 0; i < iMSCount; i++) {
-        cout << ' ' << independentMS[i];
+    ofstream outFile(fileName);
+    
+    if(!outFile) {
+        return false;
+    }
+    
+    outFile << "metric,rank,milestone,to,value\n";
+    
+    for(size_t l = 0; l < topLists.size(); l++) {
+        const topList& list = topLists[l];
+        
+        for(size_t i = 0; i < list.entries.size(); i++) {
+            outFile << TOP_NAMES[list.query.metric] << ',' << i + 1 << ',' 
+                    << ms(names, list.entries[i].from) << ',';
+            
+            if(list.query.metric == TOP_TASK) {
+                outFile << ms(names, list.entries[i].to);
+            }
+            
+            outFile << ',' << list.entries[i].value << '\n';
+        }
     }
     
-    cout << "\n\n";
+    return static_cast<bool>(outFile);
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::findAPs() {
-    aps = new bool[milestoneCount]{};
+namespace {
+    const std::size_t DIFF_RANGE = 1 << 14;  // fewest milestones per thread
+}
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::diffRange(const ganttUtils *base, 
+                                             idxType lo, idxType hi, 
+                                             scheduleDiff *part) const {
+    using namespace std;
     
-    bool *visited = new bool[milestoneCount]{};
-    int *parent = new int[milestoneCount]{};
-    int *low = new int[milestoneCount]{};
-    int *discovered = new int[milestoneCount]{};
+    typedef pair<idxType, wgtType> task;
+    
+    vector<task> before;   // destination and weight, sorted
+    vector<task> after;
+    taskChange change;
+    edgeCursor curr;
+    wgtType move = 0;
+    size_t i = 0;
+    size_t j = 0;
+    
+    for(idxType v = lo; v < hi; v++) {
+        before.clear();
+        after.clear();
+        
+        for(curr = (v < base->milestoneCount) ? base->edges(v, false) 
+                                              : edgeCursor(); 
+            curr.valid(); curr.next()) {
+            before.push_back(task(curr.dest(), curr.weight()));
+        }
+        
+        for(curr = (v < milestoneCount) ? edges(v, false) : edgeCursor(); 
+            curr.valid(); curr.next()) {
+            after.push_back(task(curr.dest(), curr.weight()));
+        }
+        
+        sort(before.begin(), before.end());
+        sort(after.begin(), after.end());
+        
+        // tasks to the same milestone are paired in weight order
+        change.from = v;
+        i = 0;
+        j = 0;
+        
+        while(i < before.size() || j < after.size()) {
+            change.before = 0;
+            change.after = 0;
+            
+            if(j == after.size() 
+               || (i < before.size() && before[i].first < after[j].first)) {
+                change.to = before[i].first;
+                change.before = before[i++].second;
+                change.kind = '-';
+                part->removed++;
+            } else if(i == before.size() || after[j].first < before[i].first) {
+                change.to = after[j].first;
+                change.after = after[j++].second;
+                change.kind = '+';
+                part->added++;
+            } else if(before[i].second != after[j].second) {
+                change.to = after[j].first;
+                change.before = before[i++].second;
+                change.after = after[j++].second;
+                change.kind = '~';
+                part->reweighted++;
+            } else {
+                i++;
+                j++;
+                continue;
+            }
+            
+            part->changes.push_back(change);
+        }
+        
+        if(v >= milestoneCount || v >= base->milestoneCount) {
+            continue;
+        }
+        
+        move = dist[v] - base->dist[v];
+        
+        if(move != 0) {
+            part->moved++;
+            
+            if((move < 0 ? -move : move) > (part->largestMove < 0 
+                                            ? -part->largestMove 
+                                            : part->largestMove)) {
+                part->largestMove = move;
+                part->largestAt = v;
+            }
+        }
+        
+        if(slackTimes[v] != base->slackTimes[v]) {
+            part->slackChanged++;
+        }
+    }
+}
 
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::compareWith(const ganttUtils& base, 
+                                               int threads) {
+    using namespace std;
     
-    for(int i = 0; i < milestoneCount; i++) {
-        aps[i] = false;
-        visited[i] = false;
-        parent[i] = -1;
-        low[i] = 0;
-        discovered[i] = 0;
+    vector<scheduleDiff> parts;
+    vector<thread> workers;
+    idxType count = max(milestoneCount, base.milestoneCount);
+    vector<char> onPath(count, 0);    // 1 old path, 2 new path, 3 both
+    size_t step = 0;
+    
+    if(slackTimes == nullptr || base.slackTimes == nullptr 
+       || label != nullptr || base.label != nullptr) {
+        return;
     }
     
-    for(int v = 0; v < milestoneCount; v++) {
-        if(!visited[v]) {
-            findAPsHelper(v, visited, discovered, low, parent, aps);
+    if(threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    
+    // no more threads than ranges worth one
+    threads = static_cast<int>(max(static_cast<size_t>(1), 
+                                   min(static_cast<size_t>(threads), 
+                                       static_cast<size_t>(count) 
+                                       / DIFF_RANGE)));
+    step = (static_cast<size_t>(count) + threads - 1) / threads;
+    parts.resize(threads);
+    
+    for(int t = 0; t < threads; t++) {
+        workers.push_back(thread(&ganttUtils::diffRange, this, &base, 
+                                 static_cast<idxType>(min(
+                                     static_cast<size_t>(count), t * step)), 
+                                 static_cast<idxType>(min(
+                                     static_cast<size_t>(count), 
+                                     (t + 1) * step)), 
+                                 &parts[t]));
+    }
+    
+    for(size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    
+    diff = scheduleDiff();
+    diff.milestones = base.milestoneCount;
+    diff.tasks = base.taskCount;
+    diff.duration = base.duration;
+    
+    for(size_t t = 0; t < parts.size(); t++) {
+        const scheduleDiff& part = parts[t];
+        
+        diff.changes.insert(diff.changes.end(), part.changes.begin(), 
+                            part.changes.end());
+        diff.added += part.added;
+        diff.removed += part.removed;
+        diff.reweighted += part.reweighted;
+        diff.moved += part.moved;
+        diff.slackChanged += part.slackChanged;
+        
+        if((part.largestMove < 0 ? -part.largestMove : part.largestMove) 
+           > (diff.largestMove < 0 ? -diff.largestMove : diff.largestMove)) {
+            diff.largestMove = part.largestMove;
+            diff.largestAt = part.largestAt;
         }
     }
     
-    delete [] visited;
-    visited = nullptr;
+    for(idxType i = 0; i < base.crPathCount; i++) {
+        onPath[base.crPath[i]] |= 1;
+    }
     
-    delete [] parent;
-    parent = nullptr;
+    for(idxType i = 0; i < crPathCount; i++) {
+        onPath[crPath[i]] |= 2;
+    }
     
-    delete [] low;
-    low = nullptr;
+    for(idxType v = 0; v < count; v++) {
+        if(onPath[v] == 2) {
+            diff.joined.push_back(v);
+        } else if(onPath[v] == 1) {
+            diff.left.push_back(v);
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printDiff(std::ostream& out) {
+    using namespace std;
+    
+    out << "------------------------------------------------------------\n"
+        << "Schedule Changes (old -> new):\n"
+        << "   Milestones: " << diff.milestones << " -> " 
+        << milestoneCount << endl
+        << "   Tasks: " << diff.tasks << " -> " << taskCount << endl
+        << "   Tasks Added: " << diff.added << endl
+        << "   Tasks Removed: " << diff.removed << endl
+        << "   Tasks Re-weighted: " << diff.reweighted << endl
+        << "   Total Duration: " << diff.duration << " -> " << duration 
+        << endl
+        << "   Early Starts Moved: " << diff.moved;
+    
+    if(diff.moved > 0) {
+        out << " (most " << diff.largestMove << " at " << diff.largestAt 
+            << ')';
+    }
+    
+    out << endl << "   Slack Times Changed: " << diff.slackChanged << "\n\n"
+        << "Critical Path Joined:";
+    
+    for(size_t i = 0; i < diff.joined.size(); i++) {
+        out << ' ' << diff.joined[i];
+    }
+    
+    out << "\nCritical Path Left:";
+    
+    for(size_t i = 0; i < diff.left.size(); i++) {
+        out << ' ' << diff.left[i];
+    }
+    
+    out << "\n\nTask Changes (from>to old -> new):\n";
+    
+    for(size_t i = 0; i < diff.changes.size(); i++) {
+        const taskChange& change = diff.changes[i];
+        
+        out << "   " << change.kind << ' ' << change.from << '>' 
+            << change.to << ' ';
+        
+        if(change.kind != '+') {
+            out << change.before;
+        }
+        
+        if(change.kind == '~') {
+            out << " -> ";
+        }
+        
+        if(change.kind != '-') {
+            out << change.after;
+        }
+        
+        out << endl;
+    }
+    
+    out << "\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::scheduleCalendar(
+                                    const calendarSet& calendarList, 
+                                    long start) {
+    using namespace std;
+    
+    idxType u = 0;
+    long day = 0;
+    edgeCursor curr;
+    
+    if(topoNodes == nullptr || !numeric_limits<wgtType>::is_integer) {
+        return false;
+    }
+    
+    calendars = nullptr;
+    startDay = start;
+    finishDay = start;
+    msCalendar.resize(milestoneCount);
+    earlyDate.assign(milestoneCount, start);
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        msCalendar[v] = calendarList.calendarOf(original(v));
+    }
+    
+    // forward pass over every task, also those folded by contractChains()
+    for(idxType i = 0; i < milestoneCount; i++) {
+        u = (label != nullptr) ? i : topoNodes[i];
+        const workCalendar& cal = calendarList.getCalendar(msCalendar[u]);
+        
+        for(curr = edges(u, false); curr.valid(); curr.next()) {
+            day = cal.addWork(earlyDate[u], static_cast<long>(curr.weight()));
+            
+            if(day == workCalendar::NO_DAY) {
+                return false;
+            }
+            
+            earlyDate[curr.dest()] = max(earlyDate[curr.dest()], day);
+            finishDay = max(finishDay, day);
+        }
+    }
+    
+    // backward pass, sinks start (and finish) on the finish date
+    lateDate.assign(milestoneCount, finishDay);
+    
+    for(idxType i = milestoneCount; i-- > 0; ) {
+        u = (label != nullptr) ? i : topoNodes[i];
+        const workCalendar& cal = calendarList.getCalendar(msCalendar[u]);
+        
+        for(curr = edges(u, false); curr.valid(); curr.next()) {
+            day = cal.subtractWork(lateDate[curr.dest()], 
+                                   static_cast<long>(curr.weight()));
+            
+            if(day == workCalendar::NO_DAY) {
+                return false;
+            }
+            
+            lateDate[u] = min(lateDate[u], day);
+        }
+    }
+    
+    calendars = &calendarList;
+    
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printSchedule(std::ostream& out) {
+    using namespace std;
+    
+    idxType v = 0;
+    size_t critical = 0;
+    
+    if(calendars == nullptr) {
+        return;
+    }
+    
+    // float in working days of the milestone's own calendar
+    for(idxType u = 0; u < milestoneCount; u++) {
+        const workCalendar& cal = calendars->getCalendar(msCalendar[u]);
+        
+        if(cal.rank(lateDate[u]) == cal.rank(earlyDate[u])) {
+            critical++;
+        }
+    }
+    
+    out << "------------------------------------------------------------\n"
+        << "Calendar Schedule:\n"
+        << "   Calendars: " << calendars->size() << endl
+        << "   Start Date: " << formatDate(startDay) << endl
+        << "   Finish Date: " << formatDate(finishDay) << endl
+        << "   Working Days: " 
+        << calendars->getCalendar(0).rank(finishDay) 
+           - calendars->getCalendar(0).rank(startDay) 
+        << " (" << calendars->getCalendar(0).getName() << ")" << endl
+        << "   Milestones with no Float: " << critical << endl << endl
+        << "Critical Path Dates:\n";
+    
+    for(idxType i = crPathCount; i-- > 0; ) {
+        v = (label != nullptr) ? rank[crPath[i]] : crPath[i];
+        
+        out << "   " << ms(names, crPath[i], 10) << "   " 
+            << formatDate(earlyDate[v]) << "   " 
+            << calendars->getCalendar(msCalendar[v]).getName() << endl;
+    }
+    
+    out << "\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::writeSchedule(
+                                    const std::string fileName) const {
+    using namespace std;
+    
+    ofstream outFile(fileName);
+    idxType u = 0;
+    
+    if(!outFile || calendars == nullptr) {
+        return false;
+    }
+    
+    outFile << "milestone,calendar,early start,late start,float\n";
+    
+    for(idxType v = 0; v < milestoneCount; v++) {
+        u = (label != nullptr) ? rank[v] : v;
+        const workCalendar& cal = calendars->getCalendar(msCalendar[u]);
+        
+        outFile << ms(names, v) << ',' << cal.getName() << ',' 
+                << formatDate(earlyDate[u]) << ',' 
+                << formatDate(lateDate[u]) << ',' 
+                << cal.rank(lateDate[u]) - cal.rank(earlyDate[u]) << '\n';
+    }
+    
+    return static_cast<bool>(outFile);
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::readCrashCosts(const std::string fileName) {
+    using namespace std;
+    
+    typedef pair<unsigned long long, unsigned long long> taskKey;
+    
+    ifstream inFile(fileName);
+    string line;
+    string extra;
+    vector<pair<taskKey, size_t> > byKey;
+    unsigned long long from = 0;
+    unsigned long long to = 0;
+    long long minimum = 0;
+    long long cost = 0;
+    bool valid = false;
+    idxType u = 0;
+    edgeCursor curr;
+    
+    if(!inFile || topoNodes == nullptr) {
+        return false;
+    }
+    
+    // every task, also those folded by contractChains()
+    crashTasks.clear();
+    
+    for(idxType i = 0; i < milestoneCount; i++) {
+        u = (label != nullptr) ? i : topoNodes[i];
+        
+        for(curr = edges(u, false); curr.valid(); curr.next()) {
+            int64_t w = static_cast<int64_t>(curr.weight());
+            crashTask task = { u, curr.dest(), w, w, w, 0 };
+            
+            byKey.push_back(make_pair(taskKey(original(u), 
+                                              original(curr.dest())), 
+                                      crashTasks.size()));
+            crashTasks.push_back(task);
+        }
+    }
+    
+    sort(byKey.begin(), byKey.end());
+    
+    while(getline(inFile, line)) {
+        istringstream fields(line.substr(0, line.find('#')));
+        size_t k = 0;
+        
+        if(!(fields >> from)) {
+            continue;
+        }
+        
+        if(!(fields >> to >> minimum >> cost) || (fields >> extra) 
+           || cost < 0) {
+            return false;
+        }
+        
+        k = lower_bound(byKey.begin(), byKey.end(), 
+                        make_pair(taskKey(from, to), size_t(0))) 
+            - byKey.begin();
+        
+        if(k == byKey.size() || byKey[k].first != taskKey(from, to)) {
+            return false;
+        }
+        
+        // repeated tasks are crashed alike, none below its minimum
+        valid = false;
+        
+        for(; k < byKey.size() && byKey[k].first == taskKey(from, to); k++) {
+            crashTask& task = crashTasks[byKey[k].second];
+            
+            valid = valid || minimum <= task.normal;
+            task.minimum = min(static_cast<int64_t>(minimum), task.normal);
+            task.cost = cost;
+        }
+        
+        if(!valid) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+int64_t ganttUtils<idxType, wgtType>::crashForward(
+                                        int64_t step, 
+                                        const std::vector<int>& direction,
+                                        std::vector<int64_t>& start,
+                                        std::vector<std::size_t>& pred) const {
+    int64_t finish = 0;
+    int64_t d = 0;
+    
+    start.assign(milestoneCount, 0);
+    pred.assign(milestoneCount, NO_TASK);
+    
+    // tasks are in topological order of their source
+    for(std::size_t e = 0; e < crashTasks.size(); e++) {
+        const crashTask& task = crashTasks[e];
+        
+        d = task.duration + (direction.empty() ? 0 : step * direction[e]);
+        
+        if(start[task.from] + d > start[task.to]) {
+            start[task.to] = start[task.from] + d;
+            pred[task.to] = e;
+        }
+    }
     
-    delete [] discovered;
-    discovered = nullptr;
+    for(idxType v = 0; v < milestoneCount; v++) {
+        finish = std::max(finish, start[v]);
+    }
     
+    return finish;
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::findAPsHelper(int v, bool *visited, int *disc, 
-                               int *low, int *parent, bool *aps) {
-    int children = 0;
-    int time = 0;
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::crashProject(wgtType reduceBy) {
+    using namespace std;
     
-    visited[v] = true;
+    const int64_t INFINITE = maxFlow::INFINITE;
+    vector<int64_t> start;
+    vector<int64_t> trial;
+    vector<int64_t> tail(milestoneCount);
+    vector<size_t> pred;
+    vector<size_t> node(milestoneCount);
+    vector<char> entered;
+    vector<char> left;
+    vector<int> direction(crashTasks.size(), 0);
+    vector<int> none;
+    maxFlow network;
+    int64_t finish = crashForward(0, none, start, pred);
+    int64_t target = 0;
+    int64_t step = 0;
+    int64_t rate = 0;
+    int64_t lastRate = -1;
+    int64_t cost = 0;
+    int64_t length = 0;
+    int64_t net = 0;
+    size_t nodes = 0;
+    bool giveBack = true;
+    bool stuck = false;
+    idxType v = 0;
     
-    disc[v] = low[v] = ++time;
+    crashGoal = static_cast<int64_t>(reduceBy);
+    target = finish - crashGoal;
+    curveDuration.assign(1, finish);
+    curveCost.assign(1, 0);
     
-    listNode *curr = adjList[v].head;
-    int u = 0;
+    while(!stuck && (crashGoal == 0 || finish > target)) {
+        // critical tasks: on a longest path from a start to an end
+        fill(tail.begin(), tail.end(), 0);
+        
+        for(size_t e = crashTasks.size(); e-- > 0; ) {
+            const crashTask& task = crashTasks[e];
+            
+            tail[task.from] = max(tail[task.from], 
+                                  task.duration + tail[task.to]);
+        }
         
-    while(curr != nullptr) {            
-        u = curr->dest;
+        nodes = 0;
         
-        if(!visited[u]) {
-            children++;
-            parent[u] = v;
+        for(v = 0; v < milestoneCount; v++) {
+            node[v] = (start[v] + tail[v] == finish) ? nodes++ : NO_TASK;
+        }
+        
+        network.reset(nodes + 2);
+        entered.assign(nodes, 0);
+        left.assign(nodes, 0);
+        
+        for(size_t e = 0; e < crashTasks.size(); e++) {
+            const crashTask& task = crashTasks[e];
             
-            findAPsHelper(u, visited, disc, low, parent, aps);
+            if(node[task.from] != NO_TASK && node[task.to] != NO_TASK
+               && start[task.from] + task.duration + tail[task.to] == finish) {
+                network.addArc(node[task.from], node[task.to],
+                               (task.duration > task.minimum) ? task.cost 
+                               : INFINITE,
+                               (task.duration < task.normal) ? task.cost : 0);
+                left[node[task.from]] = 1;
+                entered[node[task.to]] = 1;
+            }
+        }
+        
+        for(size_t c = 0; c < nodes; c++) {
+            if(!entered[c]) {
+                network.addArc(nodes, c, INFINITE);
+            }
             
-            low[v] = std::min(low[v], low[u]);
+            if(!left[c]) {
+                network.addArc(c, nodes + 1, INFINITE);
+            }
+        }
+        
+        rate = network.solve(nodes, nodes + 1);
+        
+        if(rate < 0 || rate >= INFINITE) {
+            break;
+        }
+        
+        // shorten the cut's forward tasks, give back its backward ones, as
+        // far as the tasks allow and no other path outgrows the duration
+        giveBack = true;
+        
+        for(bool found = false; !found && !stuck; ) {
+            rate = 0;
+            step = (crashGoal > 0) ? finish - target : INFINITE;
             
-            if(parent[v] == -1 && children > 1) {
-                aps[v] = true;
+            for(size_t e = 0; e < crashTasks.size(); e++) {
+                const crashTask& task = crashTasks[e];
+                bool critical = node[task.from] != NO_TASK 
+                                && node[task.to] != NO_TASK
+                                && start[task.from] + task.duration 
+                                   + tail[task.to] == finish;
+                bool fromSide = critical 
+                                && network.sourceSide(node[task.from]);
+                bool toSide = critical && network.sourceSide(node[task.to]);
+                
+                direction[e] = 0;
+                
+                if(fromSide && !toSide) {
+                    direction[e] = -1;
+                    rate += task.cost;
+                    step = min(step, task.duration - task.minimum);
+                } else if(critical && !fromSide && toSide && giveBack
+                          && task.duration < task.normal) {
+                    direction[e] = 1;
+                    rate -= task.cost;
+                    step = min(step, task.normal - task.duration);
+                }
             }
             
-            if(parent[v] != -1 && low[u] >= disc[v]) {
-                aps[v] = true;
+            while(!found && step > 0) {
+                if(crashForward(step, direction, trial, pred) 
+                   <= finish - step) {
+                    found = true;
+                    break;
+                }
+                
+                // the longest path meets the duration at a shorter step
+                v = static_cast<idxType>(max_element(trial.begin(), 
+                                                     trial.end()) 
+                                         - trial.begin());
+                length = 0;
+                net = 0;
+                
+                for(size_t e = pred[v]; e != NO_TASK; 
+                    e = pred[crashTasks[e].from]) {
+                    length += crashTasks[e].duration;
+                    net -= direction[e];
+                }
+                
+                step = (finish - length) / (1 - net);
             }
-        } else if(v != parent[v]) {
-            low[v] = std::min(low[v], disc[u]);
+            
+            // giving tasks back may block any step, then only shorten
+            if(!found) {
+                stuck = !giveBack;
+                giveBack = false;
+            }
+        }
+        
+        if(stuck) {
+            break;
+        }
+        
+        for(size_t e = 0; e < crashTasks.size(); e++) {
+            crashTasks[e].duration += step * direction[e];
+        }
+        
+        finish -= step;
+        cost += rate * step;
+        start.swap(trial);
+        
+        // a step at the same cost per unit extends the last segment
+        if(rate == lastRate) {
+            curveDuration.back() = finish;
+            curveCost.back() = cost;
+        } else {
+            curveDuration.push_back(finish);
+            curveCost.push_back(cost);
         }
         
-        curr = curr->link;
+        lastRate = rate;
     }
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::printAPs() {
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printCrashing(std::ostream& out) {
     using namespace std;
     
-    cout << "------------------------------------------------------------\n"
-         << "Articulation Points:\n";
+    size_t last = 0;
+    size_t crashed = 0;
     
-    for(int v = 0; v < milestoneCount; v++) {
-        if(aps[v]) {
-            cout << ' ' << v;
-        }
+    if(curveDuration.empty()) {
+        return;
     }
     
-    cout << "\n\n";
-}
-
-/// ----------------------------------------------------------------------------
-
-void ganttUtils::topoSort() {
-    topoNodes = new int[milestoneCount]{};
-    int topoCount = 0;
-    linkedQueue<int> topoQ;
-    int *indegCopy = new int[milestoneCount]{};
-    int v = 0;
-    int u = 0;
-    listNode *curr = nullptr;
+    last = curveDuration.size() - 1;
     
-    // add vertices with in-degree of 0 to queue
-    for(int v = 0; v < milestoneCount; v++) {
-        topoNodes[v] = 0;
-        indegCopy[v] = indeg[v];
-        
-        if(indegCopy[v] == 0) {
-            topoQ.addItem(v);
-        }
+    out << "------------------------------------------------------------\n"
+        << "Crashing:\n"
+        << "   Normal Duration: " << curveDuration[0] << endl
+        << "   Crashed Duration: " << curveDuration[last];
+    
+    if(crashGoal > 0 && curveDuration[0] - curveDuration[last] < crashGoal) {
+        out << " (short by " 
+            << crashGoal - (curveDuration[0] - curveDuration[last]) 
+            << " of the " << crashGoal << " units)";
     }
     
-    while(!topoQ.isEmptyQueue()) {
-        v = topoQ.front();
-        topoQ.deleteItem();
+    out << "\n   Crash Cost: " << curveCost[last] << "\n\n"
+        << "Time-Cost Curve:\n"
+        << "   Duration        Cost   Cost/Unit\n";
+    
+    for(size_t i = 0; i <= last; i++) {
+        out << setw(11) << curveDuration[i] << setw(12) << curveCost[i];
         
-        if(indegCopy[v] == 0) {
-            topoNodes[topoCount] = v;
-            topoCount++;
+        if(i > 0) {
+            out << setw(12) << (curveCost[i] - curveCost[i - 1]) 
+                               / (curveDuration[i - 1] - curveDuration[i]);
         }
         
-        curr = adjList[v].head;
+        out << endl;
+    }
+    
+    for(size_t e = 0; e < crashTasks.size(); e++) {
+        crashed += (crashTasks[e].duration < crashTasks[e].normal) ? 1 : 0;
+    }
+    
+    out << "\nTasks Crashed: " << crashed << endl;
+    
+    for(size_t e = 0; e < crashTasks.size(); e++) {
+        const crashTask& task = crashTasks[e];
         
-        // decrease in-degree by 1 for all of vertex's neighbors
-        while(curr != nullptr) {
-            u = curr->dest;
-            indegCopy[u]--;
-            
-            // if in-degree of neighbor is set to 0, add it to queue
-            if(indegCopy[u] == 0) {
-                topoQ.addItem(u);
-            }
-            
-            curr = curr->link;
+        if(task.duration < task.normal) {
+            out << "   " << ms(names, original(task.from), 10) << " ->" 
+                << ms(names, original(task.to), 10) << "   " 
+                << setw(8) << task.normal << " ->" << setw(8) 
+                << task.duration << "   cost " 
+                << (task.normal - task.duration) * task.cost << endl;
         }
     }
     
-    delete [] indegCopy;
-    indegCopy = nullptr;
+    out << "\n";
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::printTopoSort() {
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::readResources(const std::string fileName) {
     using namespace std;
     
-    cout << "------------------------------------------------------------\n"
-         << "Topological Sort: \n";
+    typedef pair<unsigned long long, unsigned long long> taskKey;
+    typedef pair<size_t, size_t> demandKey;     // task and resource
+    
+    ifstream inFile(fileName);
+    string line;
+    vector<pair<taskKey, size_t> > byKey;
+    vector<pair<demandKey, int64_t> > listed;   // units of each demand
+    unsigned long long from = 0;
+    unsigned long long to = 0;
+    unsigned long long resource = 0;
+    long long units = 0;
+    char *end = nullptr;
+    size_t k = 0;
+    edgeCursor curr;
     
-    for(int i = 0; i < milestoneCount; i++) {
-        cout << ' ' << topoNodes[i];
+    if(!inFile) {
+        return false;
     }
     
-    cout << "\n\n\n";
-}
-
-/// ----------------------------------------------------------------------------
-
-void ganttUtils::criticalPath() {
-    dist = new int[milestoneCount]{};
-    int *indegCopy = new int[milestoneCount]{};
-    linkedQueue<int> critQ;
-    int v = 0;
-    int u = 0;
-    listNode *curr = nullptr;
+    rcTasks.clear();
+    rcDemands.clear();
+    rcCapacity.clear();
+    
+    // every task, also those folded by contractChains()
+    for(idxType u = 0; u < milestoneCount; u++) {
+        for(curr = edges(u, false); curr.valid(); curr.next()) {
+            resourceTask task = { u, curr.dest(), 
+                                  static_cast<int64_t>(curr.weight()), 
+                                  -1, 0, 0 };
+            
+            byKey.push_back(make_pair(taskKey(original(u), 
+                                              original(curr.dest())), 
+                                      rcTasks.size()));
+            rcTasks.push_back(task);
+        }
+    }
     
-    crPath = new int[milestoneCount]{};
+    sort(byKey.begin(), byKey.end());
     
-    for(int v = 0; v < milestoneCount; v++) {
-        dist[v] = 0;
-        indegCopy[v] = indeg[v];
-        crPath[v] = -1;
+    while(getline(inFile, line)) {
+        line.resize(min(line.size(), line.find('#')));
         
-        if(indegCopy[v] == 0) {
-            critQ.addItem(v);
+        const char *p = line.c_str();
+        size_t length = nextToken(p);
+        
+        if(length == 0) {
+            continue;
+        }
+        
+        // the capacities come first
+        if(rcCapacity.empty()) {
+            if(line.compare(p - length - line.c_str(), length, 
+                            "resources") != 0) {
+                return false;
+            }
+            
+            while((length = nextToken(p)) > 0) {
+                units = strtoll(p - length, &end, 10);
+                
+                if(end != p || units < 0) {
+                    return false;
+                }
+                
+                rcCapacity.push_back(units);
+            }
+            
+            if(rcCapacity.empty()) {
+                return false;
+            }
+            
+            continue;
+        }
+        
+        from = strtoull(p - length, &end, 10);
+        
+        if(end != p || (length = nextToken(p)) == 0) {
+            return false;
+        }
+        
+        to = strtoull(p - length, &end, 10);
+        
+        if(end != p) {
+            return false;
         }
-    }
-
-    while(!critQ.isEmptyQueue()) {
-        v = critQ.front();
-        critQ.deleteItem();
         
-        curr = adjList[v].head;
+        k = lower_bound(byKey.begin(), byKey.end(), 
+                        make_pair(taskKey(from, to), size_t(0))) 
+            - byKey.begin();
         
-        while(curr != nullptr) {
-            u = curr->dest;
+        if(k == byKey.size() || byKey[k].first != taskKey(from, to)) {
+            return false;
+        }
+        
+        // "<resource>:<units>"
+        while((length = nextToken(p)) > 0) {
+            resource = strtoull(p - length, &end, 10);
             
-            dist[u] = std::max(dist[u], dist[v] + curr->weight);
-            indegCopy[u]--;
+            if(end == p - length || *end != ':' 
+               || resource >= rcCapacity.size()) {
+                return false;
+            }
             
-            if(indegCopy[u] == 0) {
-                critQ.addItem(u);
+            units = strtoll(end + 1, &end, 10);
+            
+            if(end != p || units < 0) {
+                return false;
             }
             
-            curr = curr->link;
+            for(size_t j = k; j < byKey.size() 
+                              && byKey[j].first == taskKey(from, to); j++) {
+                listed.push_back(make_pair(demandKey(byKey[j].second, 
+                                                     resource), 
+                                           units));
+            }
         }
     }
-
-    // find final task and project duration
-    finalNode = sourceNode;
     
-    for(v = 0; v < milestoneCount; v++) {
-        if(dist[v] > duration) {
-            duration = dist[v];
-            finalNode = v;
-        }
+    if(rcCapacity.empty()) {
+        return false;
     }
-
-    // reconstruct critical path
-    crPath[crPathCount] = finalNode;
-    crPathCount++;
-
-    while(finalNode != sourceNode) {
-        for(v = 0, u = 0; v < milestoneCount; v++) {
-            curr = adjList[v].head;
-            
-            while(curr != nullptr) {
-                u = curr->dest;
-                
-                if(finalNode == u) {
-                    if(dist[finalNode] == dist[v] + curr->weight) {
-                        crPath[crPathCount] = v;
-                        crPathCount++;
-                        finalNode = v;
-                    }
-                }
-                
-                curr = curr->link;
-            }
+    
+    // demands of a task on one resource add up, and must fit its capacity
+    sort(listed.begin(), listed.end());
+    
+    for(size_t i = 0; i < listed.size(); i++) {
+        resourceTask& task = rcTasks[listed[i].first.first];
+        resourceDemand need = { listed[i].first.second, listed[i].second };
+        
+        if(task.demands == 0) {
+            task.demand = rcDemands.size();
+        }
+        
+        if(task.demands > 0 && rcDemands.back().resource == need.resource) {
+            rcDemands.back().units += need.units;
+        } else {
+            rcDemands.push_back(need);
+            task.demands++;
+        }
+        
+        if(rcDemands.back().units > rcCapacity[need.resource]) {
+            return false;
         }
     }
     
-    finalNode = crPath[0];
-
-    delete [] indegCopy;
-    indegCopy = nullptr;
+    return true;
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::printCriticalPath() {
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::scheduleResources(priorityRule rule) {
     using namespace std;
     
-    cout << "------------------------------------------------------------\n"
-         << "Critical Path:\n"
-         << "   Source Node: " << sourceNode << endl
-         << "   Final Task: " << finalNode << endl
-         << "   Total Duration: " << duration << endl << endl
-         << "Critical Path: \n";
+    vector<int64_t> tail(milestoneCount, 0);    // longest path to the end
+    vector<int64_t> ready(milestoneCount, 0);   // finish of the tasks in
+    vector<idxType> waiting(milestoneCount, 0); // tasks in not scheduled
+    vector<size_t> first(milestoneCount + 1, 0);    // first task out
+    vector<idxType> released;   // milestones whose tasks became eligible
+    vector<resourceProfile> profiles;
+    indexedHeap<int64_t> eligible(rcTasks.size());
+    int64_t finish = static_cast<int64_t>(duration);
+    int64_t start = 0;
+    int64_t fit = 0;
+    idxType v = 0;
+    
+    rcRule = rule;
+    rcDuration = 0;
+    rcDelayed = 0;
     
-    for(int v = crPathCount - 1; v >= 0; v--) {
-        cout << ' ' << crPath[v];
+    for(size_t r = 0; r < rcCapacity.size(); r++) {
+        profiles.push_back(resourceProfile(rcCapacity[r]));
     }
     
-    cout << "\n\n";
-}
-
-/// ----------------------------------------------------------------------------
-
-void ganttUtils::findDependencyStats() {
-    highID = indeg[1];
-    lowID = indeg[1];
-    highOD = outdeg[0];
-    lowOD = outdeg[0];
+    // the tasks are stored by source milestone
+    for(size_t e = 0; e < rcTasks.size(); e++) {
+        first[rcTasks[e].from + 1]++;
+        waiting[rcTasks[e].to]++;
+    }
     
-    // find highest and lowest ID and OD
-    for(int v = 0; v < milestoneCount; v++) {
-        if(v != sourceNode) {
-            if(indeg[v] > highID) {
-                highID = indeg[v];
-            } else if(indeg[v] < lowID) {
-                lowID = indeg[v];
-            }
+    for(idxType u = 0; u < milestoneCount; u++) {
+        first[u + 1] += first[u];
+        
+        if(waiting[u] == 0) {
+            released.push_back(u);
         }
+    }
+    
+    // backward pass over every task, for the total float and path rules
+    for(idxType i = milestoneCount; i-- > 0; ) {
+        v = (label != nullptr) ? i : topoNodes[i];
         
-        if(v != finalNode) {
-            if(outdeg[v] > highOD) {
-                highOD = outdeg[v];
-            } else if(outdeg[v] < lowOD) {
-                lowOD = outdeg[v];
-            }
+        for(size_t e = first[v]; e < first[v + 1]; e++) {
+            tail[v] = max(tail[v], rcTasks[e].duration 
+                                   + tail[rcTasks[e].to]);
         }
     }
     
-    // find # of MS with highest and lowest ID and OD
-    for(int v = 0; v < milestoneCount; v++) {
-        if(v != sourceNode) {
-            if(indeg[v] == highID) {
-                highIDCount++;
-            } else if(indeg[v] == lowID) {
-                lowIDCount++;
+    while(!released.empty() || !eligible.empty()) {
+        while(!released.empty()) {
+            v = released.back();
+            released.pop_back();
+            
+            for(size_t e = first[v]; e < first[v + 1]; e++) {
+                const resourceTask& task = rcTasks[e];
+                int64_t path = task.duration + tail[task.to];
+                
+                if(rule == PRIORITY_SLACK) {
+                    eligible.push(e, finish - path 
+                                     - static_cast<int64_t>(dist[v]));
+                } else {
+                    eligible.push(e, -path);
+                }
             }
         }
         
-        if(v != finalNode) {
-            if(outdeg[v] == highOD) {
-                highODCount++;
-            } else if(outdeg[v] == lowOD) {
-                lowODCount++;
+        if(eligible.empty()) {
+            break;
+        }
+        
+        resourceTask& task = rcTasks[eligible.pop()];
+        start = ready[task.from];
+        
+        // move on until every resource the task needs has room at once
+        for(size_t d = task.demand; d < task.demand + task.demands; ) {
+            const resourceDemand& need = rcDemands[d];
+            
+            fit = profiles[need.resource].earliestFit(start, task.duration,
+                                                      need.units);
+            
+            if(fit != start) {
+                start = fit;
+                d = task.demand;
+            } else {
+                d++;
             }
         }
+        
+        for(size_t d = task.demand; d < task.demand + task.demands; d++) {
+            profiles[rcDemands[d].resource].reserve(start, task.duration,
+                                                    rcDemands[d].units);
+        }
+        
+        task.start = start;
+        rcDelayed += (start > static_cast<int64_t>(dist[task.from])) ? 1 : 0;
+        ready[task.to] = max(ready[task.to], start + task.duration);
+        rcDuration = max(rcDuration, start + task.duration);
+        
+        if(--waiting[task.to] == 0) {
+            released.push_back(task.to);
+        }
     }
-}
-
-/// ----------------------------------------------------------------------------
-
-void ganttUtils::printDependencyStats() {
-    using namespace std;
     
-    cout << "------------------------------------------------------------\n"
-         << "Dependency Statistics (in-degree):\n"
-         << "   Highest In-Degree: " << highID << endl
-         << "   Lowest In-Degree: " << lowID << endl
-         << "   Count of Highest Degree: " << highIDCount << endl
-         << "   Count of Lowest Degree: " << lowIDCount << endl << endl
-         << "Dependency Statistics (out-degree):\n"
-         << "   Highest Out-Degree: " << highOD << endl
-         << "   Lowest Out-Degree: " << lowOD << endl
-         << "   Count of Highest Degree: " << highODCount << endl
-         << "   Count of Lowest Degree: " << lowODCount << "\n\n";
+    rcPeak.clear();
+    
+    for(size_t r = 0; r < profiles.size(); r++) {
+        rcPeak.push_back(profiles[r].getPeak());
+    }
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::findSlackTimes() {
-    slackTimes = new int[milestoneCount]{};
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printResources(std::ostream& out) {
+    using namespace std;
     
-    for(int i = 0; i < milestoneCount; i++) {
-        slackTimes[i] = -1;
-    }
+    out << "------------------------------------------------------------\n"
+        << "Resource-Constrained Schedule:\n"
+        << "   Priority Rule: " 
+        << ((rcRule == PRIORITY_SLACK) ? "least slack" : "longest path") 
+        << endl
+        << "   Resources: " << rcCapacity.size() << endl
+        << "   Unconstrained Duration: " << duration << endl
+        << "   Constrained Duration: " << rcDuration << endl
+        << "   Tasks Delayed: " << rcDelayed << " of " << rcTasks.size() 
+        << endl << endl
+        << "Resource    Capacity        Peak\n";
     
-    for(int i = 0; i < crPathCount; i++) {
-        slackTimes[crPath[i]] = 0;
+    for(size_t r = 0; r < rcCapacity.size(); r++) {
+        out << setw(8) << r << setw(12) << rcCapacity[r] 
+            << setw(12) << rcPeak[r] << endl;
     }
     
-    listNode *curr = nullptr;
-    
-    for(int u = 0; u < milestoneCount; u++) {
-        if(slackTimes[u] == -1) {
-            curr = adjList[u].head;
-            
-            while(curr != nullptr) {
-                slackTimes[u] = dist[curr->dest] - (dist[u] + curr->weight);
-                
-                curr = curr->link;
-            }
-        }
-    }
+    out << "\n";
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::printSlackTimes() {
+template <class idxType, class wgtType>
+bool ganttUtils<idxType, wgtType>::writeResources(
+                                    const std::string fileName) const {
     using namespace std;
     
-    cout << "------------------------------------------------------------\n"
-         << "Slack Times (task-slacktime):\n";
+    ofstream outFile(fileName);
     
-    for(int i = 0; i < milestoneCount && slackTimes[i] != -1; i++) {
-        if(slackTimes[i] != 0) {
-            cout << ' ' << i << '-' << slackTimes[i];
-        }
+    if(!outFile) {
+        return false;
+    }
+    
+    outFile << "from,to,duration,early start,start,finish\n";
+    
+    for(size_t e = 0; e < rcTasks.size(); e++) {
+        const resourceTask& task = rcTasks[e];
+        
+        outFile << ms(names, original(task.from)) << ',' 
+                << ms(names, original(task.to)) << ',' << task.duration 
+                << ',' << dist[task.from] << ',' << task.start << ','
+                << task.start + task.duration << '\n';
     }
     
-    cout << "\n\n";
+    return static_cast<bool>(outFile);
 }
 
 /// ----------------------------------------------------------------------------
 
-void ganttUtils::printGraph() {
+template <class idxType, class wgtType>
+void ganttUtils<idxType, wgtType>::printGraph(std::ostream& out) {
     using namespace std;
     
-    listNode *curr = nullptr;
+    edgeCursor curr;
     
-    cout << "------------------------------------------------------------\n"
+    out << "------------------------------------------------------------\n"
          << "Graph Adjacency List:\n   Title: " << title << endl << endl
          << "Vertex    vrt /weight | vrt /weight | vrt /weight | ...\n"
          << "------    ----------------------------------------------\n";
          
-    for(int v = 0; v < milestoneCount; v++) {
-        curr = adjList[v].head;
+    for(idxType v = 0; v < milestoneCount; v++) {
+        curr = edges((label != nullptr) ? rank[v] : v, false);
         
-        cout << setw(6) << v << " -> ";
+        out << ms(names, v, 6) << " -> ";
         
-        if(curr == nullptr) { 
-            cout << "   None";
+        if(!curr.valid()) { 
+            out << "   None";
         } else {
-            while(curr != nullptr) {
-                cout << setw(4) << curr->dest 
-                     << '/' << setw(6) << curr->weight 
+            while(curr.valid()) {
+                out << ms(names, original(curr.dest()), 4)
+                     << '/' << setw(6) << curr.weight() 
                      << " | ";
                 
-                curr = curr->link;
+                curr.next();
             }
         }
         
-        cout << endl;
+        out << endl;
     }
     
-    cout << endl;
+    out << endl;
 }
 
 /// ----------------------------------------------------------------------------
+
+// the six layouts readLayout() can choose
+template class ganttUtils<uint32_t, int32_t>;
+template class ganttUtils<uint32_t, int64_t>;
+template class ganttUtils<uint32_t, double>;
+template class ganttUtils<uint64_t, int32_t>;
+template class ganttUtils<uint64_t, int64_t>;
+template class ganttUtils<uint64_t, double>;
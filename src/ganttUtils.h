@@ -6,57 +6,405 @@
 #ifndef H_GANTTUTILS
 #define H_GANTTUTILS
 
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
 #include <string>
+#include <vector>
 
+#include "edgeArena.h"
+
+class idInterner;
+class calendarSet;
+
+/// ----------------------------------------------------------------------------
+/// @brief Schedule metrics ranked by "--top <metric>:<k>", the metric named
+/// as in the comments.
+/// ----------------------------------------------------------------------------
+enum topMetric {
+    TOP_SLACK,              /// least float first ("slack")
+    TOP_FAN_IN,             /// highest in-degree first ("fan-in")
+    TOP_FAN_OUT,            /// highest out-degree first ("fan-out")
+    TOP_START,              /// latest early start first ("start")
+    TOP_TASK                /// longest task first ("task")
+};
+
+struct topQuery {
+    topMetric metric;       /// ranked metric
+    std::size_t k;          /// # of milestones or tasks reported
+};
+
+/// ----------------------------------------------------------------------------
+/// @brief Priority rules of the resource-constrained schedule, picking the
+/// next eligible task ("--priority <rule>", the rule named as in the
+/// comments).
+/// ----------------------------------------------------------------------------
+enum priorityRule {
+    PRIORITY_SLACK,         /// least total float first ("slack")
+    PRIORITY_PATH           /// longest path to the end first ("path")
+};
+
+/// ----------------------------------------------------------------------------
+/// @brief Command line options for projectInfo.  Exactly one of fileName
+/// (single project) or batchPath (portfolio of projects) is set.
+/// ----------------------------------------------------------------------------
+struct ganttOptions {
+    std::string fileName;     /// project tasks file ("-f")
+    bool printFlag;           /// print adjacency list ("-p")
+    std::string batchPath;    /// directory or list of task files ("-b")
+    std::string outputDir;    /// directory for per-project reports ("-o")
+    int threadCount;          /// worker threads for batch mode ("-j")
+    long memLimit;            /// memory budget in MB, 0 if unlimited
+    double nearCritical;      /// near-critical margin, < 0 if not requested
+    bool nearPercent;         /// margin is a % of the project duration
+    int maxPaths;             /// max # of near-critical paths
+    bool stringIDs;           /// milestones are named, not dense integers
+    bool relabel;             /// renumber milestones in topological order
+    std::string chartFile;    /// Gantt chart output, ".svg" or text ("-")
+    double chartFrom;         /// chart window start
+    double chartTo;           /// chart window end, < 0 for the whole project
+    int chartWidth;           /// chart columns or pixels, 0 for the default
+    int chartRows;            /// most chart bars, 0 for the default
+    bool concurrency;         /// report the task concurrency profile
+    bool compress;            /// keep the tasks in compressed form
+    bool reduce;              /// drop transitively redundant tasks
+    bool contract;            /// fold serial chains into single tasks
+    bool dominators;          /// report the must-pass milestones
+    std::string snapshotFile; /// binary snapshot of the task list
+    std::string calendarFile; /// working-day calendars
+    std::string startDate;    /// project start, "YYYY-MM-DD"
+    std::string scheduleFile; /// milestone dates, CSV
+    std::string crashFile;    /// task crash costs
+    double crashBy;           /// crashing target, 0 for the shortest
+    std::string cacheDir;     /// result cache directory
+    long cacheSize;           /// result cache limit in MB
+    std::string editsFile;    /// edit script for versioned copies
+    int partitions;           /// worker processes, 0 if not partitioned
+    std::vector<topQuery> topQueries;   /// top-k queries, in order given
+    std::string topFile;      /// top-k results, CSV
+    std::string diffFile;     /// older version compared with fileName
+    bool deliverables;        /// critical path to each milestone with no
+                              /// tasks out
+    std::string resourceFile; /// resource capacities and task demands
+    priorityRule priority;    /// rule of the resource-constrained schedule
+    std::string resourceCsv;  /// resource-constrained task starts, CSV
+
+    ganttOptions() : printFlag(false), threadCount(0), memLimit(0),
+                     nearCritical(-1), nearPercent(false), maxPaths(100),
+                     stringIDs(false), relabel(false), chartFrom(0),
+                     chartTo(-1), chartWidth(0), chartRows(0),
+                     concurrency(false), compress(false), reduce(false),
+                     contract(false), dominators(false), crashBy(0),
+                     cacheSize(256), partitions(0), deliverables(false),
+                     priority(PRIORITY_SLACK) {}
+};
+
+/// ----------------------------------------------------------------------------
+/// @brief Storage widths chosen for a task file: the vertex index type and
+/// the weight (and distance) type.
+/// ----------------------------------------------------------------------------
+enum weightKind { WEIGHT_INT32, WEIGHT_INT64, WEIGHT_DOUBLE };
+
+struct ganttLayout {
+    bool wideIndex;           /// milestone count needs 64-bit indices
+    weightKind weights;       /// weight and accumulator type
+
+    ganttLayout() : wideIndex(false), weights(WEIGHT_INT32) {}
+};
+
+/// ----------------------------------------------------------------------------
+/// @brief Accepts and validates command line arguments.  The first of these
+/// modes whose own option is given applies, and takes only the options
+/// listed with it (MODES in ganttUtils.cpp):
+/// - portfolio, "-b <dir|listfile>": "-o <dir>", "-j <n>",
+///   "--mem-limit <MB>", "--relabel", "--compress", "--reduce", "--contract"
+/// - result cache, "-f <file> --cache <dir>": "--cache-size <MB>",
+///   "--reduce", "-j <n>"
+/// - out of core, "-f <file> --mem-limit <MB>": "-j <n>"
+/// - partitioned, "-f <file> --partitions <n>"
+/// - version diff, "-f <file> --diff <old file>": "-j <n>"
+/// - single project, "-f <file>": the report and pass options of the usage
+///   line; named milestones ("--string-ids") take no snapshot, calendar,
+///   crash costs, edit script or resources
+///
+/// @param argc Argument count
+/// @param argv Arguments
+/// @param options Parsed options
+///
+/// @return True if all arguments are valid, false if not
+/// ----------------------------------------------------------------------------
+bool getArguments(int argc, char *argv[], ganttOptions& options);
+
+/// ----------------------------------------------------------------------------
+/// @brief Reads the header of a task file and picks the narrowest layout:
+/// 32-bit indices unless the milestone count needs more, and 32-bit weights
+/// unless an optional "weights: int64|double" line follows the source line.
+/// ganttUtils::readGraph() flags files whose summed weights would overflow
+/// the chosen weight type so they can be reloaded with 64-bit weights.
+///
+/// @param fileName Project tasks file
+/// @param layout Chosen layout
+///
+/// @return True if the header could be read, false if not
+/// ----------------------------------------------------------------------------
+bool readLayout(const std::string fileName, ganttLayout& layout);
+
+/// ----------------------------------------------------------------------------
+/// @brief Task placed on the time line at its early start, for ganttChart.
+/// ----------------------------------------------------------------------------
+struct taskBar {
+    double start;               /// early start (distance of its source)
+    double finish;              /// start + task weight
+    unsigned long long from;    /// source milestone
+    unsigned long long to;      /// destination milestone
+    bool critical;              /// task is on the critical path
+};
+
+template <class idxType, class wgtType>
 struct listNode {
-    int dest;          /// destination vertex
-    int weight;        /// edge weight
-    listNode *link;    /// link to next node
+    idxType dest;                        /// destination vertex
+    wgtType weight;                      /// edge weight
+    listNode<idxType, wgtType> *link;    /// link to next node
 };
 
+template <class idxType, class wgtType>
 struct headNode {
-    listNode *head;    /// pointer to head of list
+    listNode<idxType, wgtType> *head;    /// pointer to head of list
 };
 
+/// ----------------------------------------------------------------------------
+/// @class ganttUtils
+///
+/// @brief Gantt analysis of a task graph stored as an adjacency list.  The
+/// template parameters are the vertex index type (uint32_t or uint64_t) and
+/// the weight type used for weights, distances, duration and slack (int32_t,
+/// int64_t or double); see readLayout() for how they are chosen.
+/// ----------------------------------------------------------------------------
+template <class idxType, class wgtType>
 class ganttUtils {
 private:
-    headNode *adjList;      /// adjacency list graph representation
+    typedef listNode<idxType, wgtType> edgeNode;
+    typedef headNode<idxType, wgtType> vertexNode;
+    
+    static const idxType NONE = static_cast<idxType>(-1);   /// no vertex
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Task of the crashing network (see crashProject()), between
+    /// milestones numbered as in the adjacency list.
+    struct crashTask {
+        idxType from;           /// source milestone
+        idxType to;             /// destination milestone
+        int64_t normal;         /// duration before crashing
+        int64_t duration;       /// current duration
+        int64_t minimum;        /// shortest duration
+        int64_t cost;           /// cost per unit shortened
+    };
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Task of the resource-constrained schedule (see
+    /// scheduleResources()), between milestones numbered as in the
+    /// adjacency list.
+    struct resourceTask {
+        idxType from;           /// source milestone
+        idxType to;             /// destination milestone
+        int64_t duration;       /// duration
+        int64_t start;          /// scheduled start, -1 until scheduled
+        std::size_t demand;     /// first of its demands in rcDemands
+        std::size_t demands;    /// # of its demands
+    };
+    
+    struct resourceDemand {
+        std::size_t resource;   /// resource, numbered from 0
+        int64_t units;          /// units held while the task runs
+    };
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Milestone or task found by findTop(), numbered as in the file.
+    struct topEntry {
+        idxType from;           /// milestone, or source of the task
+        idxType to;             /// destination of the task, else from
+        wgtType value;          /// float, degree, early start or weight
+    };
+    
+    struct topList {
+        topQuery query;                 /// metric and k asked for
+        std::vector<topEntry> entries;  /// best first
+    };
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Task added ('+'), removed ('-') or re-weighted ('~') since
+    /// the version compareWith() was given.
+    struct taskChange {
+        idxType from;           /// source milestone
+        idxType to;             /// destination milestone
+        wgtType before;         /// old weight, unless added
+        wgtType after;          /// new weight, unless removed
+        char kind;              /// '+', '-' or '~'
+    };
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Changes found by compareWith(), or by one of its threads for
+    /// its range of milestones.
+    struct scheduleDiff {
+        idxType milestones;     /// # of milestones of the old version
+        std::size_t tasks;      /// # of tasks of the old version
+        wgtType duration;       /// duration of the old version
+        std::vector<taskChange> changes;    /// by source, then destination
+        std::size_t added;      /// # of tasks added
+        std::size_t removed;    /// # of tasks removed
+        std::size_t reweighted; /// # of tasks re-weighted
+        std::size_t moved;      /// # of milestones whose early start moved
+        wgtType largestMove;    /// largest move (new - old), by magnitude
+        idxType largestAt;      /// milestone moved the most
+        std::size_t slackChanged;   /// # of milestones whose slack changed
+        std::vector<idxType> joined;    /// milestones new on the critical
+                                        /// path
+        std::vector<idxType> left;      /// milestones off the critical path
+        
+        scheduleDiff() : milestones(0), tasks(0), duration(0), added(0), 
+                         removed(0), reweighted(0), moved(0), 
+                         largestMove(0), largestAt(0), slackChanged(0) {}
+    };
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Walks the tasks of one milestone, either along its adjacency
+    /// list or through its part of the compressed edge stream.  After
+    /// contractChains(), a task into a chain stands for the whole chain.
+    class edgeCursor {
+    private:
+        const edgeNode *node;           /// current list node
+        const unsigned char *pos;       /// next encoded task
+        const unsigned char *end;       /// end of the milestone's tasks
+        idxType to;                     /// current decoded destination
+        wgtType w;                      /// current decoded weight
+        bool packed;                    /// walking the compressed stream
+        bool more;                      /// a decoded task is current
+        const idxType *chainEnd;        /// chain ends, nullptr if not folded
+        const wgtType *chainLength;     /// chain lengths
+        
+    public:
+        edgeCursor();
+        explicit edgeCursor(const edgeNode *head);
+        edgeCursor(const unsigned char *first, const unsigned char *last, 
+                   idxType from);
+        
+        bool valid() const;     /// a task is current
+        idxType dest() const;   /// destination of the current task
+        wgtType weight() const; /// weight of the current task
+        idxType via() const;    /// first milestone of a folded chain, or NONE
+        void next();            /// moves to the next task
+        void fold(const idxType *ends, const wgtType *lengths);  /// see above
+    };
+    
+    vertexNode *adjList;    /// adjacency list graph representation
+    unsigned char *edgeBytes;   /// compressed tasks, after compress()
+    std::size_t *edgeOffset;    /// first byte of each milestone's tasks
+    std::size_t listBytes;      /// adjacency list size before compress()
+    edgeArena<edgeNode> listNodes;  /// nodes of every list in adjList
+    idxType *label;         /// original milestone of each relabelled vertex
+    idxType *rank;          /// relabelled vertex of each original milestone
+    idxType *chainEnd;      /// milestone ending the chain of each interior
+                            /// milestone, NONE elsewhere (contractChains())
+    wgtType *chainLength;   /// length from the first milestone of a chain
+                            /// to its end
+    idxType chainCount;     /// # of chains folded
+    idxType foldedCount;    /// # of interior milestones folded
+    idInterner *names;      /// original milestone names, nullptr if dense
     std::string title;      /// project title
-    int milestoneCount;     /// # of milestones (vertices)
-    int taskCount;          /// # of tasks (edges)
-    int sourceNode;         /// source node
+    idxType milestoneCount; /// # of milestones (vertices)
+    std::size_t taskCount;  /// # of tasks (edges)
+    std::size_t removedTasks;   /// redundant tasks dropped by reduceTasks()
+    bool reduced;           /// reduceTasks() was applied
+    idxType sourceNode;     /// source node
+    bool weightOverflow;    /// summed weights may overflow wgtType
     
     double tasksMSRatio;    /// tasks/milestones ration
     double tasksDensity;    /// task density
 
-    int *indeg;             /// indegrees
-    int *outdeg;            /// outdegrees
-    int keyMS;              /// key milestone
-    int nodePoint;          /// node point
-    int *independentMS;     /// independent milestones
-    int iMSCount;           /// # of independent milestones
+    idxType *indeg;         /// indegrees
+    idxType *outdeg;        /// outdegrees
+    idxType keyMS;          /// key milestone
+    idxType nodePoint;      /// node point
+    idxType *independentMS; /// independent milestones
+    idxType iMSCount;       /// # of independent milestones
     
     bool *aps;              /// articulation points
     
-    int *topoNodes;         /// topologically sorted milestones
+    idxType *topoNodes;     /// topologically sorted milestones
+    
+    wgtType *dist;          /// distances
+    idxType *crPath;        /// critical path
+    idxType crPathCount;    /// # of milestones in critical path
+    idxType finalNode;      /// final milestone
+    wgtType duration;       /// project duration
+    
+    idxType highID;         /// highest in-degree
+    idxType highIDCount;    /// # of milestones with in-degree of highID
+    idxType lowID;          /// lowest in-degree
+    idxType lowIDCount;     /// # of milestones with in-degree of lowID
+    
+    idxType highOD;         /// highest in-degree
+    idxType highODCount;    /// # of milestones with in-degree of highID
+    idxType lowOD;          /// lowest in-degree
+    idxType lowODCount;     /// # of milestones with in-degree of lowID
+    
+    wgtType *slackTimes;    /// slack times
     
-    int *dist;              /// distances
-    int *crPath;            /// critical path
-    int crPathCount;        /// # of milestones in critical path
-    int finalNode;          /// final milestone
-    int duration;           /// project duration
+    wgtType *tailDist;      /// longest distance from milestone to any sink
+    wgtType nearLimit;      /// minimum length of a near-critical path
+    std::vector<idxType> ncPaths;       /// near-critical paths, concatenated
+    std::vector<std::size_t> ncPathStart;   /// start of each path in ncPaths
+    std::vector<wgtType> ncPathLength;  /// length (duration) of each path
     
-    int highID;             /// highest in-degree
-    int highIDCount;        /// # of milestones with in-degree of highID
-    int lowID;              /// lowest in-degree
-    int lowIDCount;         /// # of milestones with in-degree of lowID
+    std::vector<idxType> dlvNodes;      /// deliverables (milestones with no
+                                        /// tasks out)
+    std::vector<wgtType> dlvDuration;   /// duration of each deliverable
+    std::vector<idxType> dlvCritical;   /// # of milestones critical to each
+    std::vector<idxType> dlvPaths;      /// critical paths, concatenated
+    std::vector<std::size_t> dlvPathStart;  /// start of each path in dlvPaths
     
-    int highOD;             /// highest in-degree
-    int highODCount;        /// # of milestones with in-degree of highID
-    int lowOD;              /// lowest in-degree
-    int lowODCount;         /// # of milestones with in-degree of lowID
+    std::vector<idxType> domParent;     /// immediate dominator, NONE if
+                                        /// not reached from the source
+    std::vector<idxType> domPre;        /// preorder # in the dominator tree
+    std::vector<idxType> domSize;       /// size of the dominator subtree
+    std::vector<idxType> pdomParent;    /// immediate post-dominator, NONE
+                                        /// if the final node is not reached
+    std::vector<idxType> pdomPre;       /// preorder # in the post-dominator
+                                        /// tree
+    std::vector<idxType> pdomSize;      /// size of the post-dominator subtree
     
-    int *slackTimes;        /// slack times
+    const calendarSet *calendars;       /// calendars of scheduleCalendar()
+    std::vector<int> msCalendar;        /// calendar of each milestone's tasks
+    std::vector<long> earlyDate;        /// earliest start date
+    std::vector<long> lateDate;         /// latest start date
+    long startDay;          /// project start date
+    long finishDay;         /// project finish date
+    
+    std::vector<crashTask> crashTasks;  /// every task, by topological order
+                                        /// of its source (readCrashCosts())
+    std::vector<int64_t> curveDuration; /// time-cost curve breakpoints
+    std::vector<int64_t> curveCost;     /// crash cost at each breakpoint
+    int64_t crashGoal;      /// units to shorten by, 0 for as far as it goes
+    
+    std::vector<topList> topLists;      /// findTop() results, in order
+    
+    std::vector<resourceTask> rcTasks;  /// every task, by source milestone
+                                        /// (readResources())
+    std::vector<resourceDemand> rcDemands;  /// demands of the tasks
+    std::vector<int64_t> rcCapacity;    /// capacity of each resource
+    std::vector<int64_t> rcPeak;        /// most units of each in use at once
+    priorityRule rcRule;    /// rule the schedule was made with
+    int64_t rcDuration;     /// resource-constrained duration
+    std::size_t rcDelayed;  /// # of tasks starting after their early start
+    scheduleDiff diff;      /// compareWith() results
+    
+    std::size_t peakTasks;  /// most tasks running at once
+    wgtType peakStart;      /// first time peakTasks are running
+    wgtType taskTime;       /// sum of all task weights
+    std::vector<wgtType> concurrencyTime;   /// time with k tasks running
+    
+    void *resultMap;        /// results mapped by readResults(), or nullptr
+    std::size_t resultBytes;    /// bytes mapped
 
 public:
     /// -----------------------------------------------------------------------
@@ -68,30 +416,90 @@ public:
     ~ganttUtils();
     
     /// -----------------------------------------------------------------------
-    /// @brief Accepts and validates command line arguments.  The arguments 
-    /// include the project tasks file ("-f <filename>") and an optional print 
-    /// adjacency list flag ("-p").
+    /// @brief Reads a formatted graph file containing a task list.  The file
+    /// content is formatted as follows: 1) project title, 2) milestone count,
+    /// 3) source node, optionally a "weights: <type>" line (see readLayout()),
+    /// 4-eof) source vertex, destination vertex, and edge weight in one line.
+    /// Verifies that milestone count and source node are valid.  The task
+    /// lines are read, parsed and added by a pipeline of threads, a reader,
+    /// the parsers and the calling thread, which counts the in- and
+    /// out-degrees as it goes; reading stops at the first malformed line.
     ///
-    /// @param argc Argument count
-    /// @param argv Arguments
     /// @param fileName Project tasks file
-    /// @param printFlag Print adjacency list
+    /// @param threads # of parser threads, 0 for all but two of the cores
     ///
-    /// @return True if all arguments are valid, false if not
-    bool getArguments(int argc, char *argv[],
-                      std::string& fileName, bool& printFlag);
+    /// @return True if file read was successful, false if not
+    bool readGraph(const std::string fileName, int threads = 0);
     
     /// -----------------------------------------------------------------------
-    /// @brief Reads a formatted graph file containing a task list.  The file
-    /// content is formatted as follows: 1) project title, 2) milestone count,
-    /// 3) source node, 4-eof) source vertex, destination vertex, and edge
-    /// weight in one line.  Verifies that milestone count and source node
-    /// are valid.
+    /// @brief Reads a task file whose milestones are arbitrary identifiers
+    /// (string keys or sparse 64-bit numbers) instead of dense integers.
+    /// Identifiers are interned into dense indices while parsing, the
+    /// milestone count line is only a size hint and the source line names
+    /// the source milestone.  All print functions then display the original
+    /// identifiers.
     ///
     /// @param fileName Project tasks file
     ///
     /// @return True if file read was successful, false if not
-    bool readGraph(const std::string fileName);
+    bool readNamedGraph(const std::string fileName);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Reads the task list from a binary snapshot written by
+    /// writeSnapshot() for the same task file.  The snapshot is only used if
+    /// its version, storage widths and reduction flag match and the task
+    /// file's size and modification time are those it was written from.
+    ///
+    /// @param snapshotFile Snapshot file
+    /// @param fileName Project tasks file the snapshot stands for
+    /// @param reduce Snapshot must hold the reduced task list
+    ///
+    /// @return True if the snapshot was read, false if it is missing or
+    /// stale (the object is then left untouched)
+    bool readSnapshot(const std::string snapshotFile, 
+                      const std::string fileName, bool reduce);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Writes the task list (after reduceTasks(), if called) as a
+    /// binary snapshot of fileName, see readSnapshot().
+    ///
+    /// @param snapshotFile Snapshot file
+    /// @param fileName Project tasks file the snapshot stands for
+    ///
+    /// @return True if the snapshot was written, false if not
+    bool writeSnapshot(const std::string snapshotFile, 
+                       const std::string fileName) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Maps the results of an earlier analysis of the same task file
+    /// (see writeResults()), in place of reading and analysing it: the
+    /// graph information, dependency statistics, topological sort,
+    /// articulation points, critical path and slack times.  The arrays are
+    /// used straight from the mapping.  The results are only used if their
+    /// format version, storage widths and reduction flag match and they
+    /// were written for a task file with this hash and size.
+    ///
+    /// @param resultFile Result file
+    /// @param hash XXH64 of the project tasks file
+    /// @param size Bytes of the project tasks file
+    /// @param reduce Results must be for the reduced task list
+    ///
+    /// @return True if the results were mapped, false if they are missing
+    /// or stale (the object is then left untouched)
+    bool readResults(const std::string resultFile, uint64_t hash, 
+                     uint64_t size, bool reduce);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Writes the results of the analysis, after findSlackTimes(),
+    /// see readResults().
+    ///
+    /// @param resultFile Result file
+    /// @param hash XXH64 of the project tasks file
+    /// @param size Bytes of the project tasks file
+    ///
+    /// @return True if the results were written, false if not
+    bool writeResults(const std::string resultFile, uint64_t hash, 
+                      uint64_t size) const;
     
     /// -----------------------------------------------------------------------
     /// @brief Checks for cycles in the graph.  Calls isCycle().
@@ -102,7 +510,126 @@ public:
     
     /// -----------------------------------------------------------------------
     /// @return Task count
-    int getTaskCount() const;
+    std::size_t getTaskCount() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Milestone count
+    idxType getMilestoneCount() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Project title
+    std::string getTitle() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Project duration (valid after criticalPath())
+    wgtType getDuration() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Final milestone (valid after criticalPath())
+    idxType getFinalNode() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return # of milestones in critical path (valid after criticalPath())
+    idxType getCriticalPathCount() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Source milestone
+    idxType getSourceNode() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Distance of each milestone (valid after topoSort()), not a
+    /// copy
+    const wgtType* getDistances() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Milestones in topological order (valid after topoSort()),
+    /// not a copy
+    const idxType* getTopoOrder() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Critical path, final milestone first (valid after
+    /// criticalPath()), not a copy
+    const idxType* getCriticalPath() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Slack time of each milestone, -1 if none (valid after
+    /// findSlackTimes()), not a copy
+    const wgtType* getSlackTimes() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return In-degree of each milestone, not a copy
+    const idxType* getInDegrees() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Out-degree of each milestone, not a copy
+    const idxType* getOutDegrees() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Articulation point flag of each milestone (valid after
+    /// findAPs()), not a copy
+    const bool* getAPs() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return Milestone names, nullptr if the milestones are dense indices
+    const idInterner* getNames() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Lists every task with its early start and finish times
+    /// (valid after criticalPath()).
+    ///
+    /// @param bars Receives one entry per task, in adjacency list order
+    void getTaskBars(std::vector<taskBar>& bars) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Lists every task by its original milestone numbers, as the
+    /// first version of a versionedGraph.
+    ///
+    /// @param from Receives the source milestone of each task
+    /// @param to Receives the destination milestone of each task
+    /// @param weight Receives the weight of each task
+    void getTasks(std::vector<idxType>& from, std::vector<idxType>& to,
+                  std::vector<wgtType>& weight) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @return True if readGraph() found weights whose sum may overflow
+    /// wgtType, the file should then be reloaded with 64-bit weights
+    bool hasWeightOverflow() const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Optional stage after isValidProject(), before any other pass.
+    /// Drops each task u->v that is implied by another task u->b of at
+    /// least the same weight with v reachable from b, so the dependency and
+    /// its lag still hold through b.  Reachability is computed as bitsets
+    /// over blocks of target milestones in reverse topological order, the
+    /// blocks being shared out among the threads.  Tasks on a longest path
+    /// (early start of u + weight = early start of v) are always kept, so
+    /// the duration and the critical path do not change.  So is the last
+    /// task in each list, the one findSlackTimes() reads, so the slack
+    /// times do not change either.  Does nothing if any weight is negative.
+    ///
+    /// @param threads Worker threads, 0 for one per hardware thread
+    void reduceTasks(int threads = 0);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the number of tasks dropped by reduceTasks().
+    ///
+    /// @param out Output stream
+    void printReduction(std::ostream& out = std::cout);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Replaces the adjacency lists by one compressed byte stream.
+    /// Each destination is stored as a zigzag varint gap from the previous
+    /// one (from the milestone itself for the first), each weight as a
+    /// zigzag varint (raw for double weights).  Tasks keep their list order,
+    /// so every pass, reading the tasks through edgeCursor, gives the same
+    /// results on either form.  Not combined with relabel().
+    void compress();
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the adjacency size before and after compress().
+    ///
+    /// @param out Output stream
+    void printStorage(std::ostream& out = std::cout);
     
     /// -----------------------------------------------------------------------
     /// @brief Calculates tasks/milestones ratio and the task density using
@@ -125,7 +652,9 @@ public:
     /// @brief Displays the project title, milestone count, task count,
     /// source milestone, tasks/milestones ratio, project tasks density,
     /// key milestone, node point, and independent milestones.
-    void printGraphInformation();
+    ///
+    /// @param out Output stream
+    void printGraphInformation(std::ostream& out = std::cout);
     
     /// -----------------------------------------------------------------------
     /// @brief Finds the articulation points in the graph which are vertices
@@ -135,16 +664,100 @@ public:
     
     /// -----------------------------------------------------------------------
     /// @brief Displays the articulation points of the graph.
-    void printAPs();
+    ///
+    /// @param out Output stream
+    void printAPs(std::ostream& out = std::cout);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Builds the dominator tree rooted at the source node and the
+    /// post-dominator tree rooted at the final node, after criticalPath().
+    /// Uses the Cooper-Harvey-Kennedy intersection, which on a DAG taken in
+    /// topological order needs a single pass, over an array of successors
+    /// read from the task storage in one sweep.  Each tree is then numbered
+    /// in preorder with subtree sizes so dominance queries take constant
+    /// time.
+    ///
+    /// @param threads Threads, 0 for one per hardware thread; with two or
+    /// more the trees are built at the same time
+    void findDominators(int threads = 0);
+    
+    /// -----------------------------------------------------------------------
+    /// @param v Milestone
+    ///
+    /// @return Immediate dominator of v (v for the source node), or -1 cast
+    /// to idxType if v is not reached from the source (valid after
+    /// findDominators())
+    idxType getDominator(idxType v) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @param v Milestone
+    ///
+    /// @return Immediate post-dominator of v (v for the final node), or -1
+    /// cast to idxType if the final node is not reached from v
+    idxType getPostDominator(idxType v) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @param a Milestone
+    /// @param b Milestone
+    ///
+    /// @return True if every path from the source node to b goes through a
+    bool dominates(idxType a, idxType b) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @param a Milestone
+    /// @param b Milestone
+    ///
+    /// @return True if every path from b to the final node goes through a
+    bool postDominates(idxType a, idxType b) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the must-pass milestones (those on every path from
+    /// the source node to the final node) and how many milestones each
+    /// tree covers.
+    ///
+    /// @param out Output stream
+    void printDominators(std::ostream& out = std::cout);
     
     /// -----------------------------------------------------------------------
     /// @brief Implements Kahn's Topological Sort Algorithm to find a 
     /// topological ordering of the vertices.
     void topoSort();
     
+    /// -----------------------------------------------------------------------
+    /// @brief Optional stage between topoSort() and criticalPath().  Renumbers
+    /// the vertices in topological order and rebuilds the adjacency lists in
+    /// that order in a fresh arena, so the forward and backward passes walk
+    /// dist and the edges nearly sequentially.  Milestones are still
+    /// reported by their original numbers, with the same tie-breaking as
+    /// without it.
+    void relabel();
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Optional stage between topoSort() (or relabel()) and
+    /// criticalPath().  Folds every maximal chain of milestones with one
+    /// predecessor and one successor (from the indeg and outdeg arrays) into
+    /// a single task from the milestone before the chain to the one after
+    /// it, weighted by the chain's length.  The forward pass and the
+    /// near-critical search then walk the contracted graph; criticalPath()
+    /// fills in the distances of the folded milestones and traces the
+    /// critical path over every task, and slack, concurrency and the chart
+    /// still see every task, so results are reported for all the original
+    /// milestones.  Integer weights only (folding would reassociate double
+    /// sums).
+    void contractChains();
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the chain and milestone counts folded by
+    /// contractChains().
+    ///
+    /// @param out Output stream
+    void printContraction(std::ostream& out = std::cout);
+    
     /// -----------------------------------------------------------------------
     /// @brief Displays the topological sort for the vertices in the graph.
-    void printTopoSort();
+    ///
+    /// @param out Output stream
+    void printTopoSort(std::ostream& out = std::cout);
     
     /// -----------------------------------------------------------------------
     /// @brief Finds the critical path in the directed acyclic graph.  For each
@@ -155,7 +768,9 @@ public:
     /// -----------------------------------------------------------------------
     /// @brief Prints the source node, final task, total duration, and the
     /// vertices found in the critical path.
-    void printCriticalPath();
+    ///
+    /// @param out Output stream
+    void printCriticalPath(std::ostream& out = std::cout);
     
     /// -----------------------------------------------------------------------
     /// @brief Finds the dependency statistics for the in-degrees and the
@@ -166,7 +781,9 @@ public:
     
     /// -----------------------------------------------------------------------
     /// @brief Displays dependency statistics.
-    void printDependencyStats();
+    ///
+    /// @param out Output stream
+    void printDependencyStats(std::ostream& out = std::cout);
     
     /// -----------------------------------------------------------------------
     /// @brief Computes the amount of time between the start of the next task
@@ -175,11 +792,226 @@ public:
     
     /// -----------------------------------------------------------------------
     /// @brief Displays slack times.
-    void printSlackTimes();
+    ///
+    /// @param out Output stream
+    void printSlackTimes(std::ostream& out = std::cout);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Enumerates the source-to-sink paths whose length is within
+    /// margin of the project duration, longest first.  Uses dist and a
+    /// backward pass (longest distance to a sink) to prune, and expands
+    /// partial paths best-first so that at most maxPaths paths are kept in
+    /// memory however many near-critical paths the graph has.
+    ///
+    /// @param margin Allowed shortfall from the project duration
+    /// @param maxPaths Maximum number of paths to report
+    void findNearCriticalPaths(wgtType margin, int maxPaths);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the near-critical paths with their lengths and
+    /// shortfall from the project duration.
+    ///
+    /// @param out Output stream
+    void printNearCriticalPaths(std::ostream& out = std::cout);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Finds the duration, critical milestones and a critical path of
+    /// each deliverable (milestone with no tasks out), after topoSort() and
+    /// criticalPath().  The forward pass already starts from a virtual
+    /// super-source before every milestone with no tasks in, and the final
+    /// milestone closes a virtual super-sink after every deliverable.  The
+    /// backward passes run in lanes: one sweep in reverse topological order
+    /// carries a cache line of deliverables, so each task is read once per
+    /// sweep rather than once per deliverable.
+    void findDeliverables();
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays each deliverable with its duration, # of critical
+    /// milestones and critical path, by milestone.
+    ///
+    /// @param out Output stream
+    void printDeliverables(std::ostream& out = std::cout);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Finds how many tasks run at the same time over the schedule of
+    /// criticalPath() (each task starting at its early start).  Start and
+    /// end times are radix sorted in parallel and swept once, giving the
+    /// time spent at each concurrency level and the peak.
+    ///
+    /// @param threads Sort threads, 0 for one per hardware thread
+    void findConcurrency(int threads = 0);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the peak and average concurrency and the concurrency
+    /// histogram (time with a given number of tasks running).
+    ///
+    /// @param out Output stream
+    void printConcurrency(std::ostream& out = std::cout);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Finds the k milestones or tasks that rank first by a metric,
+    /// after findSlackTimes().  Each thread ranks a range of milestones into
+    /// a bounded heap of its own (see boundedHeap) and the heaps are merged
+    /// at the end, so only the k results are ever sorted.  Ties go to the
+    /// lower milestone, then the lower destination.  Milestones without a
+    /// slack time are not ranked by float.
+    ///
+    /// @param query Metric and k
+    /// @param threads Worker threads, 0 for one per hardware thread
+    void findTop(const topQuery& query, int threads = 0);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the results of each findTop().
+    ///
+    /// @param out Output stream
+    void printTop(std::ostream& out = std::cout);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Writes the results of each findTop() as CSV, one row per
+    /// milestone or task.
+    ///
+    /// @param fileName CSV file
+    ///
+    /// @return True if the file was written, false if not
+    bool writeTop(const std::string fileName) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Compares the project with an older version of it, both after
+    /// findSlackTimes() and with milestones numbered alike.  Each
+    /// milestone's tasks in both versions are sorted by destination and
+    /// merged in one pass, giving the tasks added, removed and re-weighted,
+    /// and its early start and slack time are compared.  Threads take
+    /// ranges of milestones and their changes are joined in milestone
+    /// order; the critical paths are compared last.
+    ///
+    /// @param base Older version
+    /// @param threads Worker threads, 0 for one per hardware thread
+    void compareWith(const ganttUtils& base, int threads = 0);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the changes found by compareWith(): counts, duration,
+    /// early starts and slack times moved, critical path milestones joined
+    /// and left, and each task changed.
+    ///
+    /// @param out Output stream
+    void printDiff(std::ostream& out = std::cout);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Schedules the project on working-day calendars from a start
+    /// date, after criticalPath().  Task weights are working days in the
+    /// calendar of the milestone the task leaves.  The forward pass sets the
+    /// earliest start date of each milestone in topological order, the
+    /// backward pass the latest start date that keeps the finish date, each
+    /// step two constant-time lookups in the calendar (see workCalendar),
+    /// however long the task.  Integer weights only.
+    ///
+    /// @param calendarList Calendars and the milestones they apply to
+    /// @param start Project start date (day number)
+    ///
+    /// @return True if every date falls within its calendar, false if not
+    bool scheduleCalendar(const calendarSet& calendarList, long start);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the start and finish dates and the critical path
+    /// milestones with their dates.
+    ///
+    /// @param out Output stream
+    void printSchedule(std::ostream& out = std::cout);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Writes every milestone's earliest and latest start dates and
+    /// its float in working days as CSV.
+    ///
+    /// @param fileName CSV file
+    ///
+    /// @return True if the file was written, false if not
+    bool writeSchedule(const std::string fileName) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Reads the crash costs of tasks, after criticalPath().  Each
+    /// line names a task and its shortest duration and cost per unit
+    /// shortened ("<from> <to> <minimum> <cost>", "#" starts a comment).
+    /// Tasks not listed can not be crashed; repeated tasks are crashed
+    /// alike, each to no less than its own weight.
+    ///
+    /// @param fileName Crash cost file
+    ///
+    /// @return True if every line names a task, with a minimum of at most
+    /// its (largest) weight and a cost of at least 0, false if not
+    bool readCrashCosts(const std::string fileName);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Finds the cheapest way to shorten the project (the time-cost
+    /// curve) with linear crash costs, one breakpoint at a time.  At each
+    /// breakpoint the critical tasks form a flow network, each task an arc
+    /// whose capacity is its cost if it can still be shortened (else
+    /// uncapacitated) and whose lower bound is its cost if it was shortened
+    /// before, so it may be given back.  The minimum cut then shortens its
+    /// forward tasks and lengthens its backward ones for the least cost per
+    /// unit.  The step goes on until a task reaches its minimum or normal
+    /// duration or another path becomes critical, found by re-running the
+    /// forward pass for the step and, if some path grows too long, cutting
+    /// the step back to where that path meets the new duration.  Integer
+    /// weights only.
+    ///
+    /// @param reduceBy Units to shorten the project by, 0 for as far as it
+    /// goes
+    void crashProject(wgtType reduceBy);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the time-cost curve and the tasks crashed.
+    ///
+    /// @param out Output stream
+    void printCrashing(std::ostream& out = std::cout);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Reads resource capacities and task demands, after
+    /// criticalPath().  The first line gives the capacity of each resource
+    /// ("resources <units> ..."), each later line a task and the units of
+    /// resources it holds while it runs ("<from> <to> <resource>:<units>
+    /// ...", resources numbered from 0, "#" starts a comment).  Tasks not
+    /// listed need no resources; repeated tasks need the same.
+    ///
+    /// @param fileName Resource file
+    ///
+    /// @return True if every line names a task and resources that exist,
+    /// and no task needs more of a resource than its capacity, false if not
+    bool readResources(const std::string fileName);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Schedules the tasks within the resource capacities with the
+    /// serial schedule generation scheme.  A task becomes eligible once
+    /// every task into its source milestone is scheduled; eligible tasks
+    /// wait in an indexed binary heap ordered by the priority rule, and the
+    /// best of them is placed at the earliest time from its source's
+    /// finish where every resource it needs has room for its whole
+    /// duration, found and reserved on each resource's usage profile (see
+    /// resourceProfile).  Integer weights only.
+    ///
+    /// @param rule Priority rule
+    void scheduleResources(priorityRule rule);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Displays the resource-constrained duration, the tasks delayed
+    /// and the peak usage of each resource.
+    ///
+    /// @param out Output stream
+    void printResources(std::ostream& out = std::cout);
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Writes every task's resource-constrained start and finish as
+    /// CSV.
+    ///
+    /// @param fileName CSV file
+    ///
+    /// @return True if the file was written, false if not
+    bool writeResources(const std::string fileName) const;
     
     /// -----------------------------------------------------------------------
     /// @brief Displays the project title and a formatted adjacency list.
-    void printGraph();
+    ///
+    /// @param out Output stream
+    void printGraph(std::ostream& out = std::cout);
 
 private:
     /// -----------------------------------------------------------------------
@@ -189,7 +1021,7 @@ private:
     /// @param from Source vertex
     /// @param to Destination vertex
     /// @param edge Edge weight
-    void addEdge(int from, int to, int edge);
+    void addEdge(idxType from, idxType to, wgtType edge);
     
     /// -----------------------------------------------------------------------
     /// @brief Recursively checks if a vertex has an edge from itself to itself
@@ -199,7 +1031,73 @@ private:
     /// @param marked
     ///
     /// @return True if there is a cycle, false if not
-    bool isCycle(int v, bool *visited, bool *marked);
+    bool isCycle(idxType v, bool *visited, bool *marked);
+    
+    /// -----------------------------------------------------------------------
+    /// @param v Vertex
+    /// @param contracted Fold chains if contractChains() was called (no
+    /// tasks for a folded milestone), false for every task
+    ///
+    /// @return Cursor on the first task of v
+    edgeCursor edges(idxType v, bool contracted = true) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief findTop() worker, ranks the milestones lo to hi - 1 (or their
+    /// tasks) into a heap.
+    ///
+    /// @param metric Ranked metric
+    /// @param lo First milestone (relabelled if relabel() was called)
+    /// @param hi Milestone after the last
+    /// @param heap boundedHeap of the worker
+    template <class heapType>
+    void rankRange(topMetric metric, idxType lo, idxType hi, 
+                   heapType *heap) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief compareWith() worker, compares the milestones lo to hi - 1.
+    ///
+    /// @param base Older version
+    /// @param lo First milestone
+    /// @param hi Milestone after the last
+    /// @param part Receives the changes of the range
+    void diffRange(const ganttUtils *base, idxType lo, idxType hi, 
+                   scheduleDiff *part) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Sets dist of the milestones folded by contractChains(), from
+    /// the milestone before each chain.
+    void expandChains();
+    
+    /// -----------------------------------------------------------------------
+    /// @param v Vertex (relabelled if relabel() was called)
+    ///
+    /// @return Original milestone number of v
+    idxType original(idxType v) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Rebuilds the critical path of a relabelled or contracted graph
+    /// from its in-edges, taking the predecessor the in-memory sweep would
+    /// take.
+    void traceCriticalPath();
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Forward pass over crashTasks with each task's duration moved
+    /// by step in its direction (-1 shortened, 1 lengthened, 0 kept).
+    ///
+    /// @param step Units to move the tasks by
+    /// @param direction Direction of each task, empty for none
+    /// @param start Early start of each milestone
+    /// @param pred Task setting the early start, NONE for none
+    ///
+    /// @return Project duration
+    int64_t crashForward(int64_t step, const std::vector<int>& direction,
+                         std::vector<int64_t>& start,
+                         std::vector<std::size_t>& pred) const;
+    
+    /// -----------------------------------------------------------------------
+    /// @brief Backward pass in reverse topological order, finds the longest
+    /// distance from each milestone to any sink (tailDist).
+    void findTailDistances();
     
     /// -----------------------------------------------------------------------
     /// @brief Recursively finds the articulation points in the graph.
@@ -210,8 +1108,50 @@ private:
     /// @param low
     /// @param parent
     /// @param aps
-    void findAPsHelper(int v, bool *visited, int *disc, int *low, 
-                       int *parent, bool *aps);
+    void findAPsHelper(idxType v, bool *visited, idxType *disc, idxType *low, 
+                       idxType *parent, bool *aps);
 };
 
+/// ----------------------------------------------------------------------------
+/// @brief Returned by a layout visitor when the file's weights overflowed
+/// the chosen weight type, so withLayout() retries with 64-bit weights.
+/// ----------------------------------------------------------------------------
+const int LAYOUT_TOO_NARROW = -2;
+
+/// ----------------------------------------------------------------------------
+/// @brief Calls visitor.run<idxType, wgtType>() for the given layout.  A
+/// 32-bit weight layout that returns LAYOUT_TOO_NARROW is run again with
+/// int64_t weights.
+///
+/// @param layout Layout chosen by readLayout()
+/// @param visitor Object with a template member run<idxType, wgtType>()
+///
+/// @return Result of the visitor
+/// ----------------------------------------------------------------------------
+template <class idxType, class visitorType>
+int withWeights(weightKind weights, visitorType& visitor) {
+    if(weights == WEIGHT_DOUBLE) {
+        return visitor.template run<idxType, double>();
+    }
+    
+    if(weights == WEIGHT_INT32) {
+        int result = visitor.template run<idxType, int32_t>();
+        
+        if(result != LAYOUT_TOO_NARROW) {
+            return result;
+        }
+    }
+    
+    return visitor.template run<idxType, int64_t>();
+}
+
+template <class visitorType>
+int withLayout(const ganttLayout& layout, visitorType& visitor) {
+    if(layout.wideIndex) {
+        return withWeights<uint64_t>(layout.weights, visitor);
+    }
+    
+    return withWeights<uint32_t>(layout.weights, visitor);
+}
+
 #endif /* H_GANTTUTILS */
@@ -0,0 +1,128 @@
+/// @brief Implementation file for class idInterner
+/// @file idInterner.cpp
+
+#include "idInterner.h"
+
+#include <cstring>
+
+idInterner::idInterner(size_t expected) {
+    size_t capacity = 16;
+
+    // keep the table at most half full
+    while(capacity < 2 * expected) {
+        capacity *= 2;
+    }
+
+    slots.assign(capacity, -1);
+    mask = capacity - 1;
+    offsets.push_back(0);
+    offsets.reserve(expected + 1);
+    hashes.reserve(expected);
+}
+
+/// ----------------------------------------------------------------------------
+
+uint32_t idInterner::hashName(const char *name, size_t length) {
+    uint32_t hash = 2166136261u;
+
+    for(size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/// ----------------------------------------------------------------------------
+
+int idInterner::find(const char *name, size_t length) const {
+    uint32_t hash = hashName(name, length);
+    size_t slot = hash & mask;
+    int id = 0;
+
+    // linear probing until the name or an empty slot is found
+    while((id = slots[slot]) != -1) {
+        if(hashes[id] == hash && offsets[id + 1] - offsets[id] == length
+           && std::memcmp(&pool[offsets[id]], name, length) == 0) {
+            return id;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return -1;
+}
+
+/// ----------------------------------------------------------------------------
+
+int idInterner::intern(const char *name, size_t length) {
+    uint32_t hash = hashName(name, length);
+    size_t slot = hash & mask;
+    int id = 0;
+
+    while((id = slots[slot]) != -1) {
+        if(hashes[id] == hash && offsets[id + 1] - offsets[id] == length
+           && std::memcmp(&pool[offsets[id]], name, length) == 0) {
+            return id;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    id = size();
+    slots[slot] = id;
+    hashes.push_back(hash);
+    pool.insert(pool.end(), name, name + length);
+    offsets.push_back(pool.size());
+
+    if(2 * hashes.size() > slots.size()) {
+        grow();
+    }
+
+    return id;
+}
+
+/// ----------------------------------------------------------------------------
+
+void idInterner::grow() {
+    size_t slot = 0;
+
+    slots.assign(2 * slots.size(), -1);
+    mask = slots.size() - 1;
+
+    for(int id = 0; id < size(); id++) {
+        slot = hashes[id] & mask;
+
+        while(slots[slot] != -1) {
+            slot = (slot + 1) & mask;
+        }
+
+        slots[slot] = id;
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+int idInterner::size() const {
+    return static_cast<int>(hashes.size());
+}
+
+/// ----------------------------------------------------------------------------
+
+size_t idInterner::length(int id) const {
+    return offsets[id + 1] - offsets[id];
+}
+
+/// ----------------------------------------------------------------------------
+
+void idInterner::write(std::ostream& out, int id, int width) const {
+    size_t count = length(id);
+
+    for(int i = static_cast<int>(count); i < width; i++) {
+        out.put(' ');
+    }
+
+    out.write(&pool[offsets[id]], count);
+}
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+/// @brief Header file for class idInterner
+/// @file idInterner.h
+
+#ifndef H_IDINTERNER
+#define H_IDINTERNER
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/// ----------------------------------------------------------------------------
+/// @class idInterner
+///
+/// @brief Maps arbitrary milestone identifiers (string keys or sparse 64-bit
+/// numbers as written in the task file) to dense indices 0..size()-1.  Names
+/// are stored back to back in one character pool and looked up through an
+/// open-addressing hash table of indices, so no string is allocated per
+/// milestone.
+/// ----------------------------------------------------------------------------
+class idInterner {
+private:
+    std::vector<char> pool;           /// all names, back to back
+    std::vector<size_t> offsets;      /// start of each name in pool (+ end)
+    std::vector<uint32_t> hashes;     /// hash of each name
+    std::vector<int> slots;           /// hash table of indices, -1 if empty
+    size_t mask;                      /// slots.size() - 1
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Initializes an empty table.
+    ///
+    /// @param expected Expected # of names, used to size the table
+    explicit idInterner(size_t expected = 0);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Returns the index of a name, adding it if it is new.
+    ///
+    /// @param name First character of the name
+    /// @param length Length of the name
+    ///
+    /// @return Dense index of the name
+    int intern(const char *name, size_t length);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Looks up a name without adding it.
+    ///
+    /// @param name First character of the name
+    /// @param length Length of the name
+    ///
+    /// @return Dense index of the name, -1 if unknown
+    int find(const char *name, size_t length) const;
+
+    /// -----------------------------------------------------------------------
+    /// @return # of names
+    int size() const;
+
+    /// -----------------------------------------------------------------------
+    /// @param id Dense index
+    ///
+    /// @return Length of the name of id
+    size_t length(int id) const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Writes the original name of id, right aligned to width.
+    ///
+    /// @param out Output stream
+    /// @param id Dense index
+    /// @param width Minimum field width
+    void write(std::ostream& out, int id, int width = 0) const;
+
+private:
+    /// -----------------------------------------------------------------------
+    /// @return FNV-1a hash of a name
+    static uint32_t hashName(const char *name, size_t length);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Doubles the hash table and reinserts every index.
+    void grow();
+};
+
+#endif /* H_IDINTERNER */
@@ -0,0 +1,132 @@
+/// @brief Implementation file for template class indexedHeap
+/// @file indexedHeap.h
+
+#ifndef H_INDEXEDHEAP
+#define H_INDEXEDHEAP
+
+#include <cstddef>
+#include <vector>
+
+/// ----------------------------------------------------------------------------
+/// @class indexedHeap
+///
+/// @brief Binary min-heap of item indices 0 .. count - 1, ordered by a key
+/// kept per index and, on equal keys, by the lower index.  The heap holds
+/// only the indices, so a sift moves machine words however large the key,
+/// and the order is the same from run to run.  Push and pop take
+/// O(log n).
+/// ----------------------------------------------------------------------------
+template <class keyType>
+class indexedHeap {
+private:
+    std::vector<std::size_t> items;     /// indices held, best at the front
+    std::vector<keyType> keys;          /// key of each index
+
+public:
+    /// ------------------------------------------------------------------------
+    /// @brief (Constructor) Creates an empty heap.
+    ///
+    /// @param count # of indices
+    /// ------------------------------------------------------------------------
+    explicit indexedHeap(std::size_t count);
+
+    /// ------------------------------------------------------------------------
+    /// @return True if no index is held
+    /// ------------------------------------------------------------------------
+    bool empty() const;
+
+    /// ------------------------------------------------------------------------
+    /// @brief Adds an index not held yet.
+    ///
+    /// @param index Index
+    /// @param key Its key
+    /// ------------------------------------------------------------------------
+    void push(std::size_t index, const keyType& key);
+
+    /// ------------------------------------------------------------------------
+    /// @brief Removes the best index, the heap must not be empty.
+    ///
+    /// @return The index with the lowest key (lowest index on a tie)
+    /// ------------------------------------------------------------------------
+    std::size_t pop();
+
+private:
+    /// ------------------------------------------------------------------------
+    /// @return True if index a comes before index b
+    /// ------------------------------------------------------------------------
+    bool before(std::size_t a, std::size_t b) const;
+};
+
+/// ----------------------------------------------------------------------------
+
+template <class keyType>
+indexedHeap<keyType>::indexedHeap(std::size_t count) : keys(count) {
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class keyType>
+bool indexedHeap<keyType>::empty() const {
+    return items.empty();
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class keyType>
+void indexedHeap<keyType>::push(std::size_t index, const keyType& key) {
+    std::size_t p = items.size();
+
+    keys[index] = key;
+    items.push_back(index);
+
+    // sift up
+    while(p > 0 && before(index, items[(p - 1) / 2])) {
+        items[p] = items[(p - 1) / 2];
+        p = (p - 1) / 2;
+    }
+
+    items[p] = index;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class keyType>
+std::size_t indexedHeap<keyType>::pop() {
+    std::size_t best = items.front();
+    std::size_t last = items.back();
+    std::size_t n = items.size() - 1;
+    std::size_t p = 0;
+    std::size_t c = 1;
+
+    items.pop_back();
+
+    // sift the last index down from the root
+    while(c < n) {
+        if(c + 1 < n && before(items[c + 1], items[c])) {
+            c++;
+        }
+
+        if(!before(items[c], last)) {
+            break;
+        }
+
+        items[p] = items[c];
+        p = c;
+        c = 2 * p + 1;
+    }
+
+    if(n > 0) {
+        items[p] = last;
+    }
+
+    return best;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class keyType>
+bool indexedHeap<keyType>::before(std::size_t a, std::size_t b) const {
+    return keys[a] < keys[b] || (!(keys[b] < keys[a]) && a < b);
+}
+
+#endif /* H_INDEXEDHEAP */
@@ -0,0 +1,383 @@
+/// @brief Implementation file for the libgantt.so C interface
+/// @file libgantt.cpp
+
+#include "libgantt.h"
+#include "ganttUtils.h"
+
+#include <cstdio>
+#include <new>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/// ----------------------------------------------------------------------------
+/// @brief Project behind the opaque C handle, whatever its storage layout.
+/// ----------------------------------------------------------------------------
+struct ganttProject {
+    virtual ~ganttProject() {}
+    virtual bool reduce(int threads) = 0;
+    virtual void topoSort() = 0;
+    virtual void criticalPath() = 0;
+    virtual void slackTimes() = 0;
+    virtual void articulationPoints() = 0;
+    virtual bool view(ganttResult result, ganttView& view) const = 0;
+    virtual void summarize(ganttSummary& summary) const = 0;
+};
+
+namespace {
+    // view element type of each storage type
+    template <class myType> ganttType typeOf();
+    template <> ganttType typeOf<uint32_t>() { return GANTT_UINT32; }
+    template <> ganttType typeOf<uint64_t>() { return GANTT_UINT64; }
+    template <> ganttType typeOf<int32_t>() { return GANTT_INT32; }
+    template <> ganttType typeOf<int64_t>() { return GANTT_INT64; }
+    template <> ganttType typeOf<double>() { return GANTT_DOUBLE; }
+
+    // ------------------------------------------------------------------------
+    // A ganttUtils of one layout; each analysis runs once, in the order
+    // projectInfo runs them.
+    // ------------------------------------------------------------------------
+    template <class idxType, class wgtType>
+    struct layoutProject : public ganttProject {
+        ganttUtils<idxType, wgtType> project;
+        wgtType duration;       // viewed as GANTT_DURATION
+        bool sorted;
+        bool critical;
+        bool slack;
+        bool articulation;
+
+        layoutProject() : duration(0), sorted(false), critical(false),
+                          slack(false), articulation(false) {}
+
+        bool reduce(int threads) {
+            if(sorted || critical || slack || articulation) {
+                return false;
+            }
+
+            project.reduceTasks(threads);
+
+            return true;
+        }
+
+        void topoSort() {
+            if(!sorted) {
+                project.topoSort();
+                sorted = true;
+            }
+        }
+
+        void criticalPath() {
+            if(!critical) {
+                project.criticalPath();
+                duration = project.getDuration();
+                critical = true;
+            }
+        }
+
+        void slackTimes() {
+            criticalPath();
+
+            if(!slack) {
+                project.findSlackTimes();
+                slack = true;
+            }
+        }
+
+        void articulationPoints() {
+            if(!articulation) {
+                project.findAPs();
+                articulation = true;
+            }
+        }
+
+        bool view(ganttResult result, ganttView& out) const {
+            std::size_t n = project.getMilestoneCount();
+
+            out.length = n;
+            out.type = typeOf<idxType>();
+
+            switch(result) {
+            case GANTT_DISTANCES:
+                out.data = project.getDistances();
+                out.type = typeOf<wgtType>();
+                return critical;
+            case GANTT_TOPO_ORDER:
+                out.data = project.getTopoOrder();
+                return sorted;
+            case GANTT_CRITICAL_PATH:
+                out.data = project.getCriticalPath();
+                out.length = project.getCriticalPathCount();
+                return critical;
+            case GANTT_SLACK_TIMES:
+                out.data = project.getSlackTimes();
+                out.type = typeOf<wgtType>();
+                return slack;
+            case GANTT_IN_DEGREES:
+                out.data = project.getInDegrees();
+                return true;
+            case GANTT_OUT_DEGREES:
+                out.data = project.getOutDegrees();
+                return true;
+            case GANTT_ARTICULATION:
+                out.data = project.getAPs();
+                out.type = GANTT_UINT8;
+                return articulation;
+            case GANTT_DURATION:
+                out.data = &duration;
+                out.length = 1;
+                out.type = typeOf<wgtType>();
+                return critical;
+            }
+
+            return false;
+        }
+
+        void summarize(ganttSummary& summary) const {
+            summary.milestones = project.getMilestoneCount();
+            summary.tasks = project.getTaskCount();
+            summary.sourceNode = project.getSourceNode();
+            summary.finalNode = critical ? project.getFinalNode()
+                                         : project.getSourceNode();
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // Loads a task file into the layout withLayout() picks.
+    // ------------------------------------------------------------------------
+    struct projectLoader {
+        std::string fileName;
+        int threads;
+        ganttProject *project;
+        ganttStatus status;
+
+        template <class idxType, class wgtType>
+        int run() {
+            layoutProject<idxType, wgtType> *loaded =
+                new layoutProject<idxType, wgtType>;
+
+            if(!loaded->project.readGraph(fileName, threads)) {
+                delete loaded;
+                status = GANTT_ERROR_FILE;
+                return 0;
+            }
+
+            if(loaded->project.hasWeightOverflow()) {
+                delete loaded;
+                return LAYOUT_TOO_NARROW;
+            }
+
+            if(!loaded->project.isValidProject()) {
+                delete loaded;
+                status = GANTT_ERROR_INVALID;
+                return 0;
+            }
+
+            project = loaded;
+            status = GANTT_OK;
+
+            return 0;
+        }
+    };
+
+    ganttStatus load(const std::string& fileName, int threads,
+                     ganttProject **project) {
+        ganttLayout layout;
+        projectLoader loader;
+
+        if(!readLayout(fileName, layout)) {
+            return GANTT_ERROR_FILE;
+        }
+
+        loader.fileName = fileName;
+        loader.threads = threads;
+        loader.project = nullptr;
+        loader.status = GANTT_ERROR_FILE;
+
+        try {
+            withLayout(layout, loader);
+        } catch(const std::bad_alloc&) {
+            delete loader.project;
+            return GANTT_ERROR_MEMORY;
+        }
+
+        *project = loader.project;
+
+        return loader.status;
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+int ganttAbiVersion(void) {
+    return GANTT_ABI_VERSION;
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttStatus ganttLoadFile(const char *fileName, int threads,
+                          ganttProject **project) {
+    if(fileName == nullptr || project == nullptr) {
+        return GANTT_ERROR_ARGUMENT;
+    }
+
+    *project = nullptr;
+
+    return load(fileName, threads, project);
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttStatus ganttLoadBuffer(const char *text, size_t bytes, int threads,
+                            ganttProject **project) {
+    char path[64];
+    ganttStatus status = GANTT_OK;
+    size_t written = 0;
+    int file = -1;
+
+    if(text == nullptr || project == nullptr) {
+        return GANTT_ERROR_ARGUMENT;
+    }
+
+    *project = nullptr;
+
+    // the reader wants a file, an anonymous one in memory will do
+    file = memfd_create("gantt", 0);
+
+    if(file < 0) {
+        return GANTT_ERROR_FILE;
+    }
+
+    while(written < bytes) {
+        ssize_t count = ::write(file, text + written, bytes - written);
+
+        if(count <= 0) {
+            ::close(file);
+            return GANTT_ERROR_FILE;
+        }
+
+        written += static_cast<size_t>(count);
+    }
+
+    snprintf(path, sizeof(path), "/proc/self/fd/%d", file);
+    status = load(path, threads, project);
+    ::close(file);
+
+    return status;
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttClose(ganttProject *project) {
+    delete project;
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttStatus ganttReduce(ganttProject *project, int threads) {
+    if(project == nullptr) {
+        return GANTT_ERROR_ARGUMENT;
+    }
+
+    try {
+        return project->reduce(threads) ? GANTT_OK : GANTT_ERROR_STATE;
+    } catch(const std::bad_alloc&) {
+        return GANTT_ERROR_MEMORY;
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttStatus ganttTopoSort(ganttProject *project) {
+    if(project == nullptr) {
+        return GANTT_ERROR_ARGUMENT;
+    }
+
+    try {
+        project->topoSort();
+    } catch(const std::bad_alloc&) {
+        return GANTT_ERROR_MEMORY;
+    }
+
+    return GANTT_OK;
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttStatus ganttCriticalPath(ganttProject *project) {
+    if(project == nullptr) {
+        return GANTT_ERROR_ARGUMENT;
+    }
+
+    try {
+        project->criticalPath();
+    } catch(const std::bad_alloc&) {
+        return GANTT_ERROR_MEMORY;
+    }
+
+    return GANTT_OK;
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttStatus ganttSlackTimes(ganttProject *project) {
+    if(project == nullptr) {
+        return GANTT_ERROR_ARGUMENT;
+    }
+
+    try {
+        project->slackTimes();
+    } catch(const std::bad_alloc&) {
+        return GANTT_ERROR_MEMORY;
+    }
+
+    return GANTT_OK;
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttStatus ganttArticulationPoints(ganttProject *project) {
+    if(project == nullptr) {
+        return GANTT_ERROR_ARGUMENT;
+    }
+
+    try {
+        project->articulationPoints();
+    } catch(const std::bad_alloc&) {
+        return GANTT_ERROR_MEMORY;
+    }
+
+    return GANTT_OK;
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttStatus ganttGetView(const ganttProject *project, ganttResult result,
+                         ganttView *view) {
+    if(project == nullptr || view == nullptr || result < GANTT_DISTANCES
+       || result > GANTT_DURATION) {
+        return GANTT_ERROR_ARGUMENT;
+    }
+
+    if(!project->view(result, *view)) {
+        view->data = nullptr;
+        view->length = 0;
+        return GANTT_ERROR_STATE;
+    }
+
+    return GANTT_OK;
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttStatus ganttSummarize(const ganttProject *project,
+                           ganttSummary *summary) {
+    if(project == nullptr || summary == nullptr) {
+        return GANTT_ERROR_ARGUMENT;
+    }
+
+    project->summarize(*summary);
+
+    return GANTT_OK;
+}
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,181 @@
+/// @brief C interface of the Gantt analysis library, libgantt.so
+/// @file libgantt.h
+
+#ifndef H_LIBGANTT
+#define H_LIBGANTT
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GANTT_API __attribute__((visibility("default")))
+
+/// ----------------------------------------------------------------------------
+/// @brief Interface version, raised whenever a declaration below changes
+/// in a way older callers would notice.  New enumerators are only ever
+/// appended.
+/// ----------------------------------------------------------------------------
+#define GANTT_ABI_VERSION 1
+
+/// ----------------------------------------------------------------------------
+/// @brief Project loaded from a task file (opaque).  Calls on different
+/// projects may run on different threads at once; calls on one project
+/// must not overlap.
+/// ----------------------------------------------------------------------------
+typedef struct ganttProject ganttProject;
+
+/// ----------------------------------------------------------------------------
+/// @brief Result of a call.
+/// ----------------------------------------------------------------------------
+typedef enum {
+    GANTT_OK = 0,           /// done
+    GANTT_ERROR_FILE,       /// task file or buffer can not be read
+    GANTT_ERROR_INVALID,    /// tasks form a cycle
+    GANTT_ERROR_STATE,      /// result not computed yet, or call too late
+    GANTT_ERROR_MEMORY,     /// out of memory
+    GANTT_ERROR_ARGUMENT    /// null or unknown argument
+} ganttStatus;
+
+/// ----------------------------------------------------------------------------
+/// @brief Element type of a result view, chosen per project by the
+/// narrowest storage the task file fits.
+/// ----------------------------------------------------------------------------
+typedef enum {
+    GANTT_UINT8 = 0,
+    GANTT_UINT32,
+    GANTT_UINT64,
+    GANTT_INT32,
+    GANTT_INT64,
+    GANTT_DOUBLE
+} ganttType;
+
+/// ----------------------------------------------------------------------------
+/// @brief Results that can be viewed.
+/// ----------------------------------------------------------------------------
+typedef enum {
+    GANTT_DISTANCES = 0,    /// early start of each milestone (critical path)
+    GANTT_TOPO_ORDER,       /// milestones in topological order (topo sort)
+    GANTT_CRITICAL_PATH,    /// final milestone first (critical path)
+    GANTT_SLACK_TIMES,      /// per milestone, -1 if none (slack times)
+    GANTT_IN_DEGREES,       /// in-degree of each milestone (load)
+    GANTT_OUT_DEGREES,      /// out-degree of each milestone (load)
+    GANTT_ARTICULATION,     /// 1 for articulation points (articulation)
+    GANTT_DURATION          /// one element, project duration (critical path)
+} ganttResult;
+
+/// ----------------------------------------------------------------------------
+/// @brief Read-only view into a project's own result array.  It stays valid
+/// until the project is closed or reduced.
+/// ----------------------------------------------------------------------------
+typedef struct {
+    const void *data;       /// first element
+    size_t length;          /// # of elements
+    ganttType type;         /// element type
+} ganttView;
+
+/// ----------------------------------------------------------------------------
+/// @brief Counts and milestones of a project.
+/// ----------------------------------------------------------------------------
+typedef struct {
+    uint64_t milestones;    /// # of milestones
+    uint64_t tasks;         /// # of tasks
+    uint64_t sourceNode;    /// source milestone
+    uint64_t finalNode;     /// final milestone, once the critical path is found
+} ganttSummary;
+
+/// ----------------------------------------------------------------------------
+/// @return GANTT_ABI_VERSION the library was built with
+/// ----------------------------------------------------------------------------
+GANTT_API int ganttAbiVersion(void);
+
+/// ----------------------------------------------------------------------------
+/// @brief Loads a task file (the projectInfo format, numbered milestones)
+/// and checks it for cycles.
+///
+/// @param fileName Task file
+/// @param threads Parser threads, 0 for the default
+/// @param project Receives the project, null unless GANTT_OK
+///
+/// @return GANTT_OK, GANTT_ERROR_FILE, GANTT_ERROR_INVALID or
+/// GANTT_ERROR_MEMORY
+/// ----------------------------------------------------------------------------
+GANTT_API ganttStatus ganttLoadFile(const char *fileName, int threads,
+                                    ganttProject **project);
+
+/// ----------------------------------------------------------------------------
+/// @brief Loads a task file held in memory, as ganttLoadFile().
+///
+/// @param text Task file contents
+/// @param bytes # of bytes of text
+/// @param threads Parser threads, 0 for the default
+/// @param project Receives the project, null unless GANTT_OK
+///
+/// @return As ganttLoadFile()
+/// ----------------------------------------------------------------------------
+GANTT_API ganttStatus ganttLoadBuffer(const char *text, size_t bytes,
+                                      int threads, ganttProject **project);
+
+/// ----------------------------------------------------------------------------
+/// @brief Frees a project and every view into it.
+///
+/// @param project Project, may be null
+/// ----------------------------------------------------------------------------
+GANTT_API void ganttClose(ganttProject *project);
+
+/// ----------------------------------------------------------------------------
+/// @brief Drops transitively redundant tasks (see ganttUtils::reduceTasks()).
+/// Only before any analysis.
+///
+/// @param project Project
+/// @param threads Worker threads, 0 for the default
+///
+/// @return GANTT_OK, or GANTT_ERROR_STATE after an analysis
+/// ----------------------------------------------------------------------------
+GANTT_API ganttStatus ganttReduce(ganttProject *project, int threads);
+
+/// ----------------------------------------------------------------------------
+/// @brief Each analysis runs the ones it needs first and does nothing if
+/// it already ran: the topological sort, the critical path (with the
+/// distances), the slack times (after the critical path) and the
+/// articulation points.
+///
+/// @param project Project
+///
+/// @return GANTT_OK, GANTT_ERROR_MEMORY or GANTT_ERROR_ARGUMENT
+/// ----------------------------------------------------------------------------
+GANTT_API ganttStatus ganttTopoSort(ganttProject *project);
+GANTT_API ganttStatus ganttCriticalPath(ganttProject *project);
+GANTT_API ganttStatus ganttSlackTimes(ganttProject *project);
+GANTT_API ganttStatus ganttArticulationPoints(ganttProject *project);
+
+/// ----------------------------------------------------------------------------
+/// @brief Views a result without copying it.
+///
+/// @param project Project
+/// @param result Result
+/// @param view Receives the view
+///
+/// @return GANTT_OK, or GANTT_ERROR_STATE if its analysis has not run
+/// ----------------------------------------------------------------------------
+GANTT_API ganttStatus ganttGetView(const ganttProject *project,
+                                   ganttResult result, ganttView *view);
+
+/// ----------------------------------------------------------------------------
+/// @brief Counts and milestones of a project.
+///
+/// @param project Project
+/// @param summary Receives the summary
+///
+/// @return GANTT_OK or GANTT_ERROR_ARGUMENT
+/// ----------------------------------------------------------------------------
+GANTT_API ganttStatus ganttSummarize(const ganttProject *project,
+                                     ganttSummary *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H_LIBGANTT */
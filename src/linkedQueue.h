@@ -8,6 +8,7 @@
 
 #include <iostream>
 #define SIZE 32000    /// size of array in node 
+#define CACHED_NODES 4    /// max released nodes kept per thread for reuse
 
 /// ----------------------------------------------------------------------------
 /// @brief queueNode for nodes in linked list modelled as a queue
@@ -20,6 +21,26 @@ struct queueNode {
     queueNode<myType> *link;    /// link to next node
 };
 
+/// ----------------------------------------------------------------------------
+/// @brief queueNodeCache keeps released nodes of one thread for reuse and
+/// frees them when the thread exits
+/// ----------------------------------------------------------------------------
+template <class myType>
+struct queueNodeCache {
+    queueNode<myType> *head;    /// first cached node
+    int count;                  /// # of cached nodes
+    
+    queueNodeCache() : head(nullptr), count(0) {}
+    
+    ~queueNodeCache() {
+        while(head != nullptr) {
+            queueNode<myType> *temp = head;
+            head = head->link;
+            delete temp;
+        }
+    }
+};
+
 /// ----------------------------------------------------------------------------
 /// @class linkedQueue
 ///
@@ -33,6 +54,23 @@ private:
     queueNode<myType> *queueRear;     /// pointer to last node
     int count;                        /// number of elements in linked list
     
+    /// per-thread cache of released nodes, reused by later queues so that
+    /// repeated analyses on a thread do not reallocate 128 KB nodes
+    static thread_local queueNodeCache<myType> freeNodes;
+    
+    /// ------------------------------------------------------------------------
+    /// @return Node taken from the thread's cache, or a newly allocated one
+    /// ------------------------------------------------------------------------
+    static queueNode<myType>* allocNode();
+    
+    /// ------------------------------------------------------------------------
+    /// @brief Returns a node to the thread's cache, or deletes it if the
+    /// cache is full.
+    ///
+    /// @param node Node to release
+    /// ------------------------------------------------------------------------
+    static void releaseNode(queueNode<myType> *node);
+    
 public:
     /// ------------------------------------------------------------------------
     /// @brief (Constructor) Initializes the queue to an empty state (sets 
@@ -94,6 +132,37 @@ public:
 /// FUNCTION DEFINITIONS
 /// ----------------------------------------------------------------------------
 
+template <class myType>
+thread_local queueNodeCache<myType> linkedQueue<myType>::freeNodes;
+
+/// ----------------------------------------------------------------------------
+
+template <class myType>
+queueNode<myType>* linkedQueue<myType>::allocNode() {
+    if(freeNodes.head == nullptr) {
+        return new queueNode<myType>;
+    }
+    
+    queueNode<myType> *node = freeNodes.head;
+    freeNodes.head = node->link;
+    freeNodes.count--;
+    
+    return node;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class myType>
+void linkedQueue<myType>::releaseNode(queueNode<myType> *node) {
+    if(freeNodes.count < CACHED_NODES) {
+        node->link = freeNodes.head;
+        freeNodes.head = node;
+        freeNodes.count++;
+    } else {
+        delete node;
+    }
+}
+
 template <class myType>
 linkedQueue<myType>::linkedQueue() {
     queueFront = nullptr;
@@ -111,7 +180,7 @@ linkedQueue<myType>::~linkedQueue() {
     while(queueFront != nullptr) {
         temp = queueFront;
         queueFront = queueFront->link;
-        delete temp;
+        releaseNode(temp);
     }
     
     queueRear = nullptr;
@@ -137,7 +206,7 @@ void linkedQueue<myType>::initializeQueue() {
     while(queueFront != nullptr) {
         temp = queueFront;
         queueFront = queueFront->link;
-        delete temp;
+        releaseNode(temp);
     }
     
     queueRear = nullptr;
@@ -150,11 +219,14 @@ void linkedQueue<myType>::initializeQueue() {
 
 template <class myType>
 void linkedQueue<myType>::addItem(const myType& newItem) {
-    int arraySize = count % SIZE;
+    // the rear node is full once its back is right behind its front; only
+    // the front node is ever drained, so count alone can not tell
+    bool rearFull = !isEmptyQueue() 
+                    && (queueRear->back + 1) % SIZE == queueRear->front;
     
     // if queue is empty, create node
     if(isEmptyQueue()) {
-        queueNode<myType> *newNode = new queueNode<myType>;
+        queueNode<myType> *newNode = allocNode();
         newNode->dataSet[0] = newItem;
         newNode->front = 0;
         newNode->back = 0;
@@ -163,8 +235,8 @@ void linkedQueue<myType>::addItem(const myType& newItem) {
         queueRear = newNode;
         newNode = nullptr;
     // if current node is full
-    } else if(!arraySize) {
-        queueNode<myType> *newNode = new queueNode<myType>;
+    } else if(rearFull) {
+        queueNode<myType> *newNode = allocNode();
         newNode->dataSet[0] = newItem;
         newNode->front = 0;
         newNode->back = 0;
@@ -211,7 +283,7 @@ void linkedQueue<myType>::deleteItem() {
 		if(queueFront->link == nullptr) {
             // if there's only one element in it
             if(count == 1) {
-                delete queueFront;
+                releaseNode(queueFront);
                 queueFront = nullptr;
                 queueRear = nullptr;
             } else {
@@ -227,7 +299,7 @@ void linkedQueue<myType>::deleteItem() {
             if(queueFront->front == queueFront->back) {
                 queueNode<myType> *temp = queueFront;
                 queueFront = queueFront->link;
-                delete temp;
+                releaseNode(temp);
                 temp = nullptr;
             } else {
                 // if current front is at the end of the array
@@ -258,14 +330,15 @@ void linkedQueue<myType>::printQueue() {
     using namespace std;
     
     queueNode<myType> *temp = queueFront;
-    int f = 0;
-    int b = 0;
+    int i = 0;
     
+    // each node is a ring from front round to back
     while(temp != nullptr) {
-       f = temp->front;
-       b = temp->back;
+       i = temp->front;
+       cout << temp->dataSet[i] << ' ';
        
-       for(int i = f; i <= b && i < SIZE; i++) {
+       while(i != temp->back) {
+           i = (i + 1) % SIZE;
            cout << temp->dataSet[i] << ' ';
        }
        
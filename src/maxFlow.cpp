@@ -0,0 +1,197 @@
+/// @brief Implementation file for class maxFlow
+/// @file maxFlow.cpp
+
+#include "maxFlow.h"
+
+#include <algorithm>
+
+namespace {
+    const std::size_t NONE = static_cast<std::size_t>(-1);   // no arc
+}
+
+const int64_t maxFlow::INFINITE;
+
+void maxFlow::reset(std::size_t nodes) {
+    head.assign(nodes, NONE);
+    level.assign(nodes, -1);
+    current.assign(nodes, NONE);
+    link.clear();
+    to.clear();
+    residual.clear();
+    lower.clear();
+}
+
+/// ----------------------------------------------------------------------------
+
+void maxFlow::addArc(std::size_t from, std::size_t dest, int64_t capacity,
+                     int64_t minimum) {
+    // arc a and its reverse a ^ 1 are adjacent
+    lower.push_back(minimum);
+    to.push_back(dest);
+    residual.push_back(capacity);
+    link.push_back(head[from]);
+    head[from] = to.size() - 1;
+
+    to.push_back(from);
+    residual.push_back(0);
+    link.push_back(head[dest]);
+    head[dest] = to.size() - 1;
+}
+
+/// ----------------------------------------------------------------------------
+
+int64_t maxFlow::solve(std::size_t source, std::size_t sink) {
+    std::size_t nodes = head.size();
+    std::size_t arcs = to.size();
+    std::vector<int64_t> excess(nodes, 0);
+    int64_t demand = 0;
+    int64_t flow = 0;
+
+    // lower bounds become demands, the arcs keep the rest of their capacity
+    for(std::size_t a = 0; a < arcs; a += 2) {
+        if(lower[a / 2] > 0) {
+            residual[a] -= lower[a / 2];
+            excess[to[a]] += lower[a / 2];
+            excess[to[a ^ 1]] -= lower[a / 2];
+        }
+    }
+
+    for(std::size_t v = 0; v < nodes; v++) {
+        demand += std::max(excess[v], int64_t(0));
+    }
+
+    if(demand > 0) {
+        head.resize(nodes + 2, NONE);
+        level.resize(nodes + 2, -1);
+        addArc(sink, source, INFINITE);
+
+        for(std::size_t v = 0; v < nodes; v++) {
+            if(excess[v] > 0) {
+                addArc(nodes, v, excess[v]);
+            } else if(excess[v] < 0) {
+                addArc(v, nodes + 1, -excess[v]);
+            }
+        }
+
+        if(flowBetween(nodes, nodes + 1, demand) < demand) {
+            return -1;
+        }
+
+        // flow already on its way from source to sink, then drop the helper
+        // arcs (added last, so first in each list)
+        flow = residual[arcs + 1];
+
+        for(std::size_t v = 0; v < nodes; v++) {
+            while(head[v] != NONE && head[v] >= arcs) {
+                head[v] = link[head[v]];
+            }
+        }
+
+        head.resize(nodes);
+        level.resize(nodes);
+        link.resize(arcs);
+        to.resize(arcs);
+        residual.resize(arcs);
+        lower.resize(arcs / 2);
+    }
+
+    flow += flowBetween(source, sink, INFINITE - flow);
+
+    // an uncapacitated cut less some lower bounds is still uncapacitated
+    return (flow > INFINITE / 2) ? INFINITE : flow;
+}
+
+/// ----------------------------------------------------------------------------
+
+int64_t maxFlow::flowBetween(std::size_t source, std::size_t sink,
+                             int64_t limit) {
+    int64_t flow = 0;
+    int64_t pushed = 0;
+
+    while(flow < limit && layer(source, sink)) {
+        current = head;
+
+        while(flow < limit
+              && (pushed = augment(source, sink, limit - flow)) > 0) {
+            flow += pushed;
+        }
+    }
+
+    return flow;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool maxFlow::sourceSide(std::size_t v) const {
+    return level[v] >= 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool maxFlow::layer(std::size_t source, std::size_t sink) {
+    std::vector<std::size_t> queue(1, source);
+
+    std::fill(level.begin(), level.end(), -1);
+    level[source] = 0;
+
+    for(std::size_t i = 0; i < queue.size(); i++) {
+        std::size_t v = queue[i];
+
+        for(std::size_t a = head[v]; a != NONE; a = link[a]) {
+            if(residual[a] > 0 && level[to[a]] < 0) {
+                level[to[a]] = level[v] + 1;
+                queue.push_back(to[a]);
+            }
+        }
+    }
+
+    return level[sink] >= 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+int64_t maxFlow::augment(std::size_t source, std::size_t sink,
+                         int64_t limit) {
+    std::size_t v = source;
+    int64_t pushed = limit;
+
+    path.clear();
+
+    while(v != sink) {
+        std::size_t& a = current[v];
+
+        while(a != NONE && (residual[a] == 0 || level[to[a]] != level[v] + 1)) {
+            a = link[a];
+        }
+
+        if(a != NONE) {
+            path.push_back(a);
+            v = to[a];
+            continue;
+        }
+
+        // dead end, never entered again in this phase
+        level[v] = -1;
+
+        if(path.empty()) {
+            return 0;
+        }
+
+        v = to[path.back() ^ 1];
+        current[v] = link[current[v]];
+        path.pop_back();
+    }
+
+    for(std::size_t i = 0; i < path.size(); i++) {
+        pushed = std::min(pushed, residual[path[i]]);
+    }
+
+    for(std::size_t i = 0; i < path.size(); i++) {
+        residual[path[i]] -= pushed;
+        residual[path[i] ^ 1] += pushed;
+    }
+
+    return pushed;
+}
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,107 @@
+/// @brief Header file for class maxFlow
+/// @file maxFlow.h
+
+#ifndef H_MAXFLOW
+#define H_MAXFLOW
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// ----------------------------------------------------------------------------
+/// @class maxFlow
+///
+/// @brief Maximum flow and minimum cut of a network with integer capacities
+/// and optional lower bounds (Dinic's algorithm).  Lower bounds are met
+/// first by a flow between a super source and a super sink with the sink
+/// joined back to the source, which the source-to-sink flow then extends;
+/// the minimum cut then counts the capacity of its forward arcs less the
+/// lower bounds of its backward arcs.  Each phase layers the residual network by a
+/// breadth-first search from the source and saturates it with augmenting
+/// paths found by an iterative depth-first search (no recursion, so paths
+/// may be as long as the network), skipping arcs already found to be dead
+/// ends.  Flows are capped at INFINITE, so a network whose every cut holds
+/// an uncapacitated arc is reported as such rather than overflowing.
+/// ----------------------------------------------------------------------------
+class maxFlow {
+public:
+    /// capacity of an arc that can not be cut
+    static const int64_t INFINITE = INT64_MAX / 4;
+
+private:
+    std::vector<std::size_t> head;    /// first arc of each node, NONE if none
+    std::vector<std::size_t> link;    /// next arc of the same node
+    std::vector<std::size_t> to;      /// head of each arc
+    std::vector<int64_t> residual;    /// residual capacity of each arc
+    std::vector<int64_t> lower;       /// lower bound of each arc pair
+    std::vector<int> level;           /// BFS level, -1 if not reached
+    std::vector<std::size_t> current; /// next arc to try in the DFS
+    std::vector<std::size_t> path;    /// arcs of the current DFS path
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief Clears the network.
+    ///
+    /// @param nodes # of nodes
+    void reset(std::size_t nodes);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Adds an arc and its (empty) reverse residual arc.
+    ///
+    /// @param from Tail
+    /// @param dest Head
+    /// @param capacity Capacity, at most INFINITE
+    /// @param minimum Lower bound on the flow, at most capacity
+    void addArc(std::size_t from, std::size_t dest, int64_t capacity,
+                int64_t minimum = 0);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Finds the maximum flow, once all the arcs are added (the
+    /// residual network is kept for sourceSide()).
+    ///
+    /// @param source Source node
+    /// @param sink Sink node
+    ///
+    /// @return Maximum flow from source to sink, INFINITE if every cut has
+    /// an arc of capacity INFINITE, -1 if the lower bounds can not be met
+    int64_t solve(std::size_t source, std::size_t sink);
+
+    /// -----------------------------------------------------------------------
+    /// @param v Node
+    ///
+    /// @return True if v is on the source side of the minimum cut found by
+    /// solve() (if it returned less than INFINITE)
+    bool sourceSide(std::size_t v) const;
+
+private:
+    /// -----------------------------------------------------------------------
+    /// @brief Pushes flow from source to sink, phase by phase.
+    ///
+    /// @param source Source node
+    /// @param sink Sink node
+    /// @param limit Most flow to push
+    ///
+    /// @return Flow pushed
+    int64_t flowBetween(std::size_t source, std::size_t sink, int64_t limit);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Levels the residual network from the source.
+    ///
+    /// @param source Source node
+    /// @param sink Sink node
+    ///
+    /// @return True if the sink is reached
+    bool layer(std::size_t source, std::size_t sink);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Pushes flow along one augmenting path of the layered network.
+    ///
+    /// @param source Source node
+    /// @param sink Sink node
+    /// @param limit Most flow to push
+    ///
+    /// @return Flow pushed, 0 if the layered network is saturated
+    int64_t augment(std::size_t source, std::size_t sink, int64_t limit);
+};
+
+#endif /* H_MAXFLOW */
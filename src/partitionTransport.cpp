@@ -0,0 +1,178 @@
+/// @brief Implementation file for class sharedMemoryTransport
+/// @file partitionTransport.cpp
+
+#include "partitionTransport.h"
+
+#include <atomic>
+#include <new>
+#include <pthread.h>
+#include <sys/mman.h>
+
+/// ----------------------------------------------------------------------------
+/// @brief Start of the shared mapping, followed by the mailbox counts and
+/// buffers.
+/// ----------------------------------------------------------------------------
+struct sharedMemoryTransport::sharedHeader {
+    pthread_barrier_t barrier;          /// end of a superstep
+    std::atomic<long> total[3];         /// values sent, by superstep % 3
+};
+
+/// ----------------------------------------------------------------------------
+
+sharedMemoryTransport::sharedMemoryTransport() {
+    header = nullptr;
+    mapBytes = 0;
+    parts = 0;
+    counts = nullptr;
+    values = nullptr;
+    step = 0;
+    sent = 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+sharedMemoryTransport::~sharedMemoryTransport() {
+    close();
+}
+
+/// ----------------------------------------------------------------------------
+
+bool sharedMemoryTransport::open(int partCount,
+                                 const std::vector<std::size_t>& capacity) {
+    std::size_t boxes = static_cast<std::size_t>(partCount) * partCount;
+    std::size_t slots = 0;
+    std::size_t countBytes = 0;
+    pthread_barrierattr_t attr;
+    void *map = nullptr;
+
+    close();
+
+    if(partCount <= 0 || capacity.size() != boxes) {
+        return false;
+    }
+
+    parts = partCount;
+    boxStart.resize(boxes);
+    boxSize.resize(boxes);
+
+    // two buffers per mailbox, even supersteps first
+    for(std::size_t b = 0; b < boxes; b++) {
+        boxStart[b] = slots;
+        boxSize[b] = capacity[b];
+        slots += 2 * capacity[b];
+    }
+
+    countBytes = (2 * boxes * sizeof(uint64_t) + sizeof(boundaryValue) - 1)
+                 / sizeof(boundaryValue) * sizeof(boundaryValue);
+    mapBytes = sizeof(sharedHeader) + countBytes
+               + slots * sizeof(boundaryValue);
+    map = mmap(nullptr, mapBytes, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if(map == MAP_FAILED) {
+        mapBytes = 0;
+        return false;
+    }
+
+    // the mapping starts zeroed, so are the counts and totals
+    header = new (map) sharedHeader;
+    counts = reinterpret_cast<uint64_t*>(header + 1);
+    values = reinterpret_cast<boundaryValue*>(
+                 reinterpret_cast<char*>(counts) + countBytes);
+
+    for(int i = 0; i < 3; i++) {
+        header->total[i].store(0);
+    }
+
+    pthread_barrierattr_init(&attr);
+    pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+
+    if(pthread_barrier_init(&header->barrier, &attr, parts) != 0) {
+        pthread_barrierattr_destroy(&attr);
+        munmap(map, mapBytes);
+        header = nullptr;
+        mapBytes = 0;
+        return false;
+    }
+
+    pthread_barrierattr_destroy(&attr);
+    step = 0;
+    sent = 0;
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+void sharedMemoryTransport::send(int from, int to, const boundaryValue& value) {
+    std::size_t box = static_cast<std::size_t>(from) * parts + to;
+    uint64_t& count = counts[2 * box + step % 2];
+
+    values[boxStart[box] + (step % 2) * boxSize[box] + count] = value;
+    count++;
+    sent++;
+}
+
+/// ----------------------------------------------------------------------------
+
+long sharedMemoryTransport::exchange(int part) {
+    long total = 0;
+    int result = 0;
+
+    header->total[step % 3] += sent;
+
+    // last used two supersteps ago, every partition has read it since
+    if(part == 0) {
+        header->total[(step + 1) % 3].store(0);
+    }
+
+    result = pthread_barrier_wait(&header->barrier);
+
+    if(result != 0 && result != PTHREAD_BARRIER_SERIAL_THREAD) {
+        return -1;
+    }
+
+    total = header->total[step % 3].load();
+
+    // the receivers read the other buffers in the last superstep, and
+    // have all passed the barrier since
+    for(int to = 0; to < parts; to++) {
+        std::size_t box = static_cast<std::size_t>(part) * parts + to;
+
+        counts[2 * box + (step + 1) % 2] = 0;
+    }
+
+    step++;
+    sent = 0;
+
+    return total;
+}
+
+/// ----------------------------------------------------------------------------
+
+std::size_t sharedMemoryTransport::receive(int part, int from,
+                                           const boundaryValue*& received) {
+    std::size_t box = static_cast<std::size_t>(from) * parts + part;
+    long last = step - 1;
+
+    received = values + boxStart[box] + (last % 2) * boxSize[box];
+
+    return last < 0 ? 0 : static_cast<std::size_t>(counts[2 * box + last % 2]);
+}
+
+/// ----------------------------------------------------------------------------
+
+void sharedMemoryTransport::close() {
+    if(header == nullptr) {
+        return;
+    }
+
+    pthread_barrier_destroy(&header->barrier);
+    munmap(header, mapBytes);
+    header = nullptr;
+    counts = nullptr;
+    values = nullptr;
+    mapBytes = 0;
+}
+
+/// ----------------------------------------------------------------------------
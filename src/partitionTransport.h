@@ -0,0 +1,121 @@
+/// @brief Header file for classes partitionTransport and sharedMemoryTransport
+/// @file partitionTransport.h
+
+#ifndef H_PARTITIONTRANSPORT
+#define H_PARTITIONTRANSPORT
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// ----------------------------------------------------------------------------
+/// @brief Boundary value sent to the partition owning a milestone.
+/// ----------------------------------------------------------------------------
+struct boundaryValue {
+    uint64_t milestone;     /// milestone owned by the receiver
+    int64_t value;          /// distance found by the sender
+};
+
+/// ----------------------------------------------------------------------------
+/// @class partitionTransport
+///
+/// @brief Message layer of the bulk-synchronous partitioned analysis (see
+/// ganttPartitioned).  In each superstep every partition sends boundary
+/// values, then calls exchange(), which returns once all partitions have
+/// sent theirs; the values sent to a partition in that superstep can then
+/// be read with receive() until its next exchange().  open() is called
+/// once, before the partition workers start, so an implementation may set
+/// up state the workers inherit.
+/// ----------------------------------------------------------------------------
+class partitionTransport {
+public:
+    virtual ~partitionTransport() {}
+
+    /// -----------------------------------------------------------------------
+    /// @brief Sets up the mailboxes.
+    ///
+    /// @param parts # of partitions
+    /// @param capacity Most values partition i sends partition j in one
+    /// superstep, at [i * parts + j]
+    ///
+    /// @return True if the transport can be used
+    virtual bool open(int parts, const std::vector<std::size_t>& capacity) = 0;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Sends a value, delivered at the next exchange().
+    ///
+    /// @param from Sending partition
+    /// @param to Receiving partition
+    /// @param value Boundary value
+    virtual void send(int from, int to, const boundaryValue& value) = 0;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Ends a superstep: waits for every partition.
+    ///
+    /// @param part Calling partition
+    ///
+    /// @return # of values sent by all partitions in the superstep, -1 if
+    /// the exchange failed
+    virtual long exchange(int part) = 0;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Values delivered to a partition by the last exchange().
+    ///
+    /// @param part Receiving partition
+    /// @param from Sending partition
+    /// @param values Receives the first value
+    ///
+    /// @return # of values
+    virtual std::size_t receive(int part, int from,
+                                const boundaryValue*& values) = 0;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Frees the mailboxes, once every worker has finished.
+    virtual void close() = 0;
+};
+
+/// ----------------------------------------------------------------------------
+/// @class sharedMemoryTransport
+///
+/// @brief partitionTransport for worker processes forked on one host.  Each
+/// ordered pair of partitions has a mailbox in an anonymous shared mapping
+/// made by open(), with one buffer for even and one for odd supersteps, so
+/// a partition can fill the next superstep's buffer while a slower one
+/// still reads the last.  Supersteps end at a process-shared barrier, and
+/// the # of values sent is summed in one of three shared counters, the one
+/// two supersteps ahead being cleared for reuse.
+/// ----------------------------------------------------------------------------
+class sharedMemoryTransport : public partitionTransport {
+private:
+    struct sharedHeader;
+
+    sharedHeader *header;       /// barrier and counters, start of the mapping
+    std::size_t mapBytes;       /// size of the mapping
+    int parts;                  /// # of partitions
+    std::vector<std::size_t> boxStart;  /// first value of each mailbox
+    std::vector<std::size_t> boxSize;   /// capacity of each mailbox
+    uint64_t *counts;           /// values in each mailbox buffer
+    boundaryValue *values;      /// mailbox buffers
+    long step;                  /// supersteps ended by this process
+    long sent;                  /// values sent in the current superstep
+
+    sharedMemoryTransport(const sharedMemoryTransport&);
+    sharedMemoryTransport& operator=(const sharedMemoryTransport&);
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Initializes a transport that is not open.
+    sharedMemoryTransport();
+
+    /// -----------------------------------------------------------------------
+    /// @brief (Destructor) Closes the transport.
+    ~sharedMemoryTransport();
+
+    bool open(int parts, const std::vector<std::size_t>& capacity);
+    void send(int from, int to, const boundaryValue& value);
+    long exchange(int part);
+    std::size_t receive(int part, int from, const boundaryValue*& values);
+    void close();
+};
+
+#endif /* H_PARTITIONTRANSPORT */
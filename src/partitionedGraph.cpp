@@ -0,0 +1,632 @@
+/// @brief Implementation file for class ganttPartitioned
+/// @file partitionedGraph.cpp
+
+#include "partitionedGraph.h"
+#include "taskStream.h"
+
+#include <algorithm>
+#include <csignal>
+#include <fstream>
+#include <iomanip>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+ganttPartitioned::ganttPartitioned() {
+    milestoneCount = 0;
+    taskCount = 0;
+    sourceNode = 0;
+    parts = 0;
+    partsAsked = 0;
+    early = nullptr;
+    tail = nullptr;
+    stats = nullptr;
+    sharedBytes = 0;
+    finalNode = 0;
+    duration = 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+ganttPartitioned::~ganttPartitioned() {
+    if(early != nullptr) {
+        munmap(early, sharedBytes);
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+bool ganttPartitioned::readGraph(const std::string fileName) {
+    using namespace std;
+
+    string ignore;
+    vector<int> from;
+    vector<int> to;
+    vector<long long> weight;
+    vector<long> next;
+    int u = 0;
+    int v = 0;
+    long long w = 0;
+
+    taskStream inFile(fileName);
+
+    if(!inFile) {
+        return false;
+    }
+
+    getline(inFile, title, '\n');
+
+    if(title.substr(0, 6) == "title:") {
+        title.erase(0, 6);
+    }
+
+    inFile >> ignore >> milestoneCount;
+    inFile >> ignore >> sourceNode;
+
+    if(milestoneCount <= 0) {
+        return false;
+    }
+
+    outStart.assign(milestoneCount + 1, 0);
+    inStart.assign(milestoneCount + 1, 0);
+
+    // a task replaces the last one of its source if both have the same
+    // destination, as addEdge does with the head of the list
+    vector<long> lastTask(milestoneCount, -1);
+
+    while(inFile >> u >> v >> w) {
+        if(u < milestoneCount && v < milestoneCount && u >= 0 && v >= 0
+           && u != v) {
+            if(lastTask[u] != -1 && to[lastTask[u]] == v) {
+                weight[lastTask[u]] = w;
+                continue;
+            }
+
+            lastTask[u] = static_cast<long>(from.size());
+            from.push_back(u);
+            to.push_back(v);
+            weight.push_back(w);
+            outStart[u + 1]++;
+            inStart[v + 1]++;
+        }
+    }
+
+    if(inFile.isCorrupt()) {
+        return false;
+    }
+
+    taskCount = static_cast<long>(from.size());
+
+    // counts to offsets, then place the tasks in file order
+    for(int m = 0; m < milestoneCount; m++) {
+        outStart[m + 1] += outStart[m];
+        inStart[m + 1] += inStart[m];
+    }
+
+    outTo.resize(taskCount);
+    outWeight.resize(taskCount);
+    inFrom.resize(taskCount);
+    inWeight.resize(taskCount);
+    next.assign(outStart.begin(), outStart.end() - 1);
+
+    vector<long> inNext(inStart.begin(), inStart.end() - 1);
+
+    for(long e = 0; e < taskCount; e++) {
+        outTo[next[from[e]]] = to[e];
+        outWeight[next[from[e]]++] = weight[e];
+        inFrom[inNext[to[e]]] = from[e];
+        inWeight[inNext[to[e]]++] = weight[e];
+    }
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool ganttPartitioned::partition(int partCount) {
+    std::vector<int> indeg(milestoneCount, 0);
+    std::vector<int> level(milestoneCount, 0);
+    std::vector<long> levelStart;
+    std::vector<long> levelCount;
+    long done = 0;
+    long share = 0;
+    int levels = 0;
+
+    parts = partCount;
+    partsAsked = partCount;
+
+    for(long e = 0; e < taskCount; e++) {
+        indeg[outTo[e]]++;
+    }
+
+    // Kahn's algorithm, a milestone's level is its longest # of tasks
+    // from a start
+    order.clear();
+    order.reserve(milestoneCount);
+
+    for(int v = 0; v < milestoneCount; v++) {
+        if(indeg[v] == 0) {
+            order.push_back(v);
+        }
+    }
+
+    for(std::size_t head = 0; head < order.size(); head++) {
+        int v = order[head];
+
+        for(long e = outStart[v]; e < outStart[v + 1]; e++) {
+            int u = outTo[e];
+
+            level[u] = std::max(level[u], level[v] + 1);
+
+            if(--indeg[u] == 0) {
+                order.push_back(u);
+            }
+        }
+
+        levels = std::max(levels, level[v] + 1);
+    }
+
+    if(static_cast<int>(order.size()) != milestoneCount) {
+        return false;
+    }
+
+    // counting sort by level, keeping the topological order within one
+    levelStart.assign(levels + 1, 0);
+    levelCount.assign(levels, 0);
+
+    for(int v = 0; v < milestoneCount; v++) {
+        levelStart[level[v] + 1]++;
+        levelCount[level[v]] += 1 + outStart[v + 1] - outStart[v];
+    }
+
+    for(int l = 0; l < levels; l++) {
+        levelStart[l + 1] += levelStart[l];
+    }
+
+    std::vector<long> place(levelStart.begin(), levelStart.end() - 1);
+    std::vector<int> byLevel(milestoneCount);
+
+    for(std::size_t i = 0; i < order.size(); i++) {
+        byLevel[place[level[order[i]]]++] = order[i];
+    }
+
+    order.swap(byLevel);
+
+    // cut at the level where the running # of milestones and tasks passes
+    // each partition's share
+    partStart.assign(parts + 1, milestoneCount);
+    partStart[0] = 0;
+    owner.assign(milestoneCount, 0);
+    share = (static_cast<long>(milestoneCount) + taskCount + parts - 1) / parts;
+
+    for(int l = 0, p = 0; l < levels; l++) {
+        for(long i = levelStart[l]; i < levelStart[l + 1]; i++) {
+            owner[order[i]] = p;
+        }
+
+        done += levelCount[l];
+
+        while(p < parts - 1 && done >= share * (p + 1)) {
+            partStart[++p] = levelStart[l + 1];
+        }
+    }
+
+    // drop the empty ranges (more partitions than levels, or several shares
+    // passed in one level) so every worker owns at least one milestone
+    std::vector<int> renumber(parts, 0);
+    int used = 0;
+
+    for(int p = 0; p < parts; p++) {
+        renumber[p] = used;
+
+        if(partStart[p] < partStart[p + 1]) {
+            partStart[used++] = partStart[p];
+        }
+    }
+
+    partStart[used] = milestoneCount;
+    partStart.resize(used + 1);
+    parts = used;
+
+    for(int v = 0; v < milestoneCount; v++) {
+        owner[v] = renumber[owner[v]];
+    }
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttPartitioned::findBoundary(int part, bool forward,
+                                    std::vector<int>& remote) const {
+    const std::vector<long>& start = forward ? outStart : inStart;
+    const std::vector<int>& ends = forward ? outTo : inFrom;
+
+    remote.clear();
+
+    for(long i = partStart[part]; i < partStart[part + 1]; i++) {
+        int v = order[i];
+
+        for(long e = start[v]; e < start[v + 1]; e++) {
+            if(owner[ends[e]] != part) {
+                remote.push_back(ends[e]);
+            }
+        }
+    }
+
+    std::sort(remote.begin(), remote.end());
+    remote.erase(std::unique(remote.begin(), remote.end()), remote.end());
+}
+
+/// ----------------------------------------------------------------------------
+
+bool ganttPartitioned::runPartitions(partitionTransport& transport) {
+    std::vector<std::size_t> capacity(static_cast<std::size_t>(parts) * parts,
+                                      0);
+    std::vector<std::size_t> passCount(capacity.size());
+    std::vector<int> remote;
+    std::vector<pid_t> workers(parts, -1);
+    std::size_t bytes = 2 * milestoneCount * sizeof(long long)
+                        + parts * sizeof(partitionStats);
+    void *map = nullptr;
+    bool ok = true;
+
+    // a mailbox holds at most one value per boundary milestone and pass
+    for(int pass = 0; pass < 2; pass++) {
+        std::fill(passCount.begin(), passCount.end(), 0);
+
+        for(int p = 0; p < parts; p++) {
+            findBoundary(p, pass == 0, remote);
+
+            for(std::size_t i = 0; i < remote.size(); i++) {
+                passCount[static_cast<std::size_t>(p) * parts
+                          + owner[remote[i]]]++;
+            }
+        }
+
+        for(std::size_t b = 0; b < capacity.size(); b++) {
+            capacity[b] = std::max(capacity[b], passCount[b]);
+        }
+    }
+
+    map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if(map == MAP_FAILED || !transport.open(parts, capacity)) {
+        if(map != MAP_FAILED) {
+            munmap(map, bytes);
+        }
+
+        return false;
+    }
+
+    early = static_cast<long long*>(map);
+    tail = early + milestoneCount;
+    stats = reinterpret_cast<partitionStats*>(tail + milestoneCount);
+    sharedBytes = bytes;
+
+    // the children must not repeat buffered output
+    std::cout.flush();
+
+    for(int p = 0; p < parts && ok; p++) {
+        workers[p] = fork();
+
+        if(workers[p] == 0) {
+            partitionStats work = {0, 0, 0};
+            bool done = relaxPartition(p, true, transport, work.forwardSteps,
+                                       work.messages)
+                        && relaxPartition(p, false, transport,
+                                          work.backwardSteps, work.messages);
+
+            stats[p] = work;
+            _exit(done ? 0 : 1);
+        }
+
+        ok = workers[p] > 0;
+    }
+
+    // a failed worker leaves the others waiting at the barrier, so they
+    // are stopped as soon as one fails
+    for(int left = parts; left > 0; left--) {
+        int status = 0;
+        pid_t pid = 0;
+
+        if(!ok) {
+            for(int p = 0; p < parts; p++) {
+                if(workers[p] > 0) {
+                    kill(workers[p], SIGKILL);
+                }
+            }
+        }
+
+        pid = wait(&status);
+
+        if(pid <= 0) {
+            break;
+        }
+
+        for(int p = 0; p < parts; p++) {
+            if(workers[p] == pid) {
+                workers[p] = -1;
+            }
+        }
+
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            ok = false;
+        }
+    }
+
+    transport.close();
+
+    return ok;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool ganttPartitioned::relaxPartition(int part, bool forward,
+                                      partitionTransport& transport,
+                                      long& steps, long& messages) {
+    const std::vector<long>& start = forward ? outStart : inStart;
+    const std::vector<int>& ends = forward ? outTo : inFrom;
+    const std::vector<long long>& weights = forward ? outWeight : inWeight;
+    long long *dist = forward ? early : tail;
+    long first = partStart[part];
+    long last = partStart[part + 1];
+    std::vector<int> remote;
+    std::vector<long long> best;
+    std::vector<long long> sent;
+    bool dirty = true;
+
+    findBoundary(part, forward, remote);
+    best.assign(remote.size(), -1);
+    sent.assign(remote.size(), -1);
+
+    for(long i = first; i < last; i++) {
+        dist[order[i]] = 0;
+    }
+
+    for(steps = 0; ; ) {
+        long total = 0;
+
+        // the forward pass runs in topological order, the backward pass
+        // in reverse
+        for(long k = 0; dirty && k < last - first; k++) {
+            int v = order[forward ? first + k : last - 1 - k];
+
+            for(long e = start[v]; e < start[v + 1]; e++) {
+                int u = ends[e];
+                long long reach = dist[v] + weights[e];
+
+                if(owner[u] == part) {
+                    dist[u] = std::max(dist[u], reach);
+                } else {
+                    std::size_t slot = std::lower_bound(remote.begin(),
+                                                        remote.end(), u)
+                                       - remote.begin();
+
+                    best[slot] = std::max(best[slot], reach);
+                }
+            }
+        }
+
+        for(std::size_t slot = 0; slot < remote.size(); slot++) {
+            if(best[slot] > sent[slot]) {
+                boundaryValue value;
+
+                value.milestone = static_cast<uint64_t>(remote[slot]);
+                value.value = best[slot];
+                transport.send(part, owner[remote[slot]], value);
+                sent[slot] = best[slot];
+                messages++;
+            }
+        }
+
+        total = transport.exchange(part);
+        steps++;
+
+        if(total <= 0) {
+            return total == 0;
+        }
+
+        dirty = false;
+
+        for(int from = 0; from < parts; from++) {
+            const boundaryValue *values = nullptr;
+            std::size_t count = transport.receive(part, from, values);
+
+            for(std::size_t i = 0; i < count; i++) {
+                long long& d = dist[values[i].milestone];
+
+                if(values[i].value > d) {
+                    d = values[i].value;
+                    dirty = true;
+                }
+            }
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+long ganttPartitioned::getTaskCount() const {
+    return taskCount;
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttPartitioned::criticalPath() {
+    int curr = 0;
+    int last = -1;         // predecessor taken last in the current sweep
+    int next = 0;
+    int wrapped = 0;
+
+    // find final task and project duration
+    finalNode = sourceNode;
+    duration = 0;
+
+    for(int v = 0; v < milestoneCount; v++) {
+        if(early[v] > duration) {
+            duration = early[v];
+            finalNode = v;
+        }
+    }
+
+    // ganttUtils sweeps all vertices in order, taking every tight edge into
+    // the current milestone; so the next one is the smallest tight
+    // predecessor after the last one taken, or else the smallest overall
+    // once a new sweep starts
+    crPath.clear();
+    crPath.push_back(finalNode);
+    curr = finalNode;
+
+    // no sweep at all when the final node is the source
+    while(curr != sourceNode || last != -1) {
+        next = -1;
+        wrapped = -1;
+
+        for(long e = inStart[curr]; e < inStart[curr + 1]; e++) {
+            int from = inFrom[e];
+
+            if(early[curr] == early[from] + inWeight[e]) {
+                if(from > last && (next == -1 || from < next)) {
+                    next = from;
+                }
+
+                if(wrapped == -1 || from < wrapped) {
+                    wrapped = from;
+                }
+            }
+        }
+
+        // end of a sweep, stop if the source has been reached
+        if(next == -1) {
+            if(curr == sourceNode || wrapped == -1) {
+                break;
+            }
+
+            next = wrapped;
+        }
+
+        crPath.push_back(next);
+        curr = next;
+        last = next;
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttPartitioned::findSlackTimes() {
+    slackTimes.assign(milestoneCount, -1);
+
+    for(std::size_t i = 0; i < crPath.size(); i++) {
+        slackTimes[crPath[i]] = 0;
+    }
+
+    // the tail of the in-memory list is the first task read for a source
+    for(int u = 0; u < milestoneCount; u++) {
+        long e = outStart[u];
+
+        if(slackTimes[u] == -1 && outStart[u + 1] > e) {
+            slackTimes[u] = early[outTo[e]] - (early[u] + outWeight[e]);
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttPartitioned::printGraphInformation(std::ostream& out) {
+    using namespace std;
+
+    out << "------------------------------------------------------------\n"
+        << "Graph Information (partitioned)\n"
+        << "   Project title: " << title << endl
+        << "   Milestone Count: " << milestoneCount << endl
+        << "   Task Count: " << taskCount << endl
+        << "   Source Milestone: " << sourceNode << endl
+        << "   Partitions: " << parts;
+
+    if(parts != partsAsked) {
+        out << " (" << partsAsked << " asked)";
+    }
+
+    out << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttPartitioned::printPartitions(std::ostream& out) {
+    using namespace std;
+
+    long fixed = 0;
+
+    out << "------------------------------------------------------------\n"
+        << "Partitions:\n"
+        << "   Part   Milestones       Tasks    Boundary   Forward"
+        << "  Backward    Messages\n";
+
+    for(int p = 0; p < parts; p++) {
+        long tasks = 0;
+        long boundary = 0;
+
+        for(long i = partStart[p]; i < partStart[p + 1]; i++) {
+            int v = order[i];
+
+            for(long e = outStart[v]; e < outStart[v + 1]; e++) {
+                tasks++;
+                boundary += (owner[outTo[e]] != p) ? 1 : 0;
+            }
+        }
+
+        out << setw(7) << p << setw(13) << partStart[p + 1] - partStart[p]
+            << setw(12) << tasks << setw(12) << boundary
+            << setw(10) << stats[p].forwardSteps
+            << setw(10) << stats[p].backwardSteps
+            << setw(12) << stats[p].messages << endl;
+    }
+
+    // on a longest path: early start + longest path to an end = duration
+    for(int v = 0; v < milestoneCount; v++) {
+        fixed += (early[v] + tail[v] == duration) ? 1 : 0;
+    }
+
+    out << "\nMilestones with no float: " << fixed << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttPartitioned::printCriticalPath(std::ostream& out) {
+    using namespace std;
+
+    out << "------------------------------------------------------------\n"
+        << "Critical Path:\n"
+        << "   Source Node: " << sourceNode << endl
+        << "   Final Task: " << finalNode << endl
+        << "   Total Duration: " << duration << endl << endl
+        << "Critical Path: \n";
+
+    for(int v = static_cast<int>(crPath.size()) - 1; v >= 0; v--) {
+        out << ' ' << crPath[v];
+    }
+
+    out << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttPartitioned::printSlackTimes(std::ostream& out) {
+    using namespace std;
+
+    out << "------------------------------------------------------------\n"
+        << "Slack Times (task-slacktime):\n";
+
+    for(int i = 0; i < milestoneCount && slackTimes[i] != -1; i++) {
+        if(slackTimes[i] != 0) {
+            out << ' ' << i << '-' << slackTimes[i];
+        }
+    }
+
+    out << "\n\n";
+}
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,175 @@
+/// @brief Header file for class ganttPartitioned
+/// @file partitionedGraph.h
+
+#ifndef H_PARTITIONEDGRAPH
+#define H_PARTITIONEDGRAPH
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "partitionTransport.h"
+
+/// ----------------------------------------------------------------------------
+/// @brief Work done by one partition, filled in by its worker process.
+/// ----------------------------------------------------------------------------
+struct partitionStats {
+    long forwardSteps;      /// supersteps of the forward pass
+    long backwardSteps;     /// supersteps of the backward pass
+    long messages;          /// boundary values sent in both passes
+};
+
+/// ----------------------------------------------------------------------------
+/// @class ganttPartitioned
+///
+/// @brief Critical path and slack analysis split across worker processes.
+/// The milestones are cut into ranges of topological levels holding about
+/// the same # of tasks, and one forked worker per range runs the forward
+/// (early start) and backward (longest path to an end) passes over its own
+/// milestones.  Values crossing a range boundary go through a
+/// partitionTransport in bulk-synchronous supersteps: relax the range,
+/// send the boundary values that grew, exchange, apply the values
+/// received, until a superstep sends nothing.  Level ranges only have
+/// forward boundary tasks, so a pass takes at most one superstep per
+/// range, but any partition converges.  Workers write their distances to
+/// a shared mapping, from which the coordinator rebuilds the critical
+/// path and slack times; results match the in-memory analysis, including
+/// its tie-breaking.
+/// ----------------------------------------------------------------------------
+class ganttPartitioned {
+private:
+    std::string title;        /// project title
+    int milestoneCount;       /// # of milestones (vertices)
+    long taskCount;           /// # of tasks (edges)
+    int sourceNode;           /// source node
+    int parts;                /// # of partitions in use
+    int partsAsked;           /// # of partitions asked for
+
+    std::vector<long> outStart;       /// first task of each source (+ end)
+    std::vector<int> outTo;           /// task destinations, file order
+    std::vector<long long> outWeight; /// task weights, file order
+    std::vector<long> inStart;        /// first task of each destination
+    std::vector<int> inFrom;          /// task sources
+    std::vector<long long> inWeight;  /// task weights
+
+    std::vector<int> order;       /// milestones by topological level
+    std::vector<long> partStart;  /// first milestone of each partition
+    std::vector<int> owner;       /// partition of each milestone
+
+    long long *early;             /// early starts, shared with the workers
+    long long *tail;              /// longest path to an end, shared
+    partitionStats *stats;        /// per partition, shared
+    std::size_t sharedBytes;      /// size of the shared mapping
+
+    std::vector<int> crPath;      /// critical path, final node first
+    std::vector<long long> slackTimes;    /// slack times
+    int finalNode;                /// final milestone
+    long long duration;           /// project duration
+
+    ganttPartitioned(const ganttPartitioned&);
+    ganttPartitioned& operator=(const ganttPartitioned&);
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Initializes class member variables.
+    ganttPartitioned();
+
+    /// -----------------------------------------------------------------------
+    /// @brief (Destructor) Unmaps the shared results.
+    ~ganttPartitioned();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Reads a task file in the ganttUtils format (integer weights).
+    /// Duplicate tasks are merged the same way ganttUtils::addEdge does.
+    ///
+    /// @param fileName Project tasks file
+    ///
+    /// @return True if file read was successful, false if not
+    bool readGraph(const std::string fileName);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Levels the milestones topologically and cuts the levels into
+    /// ranges of about the same # of tasks.  Empty ranges are dropped, so
+    /// at most min(partCount, levels) partitions are used.
+    ///
+    /// @param partCount # of partitions
+    ///
+    /// @return False if the graph has a cycle, true if not
+    bool partition(int partCount);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Forks one worker per partition for the forward and backward
+    /// passes and waits for all of them.
+    ///
+    /// @param transport Message layer, not yet open
+    ///
+    /// @return True if every worker finished its passes
+    bool runPartitions(partitionTransport& transport);
+
+    /// -----------------------------------------------------------------------
+    /// @return Task count
+    long getTaskCount() const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Finds the final milestone and duration, then walks back from
+    /// it over the tasks into each milestone to rebuild the critical path.
+    void criticalPath();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Computes slack times from the early starts.
+    void findSlackTimes();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Displays title, milestone count, task count and source.
+    ///
+    /// @param out Output stream
+    void printGraphInformation(std::ostream& out = std::cout);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Displays each partition's milestones, tasks, boundary tasks,
+    /// supersteps and messages, and the milestones with no float.
+    ///
+    /// @param out Output stream
+    void printPartitions(std::ostream& out = std::cout);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Prints the source node, final task, total duration, and the
+    /// vertices found in the critical path.
+    ///
+    /// @param out Output stream
+    void printCriticalPath(std::ostream& out = std::cout);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Displays slack times.
+    ///
+    /// @param out Output stream
+    void printSlackTimes(std::ostream& out = std::cout);
+
+private:
+    /// -----------------------------------------------------------------------
+    /// @brief One pass of a worker, superstep by superstep until no
+    /// partition sends a value.  The forward pass finds early starts over
+    /// the tasks out of each milestone, the backward pass the longest path
+    /// to an end over the tasks into each milestone.
+    ///
+    /// @param part Worker's partition
+    /// @param forward True for the forward pass
+    /// @param transport Open message layer
+    /// @param steps Receives the # of supersteps
+    /// @param messages Incremented by the # of values sent
+    ///
+    /// @return False if an exchange failed
+    bool relaxPartition(int part, bool forward, partitionTransport& transport,
+                        long& steps, long& messages);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Distinct milestones of other partitions that a partition's
+    /// tasks lead to (forward) or come from (backward), in order.
+    ///
+    /// @param part Partition
+    /// @param forward True for the forward pass
+    /// @param remote Receives the milestones
+    void findBoundary(int part, bool forward, std::vector<int>& remote) const;
+};
+
+#endif /* H_PARTITIONEDGRAPH */
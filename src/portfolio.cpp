@@ -0,0 +1,526 @@
+/// @brief Implementation file for class ganttPortfolio
+/// @file portfolio.cpp
+
+#include "portfolio.h"
+#include "linkedQueue.h"
+#include "taskStream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <new>
+#include <set>
+#include <thread>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+namespace {
+    const int LIMIT = 10;    // minimum # of tasks, as in projectInfo
+}
+
+ganttPortfolio::ganttPortfolio() {
+    outputDir = ".";
+    threadCount = 1;
+    memLimit = 0;
+    relabel = false;
+    compress = false;
+    reduce = false;
+    contract = false;
+    memInUse = 0;
+    nextProject = 0;
+    elapsed = 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool ganttPortfolio::loadPortfolio(const ganttOptions& options) {
+    using namespace std;
+
+    vector<string> files;
+    struct stat info;
+
+    if(stat(options.batchPath.c_str(), &info) != 0) {
+        return false;
+    }
+
+    if(S_ISDIR(info.st_mode)) {
+        DIR *dir = opendir(options.batchPath.c_str());
+        struct dirent *entry = nullptr;
+        string path;
+
+        if(dir == nullptr) {
+            return false;
+        }
+
+        while((entry = readdir(dir)) != nullptr) {
+            path = options.batchPath + '/' + entry->d_name;
+
+            if(entry->d_name[0] != '.' && stat(path.c_str(), &info) == 0
+               && S_ISREG(info.st_mode)) {
+                files.push_back(path);
+            }
+        }
+
+        closedir(dir);
+        sort(files.begin(), files.end());
+    } else {
+        ifstream listFile(options.batchPath);
+        string line;
+
+        while(getline(listFile, line)) {
+            if(!line.empty() && line[0] != '#') {
+                files.push_back(line);
+            }
+        }
+    }
+
+    // report names are the file's base name, made unique where needed
+    set<string> used;
+    string base;
+
+    projects.clear();
+    projects.resize(files.size());
+
+    for(size_t i = 0; i < files.size(); i++) {
+        base = files[i].substr(files[i].find_last_of('/') + 1);
+
+        if(!used.insert(base).second) {
+            base += '.' + to_string(i);
+            used.insert(base);
+        }
+
+        projects[i].fileName = files[i];
+        projects[i].reportName = base + ".out";
+    }
+
+    if(!options.outputDir.empty()) {
+        outputDir = options.outputDir;
+    }
+
+    if(options.threadCount > 0) {
+        threadCount = options.threadCount;
+    } else {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+
+    memLimit = options.memLimit * 1024 * 1024;
+    relabel = options.relabel;
+    compress = options.compress;
+    reduce = options.reduce;
+    contract = options.contract;
+
+    return !projects.empty();
+}
+
+/// ----------------------------------------------------------------------------
+
+bool ganttPortfolio::runPortfolio() {
+    using namespace std;
+
+    struct stat info;
+
+    if(stat(outputDir.c_str(), &info) != 0) {
+        mkdir(outputDir.c_str(), 0777);
+    }
+
+    if(stat(outputDir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        return false;
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<thread> workers;
+    int count = min(threadCount, static_cast<int>(projects.size()));
+
+    nextProject = 0;
+
+    for(int i = 0; i < count; i++) {
+        workers.push_back(thread(&ganttPortfolio::worker, this));
+    }
+
+    for(size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+
+    elapsed = chrono::duration<double>(chrono::steady_clock::now()
+                                       - start).count();
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttPortfolio::worker() {
+    int job = 0;
+
+    while((job = nextProject++) < static_cast<int>(projects.size())) {
+        projectSummary& summary = projects[job];
+        long bytes = estimateMemory(summary.fileName);
+
+        if(bytes < 0) {
+            summary.status = "can not find project file";
+        } else if(!acquireMemory(bytes)) {
+            summary.status = "exceeds memory limit";
+        } else {
+            try {
+                analyseProject(summary);
+            } catch(std::bad_alloc&) {
+                summary.status = "out of memory";
+            }
+
+            releaseMemory(bytes);
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+struct ganttPortfolio::layoutRunner {
+    ganttPortfolio *portfolio;
+    projectSummary *summary;
+    
+    template <class idxType, class wgtType>
+    int run() {
+        return portfolio->analyseLayout<idxType, wgtType>(*summary);
+    }
+};
+
+
+void ganttPortfolio::analyseProject(projectSummary& summary) {
+    ganttLayout layout;
+    layoutRunner runner = { this, &summary };
+    
+    if(!readLayout(summary.fileName, layout)) {
+        summary.status = "can not read project file";
+        return;
+    }
+    
+    withLayout(layout, runner);
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+int ganttPortfolio::analyseLayout(projectSummary& summary) {
+    using namespace std;
+
+    ganttUtils<idxType, wgtType> project;
+
+    // the projects already keep the workers busy, one parser each
+    if(!project.readGraph(summary.fileName, 1)) {
+        summary.status = "can not read project file";
+        return 0;
+    }
+
+    if(project.hasWeightOverflow()) {
+        return LAYOUT_TOO_NARROW;
+    }
+
+    summary.title = project.getTitle();
+    summary.milestoneCount = project.getMilestoneCount();
+    summary.taskCount = project.getTaskCount();
+
+    if(!project.isValidProject()) {
+        summary.status = "invalid task list";
+        return 0;
+    }
+
+    if(project.getTaskCount() < LIMIT) {
+        summary.status = "too few tasks";
+        return 0;
+    }
+
+    // one thread per project, the pool already runs several
+    if(reduce) {
+        project.reduceTasks(1);
+        summary.taskCount = project.getTaskCount();
+    }
+
+    if(compress) {
+        project.compress();
+    }
+
+    project.findGraphInformation();
+    project.findKeyMilestone();
+    project.findNodePoint();
+    project.findIndependentMilestones();
+    project.findAPs();
+    project.topoSort();
+
+    if(relabel) {
+        project.relabel();
+    }
+
+    if(contract) {
+        project.contractChains();
+    }
+
+    project.criticalPath();
+    project.findSlackTimes();
+    project.findDependencyStats();
+
+    ofstream report(outputDir + '/' + summary.reportName);
+
+    if(!report) {
+        summary.status = "can not write report";
+        return 0;
+    }
+
+    project.printGraphInformation(report);
+
+    if(reduce) {
+        project.printReduction(report);
+    }
+
+    if(contract) {
+        project.printContraction(report);
+    }
+    project.printDependencyStats(report);
+    project.printTopoSort(report);
+    project.printAPs(report);
+    project.printCriticalPath(report);
+    project.printSlackTimes(report);
+
+    summary.duration = static_cast<double>(project.getDuration());
+    summary.finalNode = project.getFinalNode();
+    summary.crPathCount = project.getCriticalPathCount();
+    summary.status = "ok";
+
+    return 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+struct ganttPortfolio::memoryRunner {
+    const ganttPortfolio *portfolio;
+    long milestones;
+    long tasks;
+    long bytes;
+
+    template <class idxType, class wgtType>
+    int run() {
+        bytes = portfolio->layoutMemory<idxType, wgtType>(milestones, tasks);
+        return 0;
+    }
+};
+
+
+long ganttPortfolio::estimateMemory(const std::string& fileName) const {
+    using namespace std;
+
+    taskStream inFile(fileName);
+    struct stat info;
+    string line;
+    string ignore;
+    ganttLayout layout;
+    memoryRunner runner = { this, 0, 0, 0 };
+
+    if(!inFile || stat(fileName.c_str(), &info) != 0
+       || !readLayout(fileName, layout)) {
+        return -1;
+    }
+
+    getline(inFile, line);
+    inFile >> ignore >> runner.milestones;
+
+    if(runner.milestones < 0) {
+        runner.milestones = 0;
+    }
+
+    // one task per line of at least 6 bytes; a compressed file is taken to
+    // hold ten times its size in text
+    runner.tasks = static_cast<long>(info.st_size) / 6;
+
+    if(inFile.compression() != COMPRESSION_NONE) {
+        runner.tasks *= 10;
+    }
+
+    // a weight overflow reruns the project with int64_t weights, once the
+    // 32-bit attempt is freed; the wider run is the peak
+    if(layout.weights == WEIGHT_INT32) {
+        layout.weights = WEIGHT_INT64;
+    }
+
+    withLayout(layout, runner);
+
+    return runner.bytes;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+long ganttPortfolio::layoutMemory(long milestones, long tasks) const {
+    using namespace std;
+
+    const long READ_BLOCK = 1 << 20;        // readGraph()'s block size
+    const long READ_SLOTS = 4;              // its blocks with one parser
+    const long REACH_WORDS = 1 << 22;       // reduceTasks()'s bitset words
+    long idx = sizeof(idxType);
+    long wgt = sizeof(wgtType);
+    long node = sizeof(listNode<idxType, wgtType>);
+    long head = sizeof(headNode<idxType, wgtType>);
+    long lists = milestones * head + (tasks + ARENA_BLOCK) * node;
+    long bytes = 0;
+    long words = 0;
+
+    // kept to the end: adjacency lists; degree/independent/topo/path,
+    // dist/slack/tail and AP arrays; plus the temporary arrays of the
+    // passes and the working queue nodes
+    bytes = lists + milestones * (9 * idx + 3 * wgt + 3 * sizeof(bool))
+            + 2 * sizeof(queueNode<idxType>);
+
+    if(relabel) {
+        bytes += 2 * milestones * idx;          // label and rank
+    }
+
+    if(contract) {
+        bytes += milestones * (idx + wgt);      // chain ends and lengths
+    }
+
+    // the steps below free their temporaries, but the heap keeps what they
+    // used (the reader's and parser's in their own arenas), so each adds
+
+    // readGraph(..., 1) starts a reader and a parser thread besides the
+    // worker, and each of its slots holds a block of text and the tasks
+    // parsed from it (no more than the file's, vector growth doubles)
+    bytes += READ_SLOTS * (READ_BLOCK + 1
+                           + 2 * min(READ_BLOCK / 6, tasks)
+                             * (2 * sizeof(long long) + sizeof(double)));
+
+    // reduceTasks(1): flat copies of the tasks and the reach bitsets of
+    // one block of topological positions, as many words as it picks
+    if(reduce && milestones > 0) {
+        words = max(1L, min((milestones + 63) / 64,
+                            REACH_WORDS / milestones));
+        bytes += (milestones + 1) * sizeof(size_t)
+                 + tasks * (2 * idx + 2 * wgt + sizeof(size_t) + 1)
+                 + milestones * (4 * idx + wgt)
+                 + (milestones + 1) * words * sizeof(uint64_t);
+    }
+
+    // compress(): the varint stream, grown in a vector and copied out,
+    // next to the lists it replaces
+    if(compress) {
+        bytes += (milestones + 1) * sizeof(size_t)
+                 + 3 * tasks * ((8 * idx + 7) / 7
+                                + (numeric_limits<wgtType>::is_integer
+                                   ? (8 * wgt + 6) / 7 : wgt));
+    }
+
+    // relabel(): a second copy of the lists in the new order, it does
+    // nothing once compress() ran
+    if(relabel && !compress) {
+        bytes += lists;
+    }
+
+    return bytes;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool ganttPortfolio::acquireMemory(long bytes) {
+    if(memLimit == 0) {
+        return true;
+    }
+
+    if(bytes > memLimit) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(memLock);
+
+    while(memInUse + bytes > memLimit) {
+        memFreed.wait(lock);
+    }
+
+    memInUse += bytes;
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttPortfolio::releaseMemory(long bytes) {
+    if(memLimit == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(memLock);
+        memInUse -= bytes;
+    }
+
+    memFreed.notify_all();
+}
+
+/// ----------------------------------------------------------------------------
+
+void ganttPortfolio::printSummary(std::ostream& out) {
+    using namespace std;
+
+    int analysed = 0;
+    long milestones = 0;
+    long tasks = 0;
+    int longest = -1;
+
+    out << "------------------------------------------------------------\n"
+        << "Portfolio Summary:\n"
+        << "   Projects: " << projects.size() << endl
+        << "   Threads: " << threadCount << endl
+        << fixed << setprecision(3)
+        << "   Elapsed: " << elapsed << " s\n\n"
+        << defaultfloat << setprecision(15)
+        << setw(30) << left << "Project" << right
+        << setw(12) << "Milestones" << setw(10) << "Tasks"
+        << setw(10) << "Duration" << setw(8) << "Final"
+        << setw(8) << "Path" << "  Status\n";
+
+    for(size_t i = 0; i < projects.size(); i++) {
+        const projectSummary& p = projects[i];
+
+        out << setw(30) << left << p.reportName.substr(0, p.reportName.size() - 4)
+            << right << setw(12) << p.milestoneCount
+            << setw(10) << p.taskCount << setw(10) << p.duration
+            << setw(8) << p.finalNode << setw(8) << p.crPathCount
+            << "  " << p.status << endl;
+
+        if(p.status == "ok") {
+            analysed++;
+            milestones += p.milestoneCount;
+            tasks += p.taskCount;
+
+            if(longest == -1 || p.duration > projects[longest].duration) {
+                longest = static_cast<int>(i);
+            }
+        }
+    }
+
+    out << "\n   Analysed: " << analysed << " of " << projects.size() << endl
+        << "   Total Milestones: " << milestones << endl
+        << "   Total Tasks: " << tasks << endl;
+
+    if(longest != -1) {
+        out << "   Longest Project: " << projects[longest].fileName
+            << ", duration: " << projects[longest].duration << endl;
+    }
+
+    out << "\n";
+}
+
+/// ----------------------------------------------------------------------------
+
+bool ganttPortfolio::writeSummary() {
+    std::ofstream summary(outputDir + "/portfolio_summary.txt");
+
+    if(!summary) {
+        return false;
+    }
+
+    printSummary(summary);
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,154 @@
+/// @brief Header file for class ganttPortfolio
+/// @file portfolio.h
+
+#ifndef H_PORTFOLIO
+#define H_PORTFOLIO
+
+#include "ganttUtils.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// ----------------------------------------------------------------------------
+/// @brief Outcome of analysing one project of the portfolio.
+/// ----------------------------------------------------------------------------
+struct projectSummary {
+    std::string fileName;     /// project tasks file
+    std::string reportName;   /// per-project report file
+    std::string title;        /// project title
+    std::string status;       /// "ok" or the reason the project was skipped
+    long long milestoneCount; /// # of milestones
+    long long taskCount;      /// # of tasks
+    double duration;          /// project duration, in the file's weight type
+    long long finalNode;      /// final milestone
+    long long crPathCount;    /// # of milestones in critical path
+
+    projectSummary() : milestoneCount(0), taskCount(0), duration(0),
+                       finalNode(0), crPathCount(0) {}
+};
+
+/// ----------------------------------------------------------------------------
+/// @class ganttPortfolio
+///
+/// @brief Analyses a portfolio of independent task files on a bounded pool of
+/// worker threads.  Each project gets its own ganttUtils instance and report
+/// file; a project is only started once its estimated memory fits in the
+/// remaining budget.
+/// ----------------------------------------------------------------------------
+class ganttPortfolio {
+private:
+    std::vector<projectSummary> projects;   /// one entry per task file
+    std::string outputDir;                  /// directory for reports
+    int threadCount;                        /// # of worker threads
+    bool relabel;                           /// relabel() each project
+    bool compress;                          /// compress() each project
+    bool reduce;                            /// reduceTasks() each project
+    bool contract;                          /// contractChains() each project
+
+    long memLimit;                          /// budget in bytes, 0 if none
+    long memInUse;                          /// estimated bytes in use
+    std::mutex memLock;                     /// guards memInUse
+    std::condition_variable memFreed;       /// signalled on release
+
+    std::atomic<int> nextProject;           /// next project to analyse
+    double elapsed;                         /// wall time in seconds
+
+    struct layoutRunner;                    /// withLayout() visitor
+    struct memoryRunner;                    /// estimate visitor
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Initializes an empty portfolio.
+    ganttPortfolio();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Collects the task files of the portfolio.  A directory
+    /// contributes every regular file in it (sorted by name); any other file
+    /// is read as a list with one task file path per line.
+    ///
+    /// @param options Parsed command line options
+    ///
+    /// @return True if at least one task file was found, false if not
+    bool loadPortfolio(const ganttOptions& options);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Analyses every project and writes its report to the output
+    /// directory.
+    ///
+    /// @return True if the output directory is usable, false if not
+    bool runPortfolio();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Displays one line per project and the portfolio totals.
+    ///
+    /// @param out Output stream
+    void printSummary(std::ostream& out = std::cout);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Writes the portfolio summary to "portfolio_summary.txt" in the
+    /// output directory.
+    ///
+    /// @return True if the file was written, false if not
+    bool writeSummary();
+
+private:
+    /// -----------------------------------------------------------------------
+    /// @brief Worker thread loop, claims projects until none are left.
+    void worker();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Runs the full analysis of one project and writes its report,
+    /// using the storage widths readLayout() picks for the file.
+    ///
+    /// @param summary Project to analyse, filled in with the results
+    void analyseProject(projectSummary& summary);
+
+    /// -----------------------------------------------------------------------
+    /// @brief analyseProject() for one layout.
+    ///
+    /// @param summary Project to analyse, filled in with the results
+    ///
+    /// @return LAYOUT_TOO_NARROW if the weights overflowed wgtType, else 0
+    template <class idxType, class wgtType>
+    int analyseLayout(projectSummary& summary);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Estimates the peak memory of analysing a task file from its
+    /// milestone count and file size, in the layout readLayout() picks for
+    /// it and with the portfolio's relabel/compress/reduce/contract steps.
+    ///
+    /// @param fileName Project tasks file
+    ///
+    /// @return Estimated bytes, or -1 if the file can not be read
+    long estimateMemory(const std::string& fileName) const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief estimateMemory() for one layout.
+    ///
+    /// @param milestones # of milestones in the header
+    /// @param tasks Most tasks the file can hold
+    ///
+    /// @return Estimated bytes
+    template <class idxType, class wgtType>
+    long layoutMemory(long milestones, long tasks) const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Blocks until the estimate fits in the memory budget.
+    ///
+    /// @param bytes Estimated bytes
+    ///
+    /// @return False if the estimate alone exceeds the budget
+    bool acquireMemory(long bytes);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Returns an estimate to the memory budget.
+    ///
+    /// @param bytes Estimated bytes
+    void releaseMemory(long bytes);
+};
+
+#endif /* H_PORTFOLIO */
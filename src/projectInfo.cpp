@@ -1,46 +1,148 @@
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 using namespace std;
 
 #include "ganttUtils.h"
+#include "portfolio.h"
+#include "externalGraph.h"
+#include "partitionedGraph.h"
+#include "ganttChart.h"
+#include "calendar.h"
+#include "resultCache.h"
+#include "versionedGraph.h"
 
-int main(int argc, char *argv[])
+// *****************************************************************
+//  Gantt chart of an analysed project, SVG if the file name ends in
+//  ".svg", else text ("-" for the console).
+
+template <class idxType, class wgtType>
+bool drawChart(const ganttOptions& options,
+	       const ganttUtils<idxType, wgtType>& project)
 {
+	const string	svg = ".svg";
+	vector<taskBar>	bars;
+	ganttChart	chart;
+	chartView	view;
+	ofstream	chartFile;
+	ostream		*out = &cout;
+	bool		isSVG = options.chartFile.size() > svg.size() &&
+			options.chartFile.compare(options.chartFile.size() -
+				svg.size(), svg.size(), svg) == 0;
+
+	project.getTaskBars(bars);
+	chart.build(bars);
+
+	view.from = options.chartFrom;
+	view.to = (options.chartTo < 0) ? chart.getFinish() : options.chartTo;
+	view.width = options.chartWidth > 0 ? options.chartWidth :
+			(isSVG ? 1000 : 80);
+	view.rows = options.chartRows > 0 ? options.chartRows :
+			(isSVG ? 200 : 40);
+
+	if (options.chartFile != "-") {
+		chartFile.open(options.chartFile);
+
+		if (!chartFile)
+			return false;
+
+		out = &chartFile;
+	}
+
+	if (isSVG)
+		chart.renderSVG(*out, view, project.getTitle(),
+				project.getNames());
+	else
+		chart.renderText(*out, view, project.getTitle(),
+				 project.getNames());
+
+	return true;
+}
 
 // *****************************************************************
-//  Headers...
+//  Edit script replayed on versioned copies of the project's tasks,
+//  each published version is printed as a reader sees it.
 
-	const int	LIMIT = 10;
-	const char	*bold = "\033[1m";
-	const char	*unbold = "\033[0m";
-	string		stars = "";
-	string		tasksFile = "";
-	string		dotFile = "";
-	bool		printFlag = false;
-	ganttUtils	myProject;
+template <class idxType, class wgtType>
+bool replayEdits(const ganttOptions& options,
+		 const ganttUtils<idxType, wgtType>& project)
+{
+	versionedGraph<idxType, wgtType>	graph;
+	vector<idxType>				from;
+	vector<idxType>				to;
+	vector<wgtType>				weight;
 
-	stars.append(65, '*');
+	project.getTasks(from, to, weight);
 
-// ------------------------------------------------------------------
-//  Perform initial checks.
-//	command line arguments
-//	read project tasks file
-//	basic validation of tasks file
+	return graph.load(project.getMilestoneCount(), from, to, weight) &&
+		graph.readEdits(options.editsFile);
+}
 
-	if (!myProject.getArguments(argc, argv, tasksFile, printFlag))
-		exit(1);
+// *****************************************************************
+//  Analysis of one project, for the storage widths chosen by
+//  readLayout().
+
+const int	LIMIT = 10;
+const char	*bold = "\033[1m";
+const char	*unbold = "\033[0m";
+const string	stars(65, '*');
+
+template <class idxType, class wgtType>
+int analyseProject(const ganttOptions& options, const calendarSet& calendars,
+		   const resultCache& cache)
+{
+	ganttUtils<idxType, wgtType>	project;
+	bool				cached = false;
+	bool				analysed = false;
+	string				resultFile;
+
+	if (cache.isOpen()) {
+		resultFile = cache.entry(sizeof(idxType), sizeof(wgtType),
+				numeric_limits<wgtType>::is_integer,
+				options.reduce);
+		analysed = project.readResults(resultFile, cache.getHash(),
+					       cache.getSize(), options.reduce);
+	}
 
-	if (!myProject.readGraph(tasksFile)) {
+	if (analysed) {
+		cache.touch(resultFile);
+	} else if (!options.snapshotFile.empty() &&
+	    project.readSnapshot(options.snapshotFile, options.fileName,
+				 options.reduce)) {
+		cached = true;
+	} else if (options.stringIDs) {
+		if (!project.readNamedGraph(options.fileName)) {
+			cout << "Error, can not find project file." << endl;
+			exit(1);
+		}
+	} else if (!project.readGraph(options.fileName, options.threadCount)) {
 		cout << "Error, can not find project file." << endl;
 		exit(1);
 	}
 
-	if(!myProject.isValidProject()) {
+	if (!analysed && project.hasWeightOverflow())
+		return LAYOUT_TOO_NARROW;
+
+	if(!analysed && !project.isValidProject()) {
 		cout << "Invalid task list." << endl;
 		exit(1);
 	}
 
+	if (options.reduce && !cached && !analysed)
+		project.reduceTasks(options.threadCount);
+
+	if (!options.snapshotFile.empty() && !cached &&
+	    !project.writeSnapshot(options.snapshotFile, options.fileName)) {
+		cout << "Error, can not write snapshot." << endl;
+		exit(1);
+	}
+
+	if (options.compress)
+		project.compress();
+
 // ------------------------------------------------------------------
 //  Display headers, verify enough tasks...
 
@@ -48,7 +150,7 @@ int main(int argc, char *argv[])
 	cout << "Gantt Analysis Project" << unbold << endl;
 	cout << endl;
 
-	if (myProject.getTaskCount() < LIMIT) {
+	if (project.getTaskCount() < LIMIT) {
 		cout << "Error, too few tasks." << endl;
 		exit(1);
 	}
@@ -62,31 +164,181 @@ int main(int argc, char *argv[])
 //	thread thd1(&<objectName>::<functionName>);
 //  Note, as usual, must join to ensure completed:
 //	thd1.join()
+//
+//  Results from the cache need none of it.
+
+	if (!analysed) {
+		project.findGraphInformation();
+		project.findKeyMilestone();
+		project.findNodePoint();
+		project.findIndependentMilestones();
+		project.findAPs();
+		project.topoSort();
+	}
+
+	if (options.relabel)
+		project.relabel();
+
+	if (options.contract)
+		project.contractChains();
+
+	if (!analysed) {
+		project.criticalPath();
+		project.findSlackTimes();
+		project.findDependencyStats();
+	}
+
+	if (cache.isOpen() && !analysed) {
+		if (!project.writeResults(resultFile, cache.getHash(),
+					  cache.getSize())) {
+			cout << "Error, can not write result cache." << endl;
+			exit(1);
+		}
+
+		cache.evict();
+	}
+
+	if (options.concurrency)
+		project.findConcurrency(options.threadCount);
+
+	if (options.dominators)
+		project.findDominators(options.threadCount);
+
+	if (options.nearCritical >= 0) {
+		double	margin = options.nearCritical;
+
+		if (options.nearPercent)
+			margin = margin * project.getDuration() / 100;
+
+		project.findNearCriticalPaths(static_cast<wgtType>(margin),
+					      options.maxPaths);
+	}
 
-	myProject.findGraphInformation();
-	myProject.findKeyMilestone();
-	myProject.findNodePoint();
-	myProject.findIndependentMilestones();
-	myProject.findAPs();
-	myProject.topoSort();
-	myProject.criticalPath();
-	myProject.findSlackTimes();
-	myProject.findDependencyStats();
+	if (options.deliverables)
+		project.findDeliverables();
+
+	for (size_t q = 0; q < options.topQueries.size(); q++)
+		project.findTop(options.topQueries[q], options.threadCount);
+
+	if (!options.calendarFile.empty()) {
+		long	start = 0;
+
+		parseDate(options.startDate, start);
+
+		if (!numeric_limits<wgtType>::is_integer) {
+			cout << "Error, calendars need integer task weights." << endl;
+			exit(1);
+		}
+
+		if (!project.scheduleCalendar(calendars, start)) {
+			cout << "Error, schedule falls outside the calendars." << endl;
+			exit(1);
+		}
+	}
+
+	if (!options.crashFile.empty()) {
+		if (!numeric_limits<wgtType>::is_integer) {
+			cout << "Error, crashing needs integer task weights." << endl;
+			exit(1);
+		}
+
+		if (!project.readCrashCosts(options.crashFile)) {
+			cout << "Error, can not read crash costs." << endl;
+			exit(1);
+		}
+
+		project.crashProject(static_cast<wgtType>(options.crashBy));
+	}
+
+	if (!options.resourceFile.empty()) {
+		if (!numeric_limits<wgtType>::is_integer) {
+			cout << "Error, resource scheduling needs integer task weights."
+			     << endl;
+			exit(1);
+		}
+
+		if (!project.readResources(options.resourceFile)) {
+			cout << "Error, can not read resource demands." << endl;
+			exit(1);
+		}
+
+		project.scheduleResources(options.priority);
+	}
 
 // -----
 //  Display project information.
 //	Note, all calculations done, just display results.
 
-	myProject.printGraphInformation();
+	project.printGraphInformation();
+
+	if (options.reduce)
+		project.printReduction();
+
+	if (options.contract)
+		project.printContraction();
+
+	if (options.compress)
+		project.printStorage();
+
+	if (options.printFlag)
+		project.printGraph();
+
+	project.printDependencyStats();
+	project.printTopoSort();
+	project.printAPs();
+
+	if (options.dominators)
+		project.printDominators();
+	project.printCriticalPath();
+	project.printSlackTimes();
+
+	if (options.nearCritical >= 0)
+		project.printNearCriticalPaths();
+
+	if (options.deliverables)
+		project.printDeliverables();
+
+	if (!options.topQueries.empty())
+		project.printTop();
+
+	if (options.concurrency)
+		project.printConcurrency();
 
-	if (printFlag)
-		myProject.printGraph();
+	if (!options.calendarFile.empty())
+		project.printSchedule();
 
-	myProject.printDependencyStats();
-	myProject.printTopoSort();
-	myProject.printAPs();
-	myProject.printCriticalPath();
-	myProject.printSlackTimes();
+	if (!options.crashFile.empty())
+		project.printCrashing();
+
+	if (!options.resourceFile.empty())
+		project.printResources();
+
+	if (!options.editsFile.empty() && !replayEdits(options, project)) {
+		cout << "Error, can not apply project edits." << endl;
+		exit(1);
+	}
+
+	if (!options.scheduleFile.empty() &&
+	    !project.writeSchedule(options.scheduleFile)) {
+		cout << "Error, can not write schedule." << endl;
+		exit(1);
+	}
+
+	if (!options.resourceCsv.empty() &&
+	    !project.writeResources(options.resourceCsv)) {
+		cout << "Error, can not write resource schedule." << endl;
+		exit(1);
+	}
+
+	if (!options.topFile.empty() && !project.writeTop(options.topFile)) {
+		cout << "Error, can not write top-k results." << endl;
+		exit(1);
+	}
+
+	if (!options.chartFile.empty() && !drawChart(options, project)) {
+		cout << "Error, can not write Gantt chart." << endl;
+		exit(1);
+	}
 
 // *****************************************************************
 //  All done.
@@ -97,3 +349,261 @@ int main(int argc, char *argv[])
 	return 0;
 }
 
+// *****************************************************************
+//  Changes between an older version of the project and the current
+//  one, both analysed with the same storage widths.
+
+template <class idxType, class wgtType>
+int diffProjects(const ganttOptions& options)
+{
+	ganttUtils<idxType, wgtType>	older;
+	ganttUtils<idxType, wgtType>	project;
+
+	if (!older.readGraph(options.diffFile, options.threadCount) ||
+	    !project.readGraph(options.fileName, options.threadCount)) {
+		cout << "Error, can not find project file." << endl;
+		exit(1);
+	}
+
+	if (older.hasWeightOverflow() || project.hasWeightOverflow())
+		return LAYOUT_TOO_NARROW;
+
+	if (!older.isValidProject() || !project.isValidProject()) {
+		cout << "Invalid task list." << endl;
+		exit(1);
+	}
+
+	older.criticalPath();
+	older.findSlackTimes();
+	project.criticalPath();
+	project.findSlackTimes();
+	project.compareWith(older, options.threadCount);
+
+	cout << stars << endl << bold << "CS 302 - Assignment #11" << endl;
+	cout << "Gantt Analysis Project" << unbold << endl;
+	cout << endl;
+
+	project.printDiff();
+
+	cout << stars << endl;
+	cout << "Game Over, thank you for playing." << endl;
+
+	return 0;
+}
+
+struct diffRunner {
+	const ganttOptions	*options;
+
+	template <class idxType, class wgtType>
+	int run() { return diffProjects<idxType, wgtType>(*options); }
+};
+
+struct projectRunner {
+	const ganttOptions	*options;
+	const calendarSet	*calendars;
+	const resultCache	*cache;
+
+	template <class idxType, class wgtType>
+	int run() { return analyseProject<idxType, wgtType>(*options,
+							    *calendars,
+							    *cache); }
+};
+
+int main(int argc, char *argv[])
+{
+
+// *****************************************************************
+//  Headers...
+
+	ganttOptions	options;
+
+// ------------------------------------------------------------------
+//  Perform initial checks.
+//	command line arguments
+//	read project tasks file
+//	basic validation of tasks file
+
+	if (!getArguments(argc, argv, options))
+		exit(1);
+
+// ------------------------------------------------------------------
+//  Portfolio mode, each task file is analysed on its own thread.
+
+	if (!options.batchPath.empty()) {
+		ganttPortfolio	portfolio;
+
+		if (!portfolio.loadPortfolio(options)) {
+			cout << "Error, can not find project files." << endl;
+			exit(1);
+		}
+
+		if (!portfolio.runPortfolio()) {
+			cout << "Error, can not write project reports." << endl;
+			exit(1);
+		}
+
+		portfolio.printSummary();
+
+		if (!portfolio.writeSummary()) {
+			cout << "Error, can not write portfolio summary." << endl;
+			exit(1);
+		}
+
+		return 0;
+	}
+
+// ------------------------------------------------------------------
+//  Out-of-core mode, edges are sorted into temporary files and only
+//  per-milestone arrays are kept in memory.
+
+	if (options.memLimit > 0) {
+		ganttExternal	bigProject;
+
+		if (!bigProject.readGraph(options.fileName,
+					  options.memLimit * 1024 * 1024)) {
+			cout << "Error, can not find project file." << endl;
+			exit(1);
+		}
+
+		if (!bigProject.topoSort()) {
+			cout << "Invalid task list." << endl;
+			exit(1);
+		}
+
+		cout << stars << endl << bold << "CS 302 - Assignment #11" << endl;
+		cout << "Gantt Analysis Project" << unbold << endl;
+		cout << endl;
+
+		if (bigProject.getTaskCount() < LIMIT) {
+			cout << "Error, too few tasks." << endl;
+			exit(1);
+		}
+
+		bigProject.criticalPath();
+		bigProject.findSlackTimes();
+
+		bigProject.printGraphInformation();
+		bigProject.printTopoSort();
+		bigProject.printCriticalPath();
+		bigProject.printSlackTimes();
+
+		cout << stars << endl;
+		cout << "Game Over, thank you for playing." << endl;
+
+		return 0;
+	}
+
+// ------------------------------------------------------------------
+//  Partitioned mode, one worker process per range of topological
+//  levels, boundary values exchanged through shared memory.
+
+	if (options.partitions > 0) {
+		ganttPartitioned	bigProject;
+		sharedMemoryTransport	transport;
+		ganttLayout		weights;
+
+		if (!readLayout(options.fileName, weights) ||
+		    !bigProject.readGraph(options.fileName)) {
+			cout << "Error, can not find project file." << endl;
+			exit(1);
+		}
+
+		if (weights.weights == WEIGHT_DOUBLE) {
+			cout << "Error, partitions need integer task weights." << endl;
+			exit(1);
+		}
+
+		if (!bigProject.partition(options.partitions)) {
+			cout << "Invalid task list." << endl;
+			exit(1);
+		}
+
+		cout << stars << endl << bold << "CS 302 - Assignment #11" << endl;
+		cout << "Gantt Analysis Project" << unbold << endl;
+		cout << endl;
+
+		if (bigProject.getTaskCount() < LIMIT) {
+			cout << "Error, too few tasks." << endl;
+			exit(1);
+		}
+
+		if (!bigProject.runPartitions(transport)) {
+			cout << "Error, partition workers failed." << endl;
+			exit(1);
+		}
+
+		bigProject.criticalPath();
+		bigProject.findSlackTimes();
+
+		bigProject.printGraphInformation();
+		bigProject.printPartitions();
+		bigProject.printCriticalPath();
+		bigProject.printSlackTimes();
+
+		cout << stars << endl;
+		cout << "Game Over, thank you for playing." << endl;
+
+		return 0;
+	}
+
+// ------------------------------------------------------------------
+//  Diff mode, both versions in the narrowest layout that holds either.
+
+	if (!options.diffFile.empty()) {
+		ganttLayout	layout;
+		ganttLayout	older;
+		diffRunner	runner;
+
+		if (!readLayout(options.fileName, layout) ||
+		    !readLayout(options.diffFile, older)) {
+			cout << "Error, can not find project file." << endl;
+			exit(1);
+		}
+
+		layout.wideIndex = layout.wideIndex || older.wideIndex;
+
+		if (older.weights == WEIGHT_DOUBLE ||
+		    (older.weights == WEIGHT_INT64 &&
+		     layout.weights == WEIGHT_INT32))
+			layout.weights = older.weights;
+
+		runner.options = &options;
+
+		return withLayout(layout, runner);
+	}
+
+// ------------------------------------------------------------------
+//  In-memory analysis with the narrowest index and weight types.
+
+	ganttLayout	layout;
+	projectRunner	runner;
+	calendarSet	calendars;
+	resultCache	cache;
+
+	if (!readLayout(options.fileName, layout)) {
+		cout << "Error, can not find project file." << endl;
+		exit(1);
+	}
+
+	// calendars are loaded once, whatever the layout
+	if (!options.calendarFile.empty() &&
+	    !calendars.load(options.calendarFile)) {
+		cout << "Error, can not read calendar file." << endl;
+		exit(1);
+	}
+
+	// the task file is hashed once, its results may be in the cache
+	if (!options.cacheDir.empty() &&
+	    !cache.open(options.cacheDir,
+			static_cast<uint64_t>(options.cacheSize) * 1024 * 1024,
+			options.fileName)) {
+		cout << "Error, can not open result cache." << endl;
+		exit(1);
+	}
+
+	runner.options = &options;
+	runner.calendars = &calendars;
+	runner.cache = &cache;
+
+	return withLayout(layout, runner);
+}
\ No newline at end of file
@@ -0,0 +1,281 @@
+/// @brief Stress test and throughput benchmark of concurrentQueue against
+/// a mutex-guarded linkedQueue
+/// @file queueBench.cpp
+///
+/// "queueBench -check" runs producers and consumers over small and large
+/// rings and fails unless every item arrives exactly once and each
+/// consumer sees every producer's items in order.  "queueBench [items]"
+/// times both queues with items per producer (default 1000000).
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrentQueue.h"
+#include "linkedQueue.h"
+
+namespace {
+    const int CONFIGS = 3;
+    const int PRODUCERS[CONFIGS] = {1, 4, 3};    // stress configurations
+    const int CONSUMERS[CONFIGS] = {1, 4, 5};
+    const std::size_t CAPACITIES[2] = {4, 1024};
+    const std::size_t BATCHES[2] = {1, 8};
+    const std::size_t CHECK_ITEMS = 100000;      // items per stress producer
+    const std::size_t BENCH_CAPACITY = 4096;
+    const int MAX_BATCH = 16;
+
+    // linkedQueue behind one mutex, the way a parallel sweep would have to
+    // share it; unbounded, so addItems() always takes every item
+    template <class myType>
+    class lockedQueue {
+    private:
+        linkedQueue<myType> queue;
+        std::mutex guard;
+
+    public:
+        explicit lockedQueue(std::size_t) {}
+
+        std::size_t addItems(const myType *items, std::size_t count) {
+            std::lock_guard<std::mutex> lock(guard);
+
+            for(std::size_t i = 0; i < count; i++) {
+                queue.addItem(items[i]);
+            }
+
+            return count;
+        }
+
+        std::size_t deleteItems(myType *items, std::size_t count) {
+            std::lock_guard<std::mutex> lock(guard);
+            std::size_t taken = 0;
+
+            while(taken < count && !queue.isEmptyQueue()) {
+                items[taken++] = queue.front();
+                queue.deleteItem();
+            }
+
+            return taken;
+        }
+    };
+
+    // one run: producers push (producer << 32 | sequence) in batches of
+    // 1..batch items, consumers pop up to batch items until all arrived
+    template <class queueType>
+    struct queueRun {
+        queueType queue;
+        std::size_t items;                       // per producer
+        std::size_t batch;
+        std::size_t total;
+        std::atomic<std::size_t> consumed;
+        std::vector<std::vector<uint64_t> > *received;   // per consumer
+
+        queueRun(std::size_t capacity, std::size_t perProducer,
+                 std::size_t batchSize, int producers)
+            : queue(capacity) {
+            items = perProducer;
+            batch = batchSize;
+            total = perProducer * producers;
+            consumed.store(0);
+            received = nullptr;
+        }
+
+        void produce(uint64_t producer) {
+            uint64_t run[MAX_BATCH];
+            std::size_t next = 0;
+
+            while(next < items) {
+                std::size_t count = next % batch + 1;
+                std::size_t added = 0;
+
+                if(count > items - next) {
+                    count = items - next;
+                }
+
+                for(std::size_t i = 0; i < count; i++) {
+                    run[i] = producer << 32 | (next + i);
+                }
+
+                while(added < count) {
+                    std::size_t n = queue.addItems(run + added,
+                                                   count - added);
+
+                    if(n == 0) {
+                        std::this_thread::yield();
+                    }
+
+                    added += n;
+                }
+
+                next += count;
+            }
+        }
+
+        void consume(int consumer) {
+            uint64_t run[MAX_BATCH];
+
+            while(consumed.load(std::memory_order_relaxed) < total) {
+                std::size_t n = queue.deleteItems(run, batch);
+
+                if(n == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                if(received != nullptr) {
+                    (*received)[consumer].insert((*received)[consumer].end(),
+                                                 run, run + n);
+                }
+
+                consumed.fetch_add(n, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // runs producers and consumers to completion, returns seconds taken
+    template <class queueType>
+    double runQueue(queueRun<queueType>& run, int producers, int consumers) {
+        using namespace std;
+
+        vector<thread> workers;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        for(int c = 0; c < consumers; c++) {
+            workers.push_back(thread(&queueRun<queueType>::consume, &run, c));
+        }
+
+        for(int p = 0; p < producers; p++) {
+            workers.push_back(thread(&queueRun<queueType>::produce, &run,
+                                     static_cast<uint64_t>(p)));
+        }
+
+        for(size_t i = 0; i < workers.size(); i++) {
+            workers[i].join();
+        }
+
+        return chrono::duration<double>(chrono::steady_clock::now()
+                                        - start).count();
+    }
+
+    // every item arrived once, and in producer order at each consumer
+    bool checkReceived(const std::vector<std::vector<uint64_t> >& received,
+                       int producers, std::size_t items) {
+        using namespace std;
+
+        vector<unsigned char> seen(producers * items, 0);
+
+        for(size_t c = 0; c < received.size(); c++) {
+            vector<long long> last(producers, -1);
+
+            for(size_t i = 0; i < received[c].size(); i++) {
+                uint64_t producer = received[c][i] >> 32;
+                long long sequence = received[c][i] & 0xffffffffULL;
+
+                if(producer >= static_cast<uint64_t>(producers)
+                   || sequence >= static_cast<long long>(items)
+                   || sequence <= last[producer]
+                   || seen[producer * items + sequence]++ != 0) {
+                    return false;
+                }
+
+                last[producer] = sequence;
+            }
+        }
+
+        for(size_t i = 0; i < seen.size(); i++) {
+            if(seen[i] != 1) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    int stressTest() {
+        using namespace std;
+
+        int failures = 0;
+
+        for(int k = 0; k < CONFIGS; k++) {
+            for(size_t c = 0; c < 2; c++) {
+                for(size_t b = 0; b < 2; b++) {
+                    queueRun<concurrentQueue<uint64_t> > run(CAPACITIES[c],
+                        CHECK_ITEMS, BATCHES[b], PRODUCERS[k]);
+                    vector<vector<uint64_t> > received(CONSUMERS[k]);
+                    bool passed = false;
+
+                    run.received = &received;
+                    runQueue(run, PRODUCERS[k], CONSUMERS[k]);
+                    passed = checkReceived(received, PRODUCERS[k],
+                                           CHECK_ITEMS);
+                    failures += passed ? 0 : 1;
+
+                    cout << (passed ? "ok   " : "FAIL ") << PRODUCERS[k]
+                         << " producers, " << CONSUMERS[k]
+                         << " consumers, capacity " << CAPACITIES[c]
+                         << ", batch " << BATCHES[b] << endl;
+                }
+            }
+        }
+
+        return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    template <class queueType>
+    double throughput(std::size_t items, std::size_t batch, int threads) {
+        queueRun<queueType> run(BENCH_CAPACITY, items, batch, threads);
+
+        return run.total / runQueue(run, threads, threads) / 1e6;
+    }
+
+    void benchmark(std::size_t items) {
+        using namespace std;
+
+        cout << "Million items per second, " << items << " per producer"
+             << endl << "threads  batch  concurrentQueue  mutex+linkedQueue"
+             << endl;
+
+        for(int threads = 1; threads <= 4; threads *= 2) {
+            for(size_t batch = 1; batch <= 16; batch *= 16) {
+                cout << setw(4) << threads << "+" << left << setw(4)
+                     << threads << right << setw(5) << batch << fixed
+                     << setprecision(2) << setw(17)
+                     << throughput<concurrentQueue<uint64_t> >(items, batch,
+                                                               threads)
+                     << setw(19)
+                     << throughput<lockedQueue<uint64_t> >(items, batch,
+                                                           threads)
+                     << endl;
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    using namespace std;
+
+    long long items = 1000000;
+
+    if(argc > 1 && string(argv[1]) == "-check") {
+        return stressTest();
+    }
+
+    if(argc > 1) {
+        items = atoll(argv[1]);
+    }
+
+    if(argc > 2 || items <= 0 || items > 0xffffffffLL) {
+        cout << "Usage: queueBench -check | queueBench [items]" << endl;
+        return EXIT_FAILURE;
+    }
+
+    benchmark(items);
+
+    return EXIT_SUCCESS;
+}
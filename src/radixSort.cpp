@@ -0,0 +1,118 @@
+/// @brief Implementation file for the parallel radix sort
+/// @file radixSort.cpp
+
+#include "radixSort.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+    const int RADIX_BITS = 8;                   // bits per digit
+    const int BUCKETS = 1 << RADIX_BITS;        // digit values
+    const int PASSES = 64 / RADIX_BITS;         // digits per key
+    const std::size_t MIN_CHUNK = 1 << 16;      // keys per thread, at least
+
+    // counts the digits of keys [first, last)
+    void countDigits(const uint64_t *keys, std::size_t first,
+                     std::size_t last, int shift, std::size_t *counts) {
+        for(std::size_t i = first; i < last; i++) {
+            counts[(keys[i] >> shift) & (BUCKETS - 1)]++;
+        }
+    }
+
+    // moves keys [first, last) to their digit's next free slot
+    void scatterDigits(const uint64_t *keys, uint64_t *sorted,
+                       std::size_t first, std::size_t last, int shift,
+                       std::size_t *offsets) {
+        for(std::size_t i = first; i < last; i++) {
+            sorted[offsets[(keys[i] >> shift) & (BUCKETS - 1)]++] = keys[i];
+        }
+    }
+}
+
+void parallelRadixSort(uint64_t *keys, uint64_t *scratch, std::size_t count,
+                       int threads) {
+    using namespace std;
+
+    uint64_t *source = keys;
+    uint64_t *sorted = scratch;
+    size_t chunk = 0;
+    size_t total = 0;
+    vector<size_t> counts;
+    vector<thread> workers;
+    bool trivial = false;
+
+    if(threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+
+    // small inputs are not worth the threads
+    threads = static_cast<int>(min(static_cast<size_t>(threads),
+                                   max(count / MIN_CHUNK,
+                                       static_cast<size_t>(1))));
+    chunk = (count + threads - 1) / threads;
+    counts.resize(static_cast<size_t>(threads) * BUCKETS);
+
+    for(int pass = 0; pass < PASSES; pass++) {
+        int shift = pass * RADIX_BITS;
+
+        fill(counts.begin(), counts.end(), 0);
+        workers.clear();
+
+        for(int t = 0; t < threads; t++) {
+            workers.push_back(thread(countDigits, source,
+                                     min(count, t * chunk),
+                                     min(count, (t + 1) * chunk), shift,
+                                     &counts[t * BUCKETS]));
+        }
+
+        for(size_t t = 0; t < workers.size(); t++) {
+            workers[t].join();
+        }
+
+        // per-thread offsets, digit-major so equal keys keep their order
+        total = 0;
+        trivial = false;
+
+        for(int d = 0; d < BUCKETS; d++) {
+            size_t digitTotal = 0;
+
+            for(int t = 0; t < threads; t++) {
+                size_t c = counts[t * BUCKETS + d];
+
+                counts[t * BUCKETS + d] = total;
+                total += c;
+                digitTotal += c;
+            }
+
+            trivial = trivial || digitTotal == count;
+        }
+
+        // every key has the same digit, nothing moves
+        if(trivial) {
+            continue;
+        }
+
+        workers.clear();
+
+        for(int t = 0; t < threads; t++) {
+            workers.push_back(thread(scatterDigits, source, sorted,
+                                     min(count, t * chunk),
+                                     min(count, (t + 1) * chunk), shift,
+                                     &counts[t * BUCKETS]));
+        }
+
+        for(size_t t = 0; t < workers.size(); t++) {
+            workers[t].join();
+        }
+
+        swap(source, sorted);
+    }
+
+    if(source != keys) {
+        copy(source, source + count, keys);
+    }
+}
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,25 @@
+/// @brief Header file for the parallel radix sort
+/// @file radixSort.h
+
+#ifndef H_RADIXSORT
+#define H_RADIXSORT
+
+#include <cstddef>
+#include <cstdint>
+
+/// ----------------------------------------------------------------------------
+/// @brief Sorts 64-bit keys in ascending order with a least-significant-digit
+/// radix sort (8-bit digits).  Each pass counts digits per thread over
+/// contiguous chunks, turns the counts into per-thread output offsets and
+/// scatters stably in parallel; passes whose digit is the same for every key
+/// are skipped, so narrow keys take fewer passes.
+///
+/// @param keys Keys to sort, sorted on return
+/// @param scratch Buffer of at least count keys
+/// @param count Number of keys
+/// @param threads Worker threads, 0 for one per hardware thread
+/// ----------------------------------------------------------------------------
+void parallelRadixSort(uint64_t *keys, uint64_t *scratch, std::size_t count,
+                       int threads = 0);
+
+#endif /* H_RADIXSORT */
@@ -0,0 +1,105 @@
+/// @brief Implementation file for class resourceProfile
+/// @file resourceProfile.cpp
+
+#include "resourceProfile.h"
+
+#include <algorithm>
+#include <iterator>
+
+/// ----------------------------------------------------------------------------
+
+resourceProfile::resourceProfile(int64_t units) {
+    capacity = units;
+    peak = 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+int64_t resourceProfile::getCapacity() const {
+    return capacity;
+}
+
+/// ----------------------------------------------------------------------------
+
+int64_t resourceProfile::getPeak() const {
+    return peak;
+}
+
+/// ----------------------------------------------------------------------------
+
+int64_t resourceProfile::earliestFit(int64_t start, int64_t length,
+                                     int64_t demand) const {
+    std::map<int64_t, int64_t>::const_iterator next;
+    int64_t used = 0;
+
+    if(length <= 0 || demand <= 0) {
+        return start;
+    }
+
+    next = usage.upper_bound(start);
+    used = (next == usage.begin()) ? 0 : std::prev(next)->second;
+
+    while(used + demand <= capacity) {
+        if(next == usage.end() || next->first >= start + length) {
+            return start;
+        }
+
+        used = next->second;
+        ++next;
+    }
+
+    // every reservation ends, so the usage drops back before the end
+    while(next != usage.end() && next->second + demand > capacity) {
+        ++next;
+    }
+
+    return (next != usage.end()) ? next->first : start + length;
+}
+
+/// ----------------------------------------------------------------------------
+
+void resourceProfile::reserve(int64_t start, int64_t length, int64_t demand) {
+    std::map<int64_t, int64_t>::iterator first;
+    std::map<int64_t, int64_t>::iterator last;
+
+    if(length <= 0 || demand <= 0) {
+        return;
+    }
+
+    first = split(start);
+    last = split(start + length);
+
+    for(std::map<int64_t, int64_t>::iterator p = first; p != last; ++p) {
+        p->second += demand;
+        peak = std::max(peak, p->second);
+    }
+
+    merge(last);
+    merge(first);
+}
+
+/// ----------------------------------------------------------------------------
+
+std::map<int64_t, int64_t>::iterator resourceProfile::split(int64_t time) {
+    std::map<int64_t, int64_t>::iterator point = usage.lower_bound(time);
+
+    if(point != usage.end() && point->first == time) {
+        return point;
+    }
+
+    return usage.insert(point, std::make_pair(time,
+                                              (point == usage.begin())
+                                              ? 0 : std::prev(point)->second));
+}
+
+/// ----------------------------------------------------------------------------
+
+void resourceProfile::merge(std::map<int64_t, int64_t>::iterator point) {
+    int64_t before = (point == usage.begin()) ? 0 : std::prev(point)->second;
+
+    if(point->second == before) {
+        usage.erase(point);
+    }
+}
+
+/// ----------------------------------------------------------------------------
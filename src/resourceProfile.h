@@ -0,0 +1,80 @@
+/// @brief Header file for class resourceProfile
+/// @file resourceProfile.h
+
+#ifndef H_RESOURCEPROFILE
+#define H_RESOURCEPROFILE
+
+#include <cstdint>
+#include <map>
+
+/// ----------------------------------------------------------------------------
+/// @class resourceProfile
+///
+/// @brief Units of one resource in use over time, a step function kept as
+/// a balanced tree of breakpoints (the time usage changes, and the usage
+/// from then on).  Finding the usage at any time, and the breakpoints a
+/// reservation starts or ends at, is a logarithmic lookup; checking or
+/// reserving a window then only visits the breakpoints inside it, which
+/// are the reservations overlapping it rather than all of them.
+/// ----------------------------------------------------------------------------
+class resourceProfile {
+private:
+    int64_t capacity;                   /// units available at any time
+    std::map<int64_t, int64_t> usage;   /// units in use from each breakpoint
+                                        /// to the next, none before the first
+    int64_t peak;                       /// most units in use at once
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Creates an unused resource.
+    ///
+    /// @param units Capacity
+    explicit resourceProfile(int64_t units = 0);
+
+    /// -----------------------------------------------------------------------
+    /// @return Capacity
+    int64_t getCapacity() const;
+
+    /// -----------------------------------------------------------------------
+    /// @return Most units in use at once so far
+    int64_t getPeak() const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Checks whether a demand fits from a start time on.
+    ///
+    /// @param start Start time
+    /// @param length Time the units are held
+    /// @param demand Units, at most the capacity
+    ///
+    /// @return start if the units are free over [start, start + length),
+    /// else the end of the first stretch where they are not, the earliest
+    /// later start worth checking
+    int64_t earliestFit(int64_t start, int64_t length, int64_t demand) const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Takes units over [start, start + length), where
+    /// earliestFit() returned start.
+    ///
+    /// @param start Start time
+    /// @param length Time the units are held
+    /// @param demand Units
+    void reserve(int64_t start, int64_t length, int64_t demand);
+
+private:
+    /// -----------------------------------------------------------------------
+    /// @brief Makes a breakpoint at a time, with the usage already in
+    /// effect there.
+    ///
+    /// @param time Time
+    ///
+    /// @return The breakpoint
+    std::map<int64_t, int64_t>::iterator split(int64_t time);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Removes a breakpoint that no longer changes the usage.
+    ///
+    /// @param point Breakpoint
+    void merge(std::map<int64_t, int64_t>::iterator point);
+};
+
+#endif /* H_RESOURCEPROFILE */
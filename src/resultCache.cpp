@@ -0,0 +1,293 @@
+/// @brief Implementation file for class resultCache
+/// @file resultCache.cpp
+
+#include "resultCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace {
+    const std::size_t HASH_BLOCK = 1 << 20;     // bytes hashed at a time
+    const char ENTRY_SUFFIX[] = ".res";
+
+    const uint64_t PRIME1 = 11400714785074694791ULL;
+    const uint64_t PRIME2 = 14029467366897019727ULL;
+    const uint64_t PRIME3 = 1609587929392839161ULL;
+    const uint64_t PRIME4 = 9650029242287828579ULL;
+    const uint64_t PRIME5 = 2870177450012600261ULL;
+
+    uint64_t rotate(uint64_t x, int bits) {
+        return (x << bits) | (x >> (64 - bits));
+    }
+
+    // little-endian loads, whatever the alignment
+    uint64_t load64(const unsigned char *p) {
+        uint64_t x = 0;
+
+        for(int i = 7; i >= 0; i--) {
+            x = (x << 8) | p[i];
+        }
+
+        return x;
+    }
+
+    uint64_t load32(const unsigned char *p) {
+        return static_cast<uint64_t>(p[0]) | static_cast<uint64_t>(p[1]) << 8
+               | static_cast<uint64_t>(p[2]) << 16
+               | static_cast<uint64_t>(p[3]) << 24;
+    }
+
+    uint64_t mixLane(uint64_t lane, uint64_t input) {
+        return rotate(lane + input * PRIME2, 31) * PRIME1;
+    }
+
+    uint64_t mergeLane(uint64_t hash, uint64_t lane) {
+        return (hash ^ mixLane(0, lane)) * PRIME1 + PRIME4;
+    }
+
+    // XXH64 fed in pieces: whole 32-byte stripes go through the four
+    // lanes, the rest waits in tail for the next piece or the digest
+    struct xxh64 {
+        uint64_t lane[4];
+        unsigned char tail[32];
+        std::size_t tailBytes;
+        uint64_t total;
+
+        xxh64() {
+            lane[0] = PRIME1 + PRIME2;
+            lane[1] = PRIME2;
+            lane[2] = 0;
+            lane[3] = 0 - PRIME1;
+            tailBytes = 0;
+            total = 0;
+        }
+
+        void stripe(const unsigned char *p) {
+            for(int i = 0; i < 4; i++) {
+                lane[i] = mixLane(lane[i], load64(p + 8 * i));
+            }
+        }
+
+        void update(const unsigned char *p, std::size_t bytes) {
+            total += bytes;
+
+            if(tailBytes > 0) {
+                std::size_t fill = std::min(bytes, 32 - tailBytes);
+
+                memcpy(tail + tailBytes, p, fill);
+                tailBytes += fill;
+                p += fill;
+                bytes -= fill;
+
+                if(tailBytes < 32) {
+                    return;
+                }
+
+                stripe(tail);
+                tailBytes = 0;
+            }
+
+            for(; bytes >= 32; p += 32, bytes -= 32) {
+                stripe(p);
+            }
+
+            memcpy(tail, p, bytes);
+            tailBytes = bytes;
+        }
+
+        uint64_t digest() const {
+            const unsigned char *p = tail;
+            const unsigned char *end = tail + tailBytes;
+            uint64_t hash = 0;
+
+            if(total >= 32) {
+                hash = rotate(lane[0], 1) + rotate(lane[1], 7)
+                       + rotate(lane[2], 12) + rotate(lane[3], 18);
+
+                for(int i = 0; i < 4; i++) {
+                    hash = mergeLane(hash, lane[i]);
+                }
+            } else {
+                hash = PRIME5;
+            }
+
+            hash += total;
+
+            for(; p + 8 <= end; p += 8) {
+                hash = rotate(hash ^ mixLane(0, load64(p)), 27) * PRIME1
+                       + PRIME4;
+            }
+
+            if(p + 4 <= end) {
+                hash = rotate(hash ^ (load32(p) * PRIME1), 23) * PRIME2
+                       + PRIME3;
+                p += 4;
+            }
+
+            for(; p < end; p++) {
+                hash = rotate(hash ^ (*p * PRIME5), 11) * PRIME1;
+            }
+
+            hash ^= hash >> 33;
+            hash *= PRIME2;
+            hash ^= hash >> 29;
+            hash *= PRIME3;
+            hash ^= hash >> 32;
+
+            return hash;
+        }
+    };
+
+    // true if name ends in the entry suffix
+    bool isEntry(const char *name) {
+        std::size_t length = strlen(name);
+        std::size_t suffix = sizeof(ENTRY_SUFFIX) - 1;
+
+        return length > suffix
+               && strcmp(name + length - suffix, ENTRY_SUFFIX) == 0;
+    }
+}
+
+bool hashFile(const std::string& fileName, uint64_t& hash, uint64_t& size) {
+    std::vector<unsigned char> block(HASH_BLOCK);
+    xxh64 state;
+    ssize_t bytes = 0;
+    int file = ::open(fileName.c_str(), O_RDONLY);
+
+    if(file < 0) {
+        return false;
+    }
+
+    posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    while((bytes = ::read(file, &block[0], block.size())) > 0) {
+        state.update(&block[0], static_cast<std::size_t>(bytes));
+    }
+
+    ::close(file);
+    hash = state.digest();
+    size = state.total;
+
+    return bytes == 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+resultCache::resultCache() {
+    limit = 0;
+    hash = 0;
+    size = 0;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool resultCache::open(const std::string& cacheDir, uint64_t limitBytes,
+                       const std::string& fileName) {
+    struct stat info;
+
+    directory.clear();
+    mkdir(cacheDir.c_str(), 0777);
+
+    if(stat(cacheDir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)
+       || !hashFile(fileName, hash, size)) {
+        return false;
+    }
+
+    directory = cacheDir;
+    limit = limitBytes;
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool resultCache::isOpen() const {
+    return !directory.empty();
+}
+
+/// ----------------------------------------------------------------------------
+
+std::string resultCache::entry(std::size_t idxBytes, std::size_t wgtBytes,
+                               bool integral, bool reduce) const {
+    char name[64];
+
+    // e.g. "0123456789abcdef-4i8r.res" for 32-bit indices, 64-bit integer
+    // weights and the reduced task list
+    snprintf(name, sizeof(name), "%016llx-%zu%c%zu%s%s",
+             static_cast<unsigned long long>(hash), idxBytes,
+             integral ? 'i' : 'f', wgtBytes, reduce ? "r" : "",
+             ENTRY_SUFFIX);
+
+    return directory + "/" + name;
+}
+
+/// ----------------------------------------------------------------------------
+
+uint64_t resultCache::getHash() const {
+    return hash;
+}
+
+/// ----------------------------------------------------------------------------
+
+uint64_t resultCache::getSize() const {
+    return size;
+}
+
+/// ----------------------------------------------------------------------------
+
+void resultCache::touch(const std::string& path) const {
+    utimes(path.c_str(), nullptr);
+}
+
+/// ----------------------------------------------------------------------------
+
+void resultCache::evict() const {
+    using namespace std;
+
+    // (last use in s and ns, bytes), path, so the oldest sort first
+    typedef pair<pair<pair<long long, long long>, uint64_t>, string> usedEntry;
+
+    vector<usedEntry> entries;
+    uint64_t total = 0;
+    DIR *dir = opendir(directory.c_str());
+    struct dirent *item = nullptr;
+    struct stat info;
+
+    if(dir == nullptr) {
+        return;
+    }
+
+    while((item = readdir(dir)) != nullptr) {
+        string path = directory + "/" + item->d_name;
+
+        if(isEntry(item->d_name) && stat(path.c_str(), &info) == 0
+           && S_ISREG(info.st_mode)) {
+            entries.push_back(usedEntry(
+                make_pair(make_pair(static_cast<long long>(info.st_mtim.tv_sec),
+                                    static_cast<long long>(
+                                        info.st_mtim.tv_nsec)),
+                          static_cast<uint64_t>(info.st_size)),
+                path));
+            total += static_cast<uint64_t>(info.st_size);
+        }
+    }
+
+    closedir(dir);
+    sort(entries.begin(), entries.end());
+
+    for(size_t i = 0; i < entries.size() && total > limit; i++) {
+        if(unlink(entries[i].second.c_str()) == 0) {
+            total -= entries[i].first.second;
+        }
+    }
+}
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,91 @@
+/// @brief Header file for class resultCache
+/// @file resultCache.h
+
+#ifndef H_RESULTCACHE
+#define H_RESULTCACHE
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// ----------------------------------------------------------------------------
+/// @brief Hashes a whole file with XXH64 (seed 0), reading it in large
+/// blocks.
+///
+/// @param fileName File to hash
+/// @param hash XXH64 of the file's bytes
+/// @param size # of bytes hashed
+///
+/// @return True if the file could be read, false if not
+/// ----------------------------------------------------------------------------
+bool hashFile(const std::string& fileName, uint64_t& hash, uint64_t& size);
+
+/// ----------------------------------------------------------------------------
+/// @class resultCache
+///
+/// @brief Directory of analysis results keyed by the content of the task
+/// file they were computed from (see ganttUtils::readResults()).  An entry
+/// is named after the task file's XXH64 hash and the storage layout, so an
+/// unchanged file finds its results whatever its name or modification
+/// time.  Entries are stamped when used and the least recently used are
+/// removed once the directory holds more than its size limit.
+/// ----------------------------------------------------------------------------
+class resultCache {
+private:
+    std::string directory;  /// cache directory, empty if not open
+    uint64_t limit;         /// bytes of entries kept, at most
+    uint64_t hash;          /// XXH64 of the task file
+    uint64_t size;          /// task file bytes
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Initializes a cache that is not open.
+    resultCache();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Opens (creating it if needed) the cache directory and hashes
+    /// the task file.
+    ///
+    /// @param cacheDir Cache directory
+    /// @param limitBytes Most bytes of entries to keep
+    /// @param fileName Project tasks file
+    ///
+    /// @return True if the directory and the task file could be used
+    bool open(const std::string& cacheDir, uint64_t limitBytes,
+              const std::string& fileName);
+
+    /// -----------------------------------------------------------------------
+    /// @return True if open() succeeded
+    bool isOpen() const;
+
+    /// -----------------------------------------------------------------------
+    /// @param idxBytes Index width
+    /// @param wgtBytes Weight width
+    /// @param integral Weights are integers
+    /// @param reduce Results are for the reduced task list
+    ///
+    /// @return Path of the entry for the task file and this layout
+    std::string entry(std::size_t idxBytes, std::size_t wgtBytes,
+                      bool integral, bool reduce) const;
+
+    /// -----------------------------------------------------------------------
+    /// @return XXH64 of the task file
+    uint64_t getHash() const;
+
+    /// -----------------------------------------------------------------------
+    /// @return Task file bytes
+    uint64_t getSize() const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Marks an entry as just used.
+    ///
+    /// @param path Entry path
+    void touch(const std::string& path) const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Removes the least recently used entries until the rest fit
+    /// within the size limit.
+    void evict() const;
+};
+
+#endif /* H_RESULTCACHE */
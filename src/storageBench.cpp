@@ -0,0 +1,145 @@
+/// @brief Traversal benchmark of compressed task storage against the
+/// adjacency lists
+/// @file storageBench.cpp
+///
+/// "storageBench <file> [rounds]" reads the project twice per round, once
+/// kept as lists and once compressed, times topoSort(), criticalPath() and
+/// findSlackTimes() on each, and prints the best time of each pass next to
+/// the storage sizes.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "ganttUtils.h"
+
+namespace {
+    const int PASSES = 3;
+    const char *PASS_NAMES[PASSES] = {"Topological Sort", "Critical Path",
+                                      "Slack Times"};
+
+    double elapsed(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                             - start).count();
+    }
+
+    // layout visitor for withLayout(), see projectInfo.cpp
+    struct storageBench {
+        std::string fileName;
+        int rounds;
+
+        template <class idxType, class wgtType>
+        int run() {
+            using namespace std;
+
+            double best[2][PASSES];
+            double total[2] = {0.0, 0.0};
+
+            for(int s = 0; s < 2; s++) {
+                for(int p = 0; p < PASSES; p++) {
+                    best[s][p] = -1.0;
+                }
+            }
+
+            for(int r = 0; r < rounds; r++) {
+                for(int s = 0; s < 2; s++) {
+                    ganttUtils<idxType, wgtType> project;
+                    chrono::steady_clock::time_point start;
+                    double times[PASSES];
+
+                    if(!project.readGraph(fileName)) {
+                        cout << "Error, can not find project file." << endl;
+                        return EXIT_FAILURE;
+                    }
+
+                    if(project.hasWeightOverflow()) {
+                        return LAYOUT_TOO_NARROW;
+                    }
+
+                    if(!project.isValidProject()) {
+                        cout << "Invalid task list." << endl;
+                        return EXIT_FAILURE;
+                    }
+
+                    if(s == 1) {
+                        project.compress();
+                    }
+
+                    start = chrono::steady_clock::now();
+                    project.topoSort();
+                    times[0] = elapsed(start);
+
+                    start = chrono::steady_clock::now();
+                    project.criticalPath();
+                    times[1] = elapsed(start);
+
+                    start = chrono::steady_clock::now();
+                    project.findSlackTimes();
+                    times[2] = elapsed(start);
+
+                    for(int p = 0; p < PASSES; p++) {
+                        if(best[s][p] < 0.0 || times[p] < best[s][p]) {
+                            best[s][p] = times[p];
+                        }
+                    }
+
+                    if(r == 0 && s == 1) {
+                        project.printStorage();
+                    }
+                }
+            }
+
+            cout << "Pass                 Lists (ms)  Compressed (ms)  "
+                 << "Slowdown" << endl << fixed;
+
+            for(int p = 0; p <= PASSES; p++) {
+                double lists = 0.0;
+                double packed = 0.0;
+
+                if(p < PASSES) {
+                    lists = best[0][p];
+                    packed = best[1][p];
+                    total[0] += lists;
+                    total[1] += packed;
+                } else {
+                    lists = total[0];
+                    packed = total[1];
+                }
+
+                cout << left << setw(20) << (p < PASSES ? PASS_NAMES[p]
+                                                        : "Total")
+                     << right << setprecision(2) << setw(11)
+                     << lists * 1000 << setw(17) << packed * 1000
+                     << setw(9) << (lists > 0.0 ? packed / lists : 0.0)
+                     << "x" << endl;
+            }
+
+            return EXIT_SUCCESS;
+        }
+    };
+}
+
+int main(int argc, char *argv[]) {
+    using namespace std;
+
+    ganttLayout layout;
+    storageBench bench;
+
+    bench.rounds = (argc == 3) ? atoi(argv[2]) : 3;
+
+    if(argc < 2 || argc > 3 || bench.rounds <= 0) {
+        cout << "Usage: storageBench <file> [rounds]" << endl;
+        return EXIT_FAILURE;
+    }
+
+    bench.fileName = argv[1];
+
+    if(!readLayout(bench.fileName, layout)) {
+        cout << "Error, can not find project file." << endl;
+        return EXIT_FAILURE;
+    }
+
+    return withLayout(layout, bench);
+}
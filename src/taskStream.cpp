@@ -0,0 +1,353 @@
+/// @brief Implementation file for class taskStream
+/// @file taskStream.cpp
+
+#include "taskStream.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#ifdef GANTT_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+    const std::size_t INPUT_BLOCK = 1 << 18;    // compressed bytes per read
+    const std::size_t DECODED_BLOCK = 1 << 20;  // text bytes per ring block
+    const std::size_t RING_BLOCKS = 4;          // blocks in the ring
+}
+
+/// ----------------------------------------------------------------------------
+
+taskCompression detectCompression(const std::string& fileName) {
+    unsigned char magic[4] = { 0, 0, 0, 0 };
+    ssize_t bytes = 0;
+    int file = ::open(fileName.c_str(), O_RDONLY);
+
+    if(file < 0) {
+        return COMPRESSION_NONE;
+    }
+
+    bytes = ::read(file, magic, sizeof(magic));
+    ::close(file);
+
+    if(bytes >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+        return COMPRESSION_GZIP;
+    }
+
+    if(bytes == 4 && magic[0] == 0x28 && magic[1] == 0xb5
+       && magic[2] == 0x2f && magic[3] == 0xfd) {
+        return COMPRESSION_ZSTD;
+    }
+
+    return COMPRESSION_NONE;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool canDecompress(taskCompression kind) {
+#ifdef GANTT_ZSTD
+    return kind == COMPRESSION_NONE || kind == COMPRESSION_GZIP
+           || kind == COMPRESSION_ZSTD;
+#else
+    return kind == COMPRESSION_NONE || kind == COMPRESSION_GZIP;
+#endif
+}
+
+/// ----------------------------------------------------------------------------
+
+inflateBuffer::inflateBuffer() {
+    file = -1;
+    kind = COMPRESSION_NONE;
+    produced = 0;
+    consumed = 0;
+    holding = false;
+    finished = false;
+    corrupt = false;
+    closing = false;
+}
+
+/// ----------------------------------------------------------------------------
+
+inflateBuffer::~inflateBuffer() {
+    if(worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closing = true;
+        }
+
+        emptied.notify_all();
+        worker.join();
+    }
+
+    if(file >= 0) {
+        ::close(file);
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+bool inflateBuffer::open(const std::string& fileName,
+                         taskCompression compression) {
+    if(file >= 0 || compression == COMPRESSION_NONE
+       || !canDecompress(compression)) {
+        return false;
+    }
+
+    file = ::open(fileName.c_str(), O_RDONLY);
+
+    if(file < 0) {
+        return false;
+    }
+
+    posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    kind = compression;
+    blocks.assign(RING_BLOCKS, std::vector<char>(DECODED_BLOCK));
+    sizes.assign(RING_BLOCKS, 0);
+    worker = std::thread(&inflateBuffer::decompress, this);
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool inflateBuffer::isCorrupt() {
+    std::lock_guard<std::mutex> guard(lock);
+
+    return corrupt;
+}
+
+/// ----------------------------------------------------------------------------
+
+inflateBuffer::int_type inflateBuffer::underflow() {
+    std::unique_lock<std::mutex> guard(lock);
+    char *block = nullptr;
+
+    if(gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    if(holding) {
+        consumed++;
+        holding = false;
+        emptied.notify_one();
+    }
+
+    while(produced == consumed && !finished) {
+        filled.wait(guard);
+    }
+
+    if(produced == consumed) {
+        setg(nullptr, nullptr, nullptr);
+        return traits_type::eof();
+    }
+
+    block = &blocks[consumed % blocks.size()][0];
+    holding = true;
+    setg(block, block, block + sizes[consumed % blocks.size()]);
+
+    return traits_type::to_int_type(*gptr());
+}
+
+/// ----------------------------------------------------------------------------
+
+void inflateBuffer::decompress() {
+    bool valid = (kind == COMPRESSION_GZIP) ? inflateGzip() : inflateZstd();
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    finished = true;
+    corrupt = !valid;
+    filled.notify_one();
+}
+
+/// ----------------------------------------------------------------------------
+
+bool inflateBuffer::inflateGzip() {
+    std::vector<unsigned char> input(INPUT_BLOCK);
+    z_stream stream;
+    char *out = nullptr;
+    std::size_t used = 0;       // bytes of the current block
+    ssize_t bytes = 0;
+    int result = Z_OK;
+    bool ended = false;         // the last member is complete
+
+    memset(&stream, 0, sizeof(stream));
+
+    // 32 added to the window bits reads a gzip (or zlib) header
+    if(inflateInit2(&stream, 15 + 32) != Z_OK) {
+        return false;
+    }
+
+    out = nextBlock();
+
+    while(out != nullptr && result == Z_OK) {
+        bytes = ::read(file, &input[0], INPUT_BLOCK);
+
+        if(bytes <= 0) {
+            break;
+        }
+
+        stream.next_in = &input[0];
+        stream.avail_in = static_cast<uInt>(bytes);
+
+        while(out != nullptr) {
+            // concatenated files are members of one gzip file
+            if(ended && stream.avail_in > 0) {
+                inflateReset(&stream);
+                ended = false;
+            }
+
+            stream.next_out = reinterpret_cast<Bytef*>(out + used);
+            stream.avail_out = static_cast<uInt>(DECODED_BLOCK - used);
+            result = inflate(&stream, Z_NO_FLUSH);
+            used = DECODED_BLOCK - stream.avail_out;
+
+            if(result == Z_STREAM_END) {
+                ended = true;
+                result = Z_OK;
+            } else if(result == Z_BUF_ERROR) {
+                result = Z_OK;  // nothing left to do with this input
+            }
+
+            if(result != Z_OK) {
+                break;
+            }
+
+            if(used == DECODED_BLOCK) {
+                publish(used);
+                used = 0;
+                out = nextBlock();
+            } else if(stream.avail_in == 0) {
+                break;
+            }
+        }
+    }
+
+    if(out != nullptr && used > 0) {
+        publish(used);
+    }
+
+    inflateEnd(&stream);
+
+    return out == nullptr || (result == Z_OK && bytes == 0 && ended);
+}
+
+/// ----------------------------------------------------------------------------
+
+bool inflateBuffer::inflateZstd() {
+#ifdef GANTT_ZSTD
+    std::vector<char> input(INPUT_BLOCK);
+    ZSTD_DStream *stream = ZSTD_createDStream();
+    char *out = nullptr;
+    std::size_t used = 0;       // bytes of the current block
+    std::size_t pending = 0;    // non-zero inside a frame
+    ssize_t bytes = 0;
+    bool valid = (stream != nullptr);
+
+    if(valid) {
+        ZSTD_initDStream(stream);
+        out = nextBlock();
+    }
+
+    while(out != nullptr && valid) {
+        bytes = ::read(file, &input[0], INPUT_BLOCK);
+
+        if(bytes <= 0) {
+            break;
+        }
+
+        ZSTD_inBuffer in = { &input[0], static_cast<std::size_t>(bytes), 0 };
+
+        while(out != nullptr) {
+            ZSTD_outBuffer text = { out + used, DECODED_BLOCK - used, 0 };
+
+            // frames follow each other without a reset
+            pending = ZSTD_decompressStream(stream, &text, &in);
+
+            if(ZSTD_isError(pending)) {
+                valid = false;
+                break;
+            }
+
+            used += text.pos;
+
+            // a block not filled means all the input so far is flushed
+            if(used == DECODED_BLOCK) {
+                publish(used);
+                used = 0;
+                out = nextBlock();
+            } else if(in.pos == in.size) {
+                break;
+            }
+        }
+    }
+
+    if(out != nullptr && used > 0) {
+        publish(used);
+    }
+
+    ZSTD_freeDStream(stream);
+
+    return out == nullptr || (valid && bytes == 0 && pending == 0);
+#else
+    return false;
+#endif
+}
+
+/// ----------------------------------------------------------------------------
+
+char *inflateBuffer::nextBlock() {
+    std::unique_lock<std::mutex> guard(lock);
+
+    // the block the reader holds counts as full until it is handed back
+    while(produced - consumed == blocks.size() && !closing) {
+        emptied.wait(guard);
+    }
+
+    return closing ? nullptr : &blocks[produced % blocks.size()][0];
+}
+
+/// ----------------------------------------------------------------------------
+
+void inflateBuffer::publish(std::size_t size) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    sizes[produced % blocks.size()] = size;
+    produced++;
+    filled.notify_one();
+}
+
+/// ----------------------------------------------------------------------------
+
+taskStream::taskStream(const std::string& fileName) : std::istream(nullptr) {
+    kind = detectCompression(fileName);
+
+    if(kind == COMPRESSION_NONE) {
+        if(plain.open(fileName, std::ios::in) != nullptr) {
+            rdbuf(&plain);
+        }
+    } else if(packed.open(fileName, kind)) {
+        rdbuf(&packed);
+    }
+
+    if(rdbuf() == nullptr) {
+        setstate(std::ios::failbit);
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+taskCompression taskStream::compression() const {
+    return kind;
+}
+
+/// ----------------------------------------------------------------------------
+
+bool taskStream::isCorrupt() {
+    return kind != COMPRESSION_NONE && packed.isCorrupt();
+}
+
+/// ----------------------------------------------------------------------------
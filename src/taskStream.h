@@ -0,0 +1,159 @@
+/// @brief Header file for class taskStream
+/// @file taskStream.h
+
+#ifndef H_TASKSTREAM
+#define H_TASKSTREAM
+
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// ----------------------------------------------------------------------------
+/// @brief How a task file is stored, told by its first bytes.
+/// ----------------------------------------------------------------------------
+enum taskCompression {
+    COMPRESSION_NONE,       /// plain text
+    COMPRESSION_GZIP,       /// gzip (1f 8b)
+    COMPRESSION_ZSTD        /// zstd (28 b5 2f fd)
+};
+
+/// ----------------------------------------------------------------------------
+/// @brief Reads the magic bytes of a file.
+///
+/// @param fileName File
+///
+/// @return The file's compression, COMPRESSION_NONE if it can not be read
+/// ----------------------------------------------------------------------------
+taskCompression detectCompression(const std::string& fileName);
+
+/// ----------------------------------------------------------------------------
+/// @return True if this build reads files compressed that way (zstd needs
+/// a build with ZSTD=1)
+/// ----------------------------------------------------------------------------
+bool canDecompress(taskCompression kind);
+
+/// ----------------------------------------------------------------------------
+/// @class inflateBuffer
+///
+/// @brief Stream buffer over a compressed file.  A decompressor thread
+/// reads the file and fills a ring of fixed blocks that the reading thread
+/// takes in turn, so decompression overlaps with whatever the reader does
+/// with the text, and memory stays at the ring whatever the file's size.
+/// ----------------------------------------------------------------------------
+class inflateBuffer : public std::streambuf {
+private:
+    int file;                       /// compressed file descriptor
+    taskCompression kind;           /// file's compression
+    std::vector<std::vector<char> > blocks;     /// decompressed text ring
+    std::vector<std::size_t> sizes; /// bytes of each block
+    std::size_t produced;           /// blocks filled so far
+    std::size_t consumed;           /// blocks handed back so far
+    bool holding;                   /// the reader holds block consumed
+    bool finished;                  /// no more blocks will be filled
+    bool corrupt;                   /// the file did not decompress
+    bool closing;                   /// the decompressor is to stop
+    std::mutex lock;                /// guards the counts and flags
+    std::condition_variable filled; /// a block was filled or finished
+    std::condition_variable emptied;    /// a block was handed back
+    std::thread worker;             /// decompressor
+
+    inflateBuffer(const inflateBuffer&);
+    inflateBuffer& operator=(const inflateBuffer&);
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Initializes class member variables.
+    inflateBuffer();
+
+    /// -----------------------------------------------------------------------
+    /// @brief (Destructor) Stops the decompressor and closes the file.
+    ~inflateBuffer();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Opens a compressed file and starts its decompressor.
+    ///
+    /// @param fileName File
+    /// @param compression File's compression, see detectCompression()
+    ///
+    /// @return False if the file can not be opened or this build does not
+    /// decompress it
+    bool open(const std::string& fileName, taskCompression compression);
+
+    /// -----------------------------------------------------------------------
+    /// @return True if the text ended early because the file is damaged or
+    /// truncated; only final once the text has been read to its end
+    bool isCorrupt();
+
+protected:
+    /// -----------------------------------------------------------------------
+    /// @brief Hands the read block back and waits for the next one.
+    ///
+    /// @return First character of the next block, or eof
+    int_type underflow();
+
+private:
+    /// -----------------------------------------------------------------------
+    /// @brief Decompressor thread body.
+    void decompress();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Decompresses a gzip file (any # of members) into the ring.
+    ///
+    /// @return False if the file is damaged or truncated
+    bool inflateGzip();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Decompresses a zstd file (any # of frames) into the ring.
+    ///
+    /// @return False if the file is damaged or truncated
+    bool inflateZstd();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Waits for a free block of the ring.
+    ///
+    /// @return The block, or nullptr once the buffer is closing
+    char *nextBlock();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Passes the block from nextBlock() on to the reader.
+    ///
+    /// @param size Bytes written to it
+    void publish(std::size_t size);
+};
+
+/// ----------------------------------------------------------------------------
+/// @class taskStream
+///
+/// @brief Input stream over a task file, plain or compressed.  A plain file
+/// is read through a std::filebuf, as an ifstream would, and can seek; a
+/// compressed one is read through an inflateBuffer and can not.
+/// ----------------------------------------------------------------------------
+class taskStream : public std::istream {
+private:
+    std::filebuf plain;         /// plain file
+    inflateBuffer packed;       /// compressed file
+    taskCompression kind;       /// file's compression
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Opens a task file; the stream fails if it can
+    /// not be opened or decompressed.
+    ///
+    /// @param fileName Task file
+    explicit taskStream(const std::string& fileName);
+
+    /// -----------------------------------------------------------------------
+    /// @return The file's compression
+    taskCompression compression() const;
+
+    /// -----------------------------------------------------------------------
+    /// @return True if a compressed file turned out damaged or truncated
+    bool isCorrupt();
+};
+
+#endif /* H_TASKSTREAM */
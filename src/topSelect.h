@@ -0,0 +1,117 @@
+/// @brief Implementation file for template class boundedHeap
+/// @file topSelect.h
+
+#ifndef H_TOPSELECT
+#define H_TOPSELECT
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/// ----------------------------------------------------------------------------
+/// @class boundedHeap
+///
+/// @brief The k best items pushed so far, where rankOrder(a, b) is true if
+/// a ranks before b.  The worst item kept is at the front of the heap, so
+/// each push keeps or drops an item in O(log k) and a pass over n items
+/// takes O(n log k) time and O(k) memory.  Each thread ranking part of the
+/// items fills a heap of its own; mergeTop() then picks the best of all.
+/// ----------------------------------------------------------------------------
+template <class itemType, class rankOrder>
+class boundedHeap {
+private:
+    std::vector<itemType> items;    /// kept items, worst first
+    std::size_t limit;              /// k
+    rankOrder before;               /// ranking
+
+public:
+    /// ------------------------------------------------------------------------
+    /// @brief (Constructor) Creates an empty heap.
+    ///
+    /// @param k Most items kept
+    /// @param order Ranking
+    /// ------------------------------------------------------------------------
+    boundedHeap(std::size_t k, const rankOrder& order);
+
+    /// ------------------------------------------------------------------------
+    /// @brief Keeps an item if fewer than k are kept or it ranks before the
+    /// worst of them, which it then replaces.
+    ///
+    /// @param item Item
+    /// ------------------------------------------------------------------------
+    void push(const itemType& item);
+
+    /// ------------------------------------------------------------------------
+    /// @return Kept items, in heap order
+    /// ------------------------------------------------------------------------
+    const std::vector<itemType>& contents() const;
+};
+
+/// ----------------------------------------------------------------------------
+/// @brief Merges per-thread heaps into the k best items overall, best
+/// first.  The T * k candidates are cut to k with nth_element and only
+/// those are sorted.
+///
+/// @param heaps Heaps of the threads
+/// @param k Most items
+/// @param order Ranking
+/// @param top Receives the items
+/// ----------------------------------------------------------------------------
+template <class itemType, class rankOrder>
+void mergeTop(const std::vector<boundedHeap<itemType, rankOrder> >& heaps,
+              std::size_t k, const rankOrder& order,
+              std::vector<itemType>& top);
+
+/// ----------------------------------------------------------------------------
+
+template <class itemType, class rankOrder>
+boundedHeap<itemType, rankOrder>::boundedHeap(std::size_t k,
+                                              const rankOrder& order)
+    : limit(k), before(order) {
+    items.reserve(k);
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class itemType, class rankOrder>
+void boundedHeap<itemType, rankOrder>::push(const itemType& item) {
+    if(items.size() < limit) {
+        items.push_back(item);
+        std::push_heap(items.begin(), items.end(), before);
+    } else if(limit > 0 && before(item, items.front())) {
+        std::pop_heap(items.begin(), items.end(), before);
+        items.back() = item;
+        std::push_heap(items.begin(), items.end(), before);
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class itemType, class rankOrder>
+const std::vector<itemType>& boundedHeap<itemType, rankOrder>::contents()
+    const {
+    return items;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class itemType, class rankOrder>
+void mergeTop(const std::vector<boundedHeap<itemType, rankOrder> >& heaps,
+              std::size_t k, const rankOrder& order,
+              std::vector<itemType>& top) {
+    top.clear();
+
+    for(std::size_t t = 0; t < heaps.size(); t++) {
+        top.insert(top.end(), heaps[t].contents().begin(),
+                   heaps[t].contents().end());
+    }
+
+    if(top.size() > k) {
+        std::nth_element(top.begin(), top.begin() + k, top.end(), order);
+        top.resize(k);
+    }
+
+    std::sort(top.begin(), top.end(), order);
+}
+
+#endif /* H_TOPSELECT */
@@ -0,0 +1,630 @@
+/// @brief Implementation file for class versionedGraph
+/// @file versionedGraph.cpp
+
+#include "versionedGraph.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    const std::size_t CHUNK = 64;   // milestones per chunk
+}
+
+template <class idxType, class wgtType>
+versionedGraph<idxType, wgtType>::versionedGraph() {
+    current.store(nullptr);
+    epoch.store(1);
+    draft = nullptr;
+
+    for(int r = 0; r < MAX_READERS; r++) {
+        readers[r].epoch.store(0);
+        readers[r].taken.store(false);
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+versionedGraph<idxType, wgtType>::~versionedGraph() {
+    if(draft != nullptr) {
+        abandon();
+    }
+
+    for(std::size_t i = 0; i < retired.size(); i++) {
+        release(retired[i]);
+    }
+
+    if(current.load() != nullptr) {
+        release(current.load());
+    }
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool versionedGraph<idxType, wgtType>::load(idxType milestones,
+                                            const std::vector<idxType>& from,
+                                            const std::vector<idxType>& to,
+                                            const std::vector<wgtType>& weight) {
+    std::lock_guard<std::mutex> lock(writer);
+    version_t *version = nullptr;
+    std::size_t chunkCount = (static_cast<std::size_t>(milestones) + CHUNK - 1)
+                             / CHUNK;
+
+    if(current.load() != nullptr) {
+        return false;
+    }
+
+    for(std::size_t e = 0; e < from.size(); e++) {
+        if(from[e] >= milestones || to[e] >= milestones) {
+            return false;
+        }
+    }
+
+    version = new version_t;
+    version->number = 1;
+    version->milestoneCount = milestones;
+    version->taskCount = from.size();
+    version->copiedBlocks = 0;
+    version->retired = 0;
+    version->chunks.resize(chunkCount);
+
+    for(std::size_t c = 0; c < chunkCount; c++) {
+        chunk_t *chunk = new chunk_t;
+
+        chunk->refs = 1;
+
+        for(std::size_t i = 0; i < CHUNK; i++) {
+            chunk->block[i] = nullptr;
+        }
+
+        version->chunks[c] = chunk;
+    }
+
+    for(std::size_t e = 0; e < from.size(); e++) {
+        chunk_t *chunk = version->chunks[from[e] / CHUNK];
+        block_t *&block = chunk->block[from[e] % CHUNK];
+
+        if(block == nullptr) {
+            block = new block_t;
+            block->refs = 1;
+            version->copiedBlocks++;
+        }
+
+        block->to.push_back(to[e]);
+        block->weight.push_back(weight[e]);
+    }
+
+    if(!analyse(version)) {
+        release(version);
+        return false;
+    }
+
+    current.store(version);
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+int versionedGraph<idxType, wgtType>::addReader() {
+    for(int r = 0; r < MAX_READERS; r++) {
+        bool free = false;
+
+        if(readers[r].taken.compare_exchange_strong(free, true)) {
+            return r;
+        }
+    }
+
+    return -1;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void versionedGraph<idxType, wgtType>::removeReader(int reader) {
+    readers[reader].epoch.store(0);
+    readers[reader].taken.store(false);
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+const graphVersion<idxType, wgtType>*
+versionedGraph<idxType, wgtType>::pin(int reader) {
+    // announce the epoch before taking the version: a version replaced
+    // after this load is retired in a later epoch and kept for us, and one
+    // replaced before it is not the version we get
+    readers[reader].epoch.store(epoch.load());
+
+    return current.load();
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void versionedGraph<idxType, wgtType>::unpin(int reader) {
+    readers[reader].epoch.store(0);
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool versionedGraph<idxType, wgtType>::beginEdit() {
+    version_t *base = nullptr;
+
+    writer.lock();
+    base = current.load();
+
+    if(base == nullptr) {
+        writer.unlock();
+        return false;
+    }
+
+    // the draft shares every chunk until it writes to one
+    draft = new version_t;
+    draft->number = base->number + 1;
+    draft->milestoneCount = base->milestoneCount;
+    draft->taskCount = base->taskCount;
+    draft->copiedBlocks = 0;
+    draft->retired = 0;
+    draft->chunks = base->chunks;
+
+    for(std::size_t c = 0; c < draft->chunks.size(); c++) {
+        draft->chunks[c]->refs++;
+    }
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+typename versionedGraph<idxType, wgtType>::block_t*
+versionedGraph<idxType, wgtType>::writableBlock(idxType v) {
+    chunk_t *&chunk = draft->chunks[v / CHUNK];
+    block_t *block = nullptr;
+
+    if(chunk->refs > 1) {
+        chunk_t *copy = new chunk_t;
+
+        copy->refs = 1;
+
+        for(std::size_t i = 0; i < CHUNK; i++) {
+            copy->block[i] = chunk->block[i];
+
+            if(copy->block[i] != nullptr) {
+                copy->block[i]->refs++;
+            }
+        }
+
+        chunk->refs--;
+        chunk = copy;
+    }
+
+    block = chunk->block[v % CHUNK];
+
+    if(block == nullptr) {
+        block = new block_t;
+        block->refs = 1;
+        draft->copiedBlocks++;
+    } else if(block->refs > 1) {
+        block_t *copy = new block_t;
+
+        copy->to = block->to;
+        copy->weight = block->weight;
+        copy->refs = 1;
+        block->refs--;
+        block = copy;
+        draft->copiedBlocks++;
+    }
+
+    chunk->block[v % CHUNK] = block;
+
+    return block;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool versionedGraph<idxType, wgtType>::setTask(idxType from, idxType to,
+                                               wgtType weight) {
+    block_t *block = nullptr;
+
+    if(draft == nullptr || from >= draft->milestoneCount
+       || to >= draft->milestoneCount) {
+        return false;
+    }
+
+    block = writableBlock(from);
+
+    for(std::size_t i = 0; i < block->to.size(); i++) {
+        if(block->to[i] == to) {
+            block->weight[i] = weight;
+            return true;
+        }
+    }
+
+    block->to.push_back(to);
+    block->weight.push_back(weight);
+    draft->taskCount++;
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool versionedGraph<idxType, wgtType>::removeTask(idxType from, idxType to) {
+    const block_t *shared = nullptr;
+    block_t *block = nullptr;
+    std::size_t i = 0;
+
+    if(draft == nullptr || from >= draft->milestoneCount) {
+        return false;
+    }
+
+    // look before copying, a missing task copies nothing
+    shared = draft->tasks(from);
+
+    if(shared == nullptr) {
+        return false;
+    }
+
+    for(i = 0; i < shared->to.size() && shared->to[i] != to; i++) {
+    }
+
+    if(i == shared->to.size()) {
+        return false;
+    }
+
+    block = writableBlock(from);
+    block->to.erase(block->to.begin() + i);
+    block->weight.erase(block->weight.begin() + i);
+    draft->taskCount--;
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool versionedGraph<idxType, wgtType>::publish() {
+    version_t *replaced = nullptr;
+
+    if(draft == nullptr) {
+        return false;
+    }
+
+    if(!analyse(draft)) {
+        abandon();
+        return false;
+    }
+
+    // readers see the old version or the new one, never a mix
+    replaced = current.exchange(draft);
+    replaced->retired = ++epoch;
+    retired.push_back(replaced);
+    draft = nullptr;
+
+    reclaim();
+    writer.unlock();
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void versionedGraph<idxType, wgtType>::abandon() {
+    if(draft == nullptr) {
+        return;
+    }
+
+    release(draft);
+    draft = nullptr;
+    writer.unlock();
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+std::size_t versionedGraph<idxType, wgtType>::retiredCount() const {
+    return retired.size();
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void versionedGraph<idxType, wgtType>::reclaim() {
+    uint64_t oldest = epoch.load();
+    std::size_t kept = 0;
+
+    // a reader pinned in epoch e may hold any version retired after e
+    for(int r = 0; r < MAX_READERS; r++) {
+        uint64_t pinned = readers[r].epoch.load();
+
+        if(pinned != 0 && pinned < oldest) {
+            oldest = pinned;
+        }
+    }
+
+    for(std::size_t i = 0; i < retired.size(); i++) {
+        if(retired[i]->retired <= oldest) {
+            release(retired[i]);
+        } else {
+            retired[kept++] = retired[i];
+        }
+    }
+
+    retired.resize(kept);
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void versionedGraph<idxType, wgtType>::release(version_t *version) {
+    for(std::size_t c = 0; c < version->chunks.size(); c++) {
+        chunk_t *chunk = version->chunks[c];
+
+        if(--chunk->refs > 0) {
+            continue;
+        }
+
+        for(std::size_t i = 0; i < CHUNK; i++) {
+            if(chunk->block[i] != nullptr && --chunk->block[i]->refs == 0) {
+                delete chunk->block[i];
+            }
+        }
+
+        delete chunk;
+    }
+
+    delete version;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool versionedGraph<idxType, wgtType>::analyse(version_t *version) const {
+    const idxType NONE = static_cast<idxType>(-1);
+    const idxType n = version->milestoneCount;
+    std::vector<idxType> indeg(n, 0);
+    std::vector<idxType> order;
+    std::vector<wgtType> tail(n, 0);
+    std::size_t head = 0;
+
+    for(idxType v = 0; v < n; v++) {
+        const block_t *block = version->tasks(v);
+
+        for(std::size_t i = 0; block != nullptr && i < block->to.size(); i++) {
+            indeg[block->to[i]]++;
+        }
+    }
+
+    // Kahn's algorithm, the early starts follow the topological order
+    order.reserve(n);
+    version->early.assign(n, 0);
+
+    for(idxType v = 0; v < n; v++) {
+        if(indeg[v] == 0) {
+            order.push_back(v);
+        }
+    }
+
+    for(; head < order.size(); head++) {
+        idxType v = order[head];
+        const block_t *block = version->tasks(v);
+
+        for(std::size_t i = 0; block != nullptr && i < block->to.size(); i++) {
+            idxType u = block->to[i];
+            wgtType finish = version->early[v] + block->weight[i];
+
+            if(finish > version->early[u]) {
+                version->early[u] = finish;
+            }
+
+            if(--indeg[u] == 0) {
+                order.push_back(u);
+            }
+        }
+    }
+
+    if(order.size() != static_cast<std::size_t>(n)) {
+        return false;
+    }
+
+    // longest path to any end, in reverse topological order
+    version->duration = 0;
+
+    for(std::size_t k = order.size(); k-- > 0; ) {
+        idxType v = order[k];
+        const block_t *block = version->tasks(v);
+
+        for(std::size_t i = 0; block != nullptr && i < block->to.size(); i++) {
+            wgtType length = block->weight[i] + tail[block->to[i]];
+
+            if(length > tail[v]) {
+                tail[v] = length;
+            }
+        }
+
+        if(tail[v] > version->duration) {
+            version->duration = tail[v];
+        }
+    }
+
+    version->late.resize(n);
+
+    for(idxType v = 0; v < n; v++) {
+        version->late[v] = version->duration - tail[v];
+    }
+
+    // lowest milestone starting a longest path, then its lowest tight
+    // successors
+    version->criticalPath.clear();
+    version->finalNode = NONE;
+
+    for(idxType v = 0; v < n && version->finalNode == NONE; v++) {
+        if(version->early[v] == 0 && tail[v] == version->duration) {
+            version->finalNode = v;
+        }
+    }
+
+    for(idxType v = version->finalNode; v != NONE; ) {
+        const block_t *block = version->tasks(v);
+        idxType next = NONE;
+
+        version->criticalPath.push_back(v);
+        version->finalNode = v;
+
+        for(std::size_t i = 0; block != nullptr && i < block->to.size(); i++) {
+            idxType u = block->to[i];
+
+            if(block->weight[i] + tail[u] == tail[v] && u < next) {
+                next = u;
+            }
+        }
+
+        v = next;
+    }
+
+    return true;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+bool versionedGraph<idxType, wgtType>::readEdits(const std::string& editFile,
+                                                 std::ostream& out) {
+    using namespace std;
+
+    ifstream inFile(editFile);
+    string line;
+    string command;
+    bool editing = false;
+    bool valid = true;
+    int reader = addReader();
+    const version_t *version = nullptr;
+
+    if(!inFile || reader < 0) {
+        return false;
+    }
+
+    out << "------------------------------------------------------------\n"
+        << "Edited Versions:\n"
+        << "   Version       Tasks    Duration   Final Task   Path   Copied\n";
+
+    version = pin(reader);
+    printVersion(out, version);
+    unpin(reader);
+
+    while(valid) {
+        bool more = static_cast<bool>(getline(inFile, line));
+        istringstream fields(line);
+        unsigned long long from = 0;
+        unsigned long long to = 0;
+        wgtType weight = 0;
+
+        command.clear();
+        fields >> command;
+
+        if(more && command.empty()) {
+            continue;
+        }
+
+        if(!more || command == "publish") {
+            uint64_t number = 0;
+
+            if(!editing) {
+                if(!more) {
+                    break;
+                }
+
+                continue;
+            }
+
+            number = draft->number;
+            editing = false;
+
+            if(publish()) {
+                version = pin(reader);
+                printVersion(out, version);
+                unpin(reader);
+            } else {
+                out << setw(10) << number << "   has a cycle, not published\n";
+            }
+
+            if(!more) {
+                break;
+            }
+
+            continue;
+        }
+
+        if(!editing && !beginEdit()) {
+            valid = false;
+            break;
+        }
+
+        editing = true;
+
+        if(command == "add") {
+            valid = static_cast<bool>(fields >> from >> to >> weight)
+                    && weight >= 0
+                    && from == static_cast<idxType>(from)
+                    && to == static_cast<idxType>(to)
+                    && setTask(static_cast<idxType>(from),
+                               static_cast<idxType>(to), weight);
+        } else if(command == "remove") {
+            valid = static_cast<bool>(fields >> from >> to)
+                    && from == static_cast<idxType>(from)
+                    && to == static_cast<idxType>(to)
+                    && removeTask(static_cast<idxType>(from),
+                                  static_cast<idxType>(to));
+        } else {
+            valid = false;
+        }
+    }
+
+    if(editing) {
+        abandon();
+    }
+
+    removeReader(reader);
+    out << endl;
+
+    return valid;
+}
+
+/// ----------------------------------------------------------------------------
+
+template <class idxType, class wgtType>
+void versionedGraph<idxType, wgtType>::printVersion(std::ostream& out,
+                                                    const version_t *version) {
+    using namespace std;
+
+    out << setw(10) << version->number << setw(12) << version->taskCount
+        << setw(12) << version->duration << setw(13);
+
+    if(version->criticalPath.empty()) {
+        out << "none";
+    } else {
+        out << static_cast<unsigned long long>(version->finalNode);
+    }
+
+    out << setw(7) << version->criticalPath.size() << setw(9)
+        << version->copiedBlocks << endl;
+}
+
+/// ----------------------------------------------------------------------------
+
+// the six layouts readLayout() can choose
+template class versionedGraph<uint32_t, int32_t>;
+template class versionedGraph<uint32_t, int64_t>;
+template class versionedGraph<uint32_t, double>;
+template class versionedGraph<uint64_t, int32_t>;
+template class versionedGraph<uint64_t, int64_t>;
+template class versionedGraph<uint64_t, double>;
@@ -0,0 +1,260 @@
+/// @brief Header file for class versionedGraph
+/// @file versionedGraph.h
+
+#ifndef H_VERSIONEDGRAPH
+#define H_VERSIONEDGRAPH
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "concurrentQueue.h"
+
+/// ----------------------------------------------------------------------------
+/// @brief Tasks out of one milestone.  Shared by every version whose
+/// milestone has the same tasks, and never changed once published.
+/// ----------------------------------------------------------------------------
+template <class idxType, class wgtType>
+struct taskBlock {
+    std::vector<idxType> to;        /// destination milestones
+    std::vector<wgtType> weight;    /// task weights
+    std::size_t refs;               /// chunks holding the block (writers only)
+};
+
+/// ----------------------------------------------------------------------------
+/// @brief Blocks of 64 consecutive milestones, so that a version copies one
+/// pointer per 64 milestones and an edit one chunk.
+/// ----------------------------------------------------------------------------
+template <class idxType, class wgtType>
+struct blockChunk {
+    static const std::size_t SIZE = 64;     /// milestones per chunk
+
+    taskBlock<idxType, wgtType> *block[SIZE];   /// nullptr if no tasks
+    std::size_t refs;               /// versions holding the chunk (writers only)
+};
+
+/// ----------------------------------------------------------------------------
+/// @brief One immutable version of the task graph with its analysis: the
+/// early and late start of each milestone (longest paths from any start
+/// and to any end), the duration and the critical path.
+/// ----------------------------------------------------------------------------
+template <class idxType, class wgtType>
+struct graphVersion {
+    uint64_t number;                /// 1 for the loaded graph, then + 1
+    idxType milestoneCount;         /// # of milestones
+    std::size_t taskCount;          /// # of tasks
+    std::size_t copiedBlocks;       /// blocks the edits copied or added
+    std::vector<blockChunk<idxType, wgtType>*> chunks;
+
+    std::vector<wgtType> early;     /// earliest start
+    std::vector<wgtType> late;      /// latest start
+    wgtType duration;               /// project duration
+    idxType finalNode;              /// last milestone of the critical path
+    std::vector<idxType> criticalPath;  /// lowest longest path, start first
+
+    uint64_t retired;               /// epoch it was replaced in, 0 if current
+
+    /// -----------------------------------------------------------------------
+    /// @param v Milestone
+    ///
+    /// @return The milestone's tasks, nullptr if it has none
+    const taskBlock<idxType, wgtType>* tasks(idxType v) const {
+        return chunks[v / blockChunk<idxType, wgtType>::SIZE]
+                   ->block[v % blockChunk<idxType, wgtType>::SIZE];
+    }
+};
+
+/// ----------------------------------------------------------------------------
+/// @class versionedGraph
+///
+/// @brief Task graph that planners edit while reports read it.  Each
+/// published version is immutable and shares the task blocks (and chunks
+/// of 64 blocks) it did not change with the version before it, so an edit
+/// costs a copy of the chunk pointers, the blocks it touches and a fresh
+/// analysis.
+///
+/// Readers never lock: pin() announces the reader's epoch in its own slot
+/// and then takes the current version, which stays valid until unpin().
+/// One writer at a time edits a draft between beginEdit() and publish(),
+/// which analyses it and swaps it in with one atomic exchange.  The
+/// replaced version is retired in the next epoch and freed once no reader
+/// is pinned in an earlier epoch (epoch-based reclamation); chunk and block
+/// reference counts, touched only by writers, free what no live version
+/// shares.
+/// ----------------------------------------------------------------------------
+template <class idxType, class wgtType>
+class versionedGraph {
+public:
+    static const int MAX_READERS = 64;  /// reader slots
+
+private:
+    typedef taskBlock<idxType, wgtType> block_t;
+    typedef blockChunk<idxType, wgtType> chunk_t;
+    typedef graphVersion<idxType, wgtType> version_t;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Epoch a reader is pinned in, 0 if none, alone on its cache
+    /// line.
+    struct readerSlot {
+        std::atomic<uint64_t> epoch;
+        std::atomic<bool> taken;
+        char pad[CACHE_LINE];
+    };
+
+    std::atomic<version_t*> current;    /// published version
+    std::atomic<uint64_t> epoch;        /// global epoch, from 1
+    readerSlot readers[MAX_READERS];
+    std::mutex writer;                  /// held from beginEdit() to publish()
+    version_t *draft;                   /// version being edited
+    std::vector<version_t*> retired;    /// replaced, maybe still read
+
+    versionedGraph(const versionedGraph&);
+    versionedGraph& operator=(const versionedGraph&);
+
+public:
+    /// -----------------------------------------------------------------------
+    /// @brief (Constructor) Initializes a graph with no version.
+    versionedGraph();
+
+    /// -----------------------------------------------------------------------
+    /// @brief (Destructor) Frees every version.  No reader may be pinned.
+    ~versionedGraph();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Publishes the first version.
+    ///
+    /// @param milestones # of milestones
+    /// @param from Source milestone of each task
+    /// @param to Destination milestone of each task
+    /// @param weight Weight of each task
+    ///
+    /// @return False if a version exists, a task is out of range or the
+    /// tasks make a cycle
+    bool load(idxType milestones, const std::vector<idxType>& from,
+              const std::vector<idxType>& to,
+              const std::vector<wgtType>& weight);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Takes a reader slot.
+    ///
+    /// @return Slot for pin() and unpin(), -1 if all are taken
+    int addReader();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Frees a reader slot, which must not be pinned.
+    ///
+    /// @param reader Slot
+    void removeReader(int reader);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Pins the current version for a reader.  Lock-free.
+    ///
+    /// @param reader Slot
+    ///
+    /// @return Current version, valid until unpin(), nullptr if none
+    const version_t* pin(int reader);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Lets go of the version pinned by a reader.
+    ///
+    /// @param reader Slot
+    void unpin(int reader);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Starts a draft of the next version, waiting for any other
+    /// writer to publish or abandon its draft.
+    ///
+    /// @return False if no version was loaded (the writer lock is not held)
+    bool beginEdit();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Adds a task to the draft, or sets its weight if it exists.
+    ///
+    /// @param from Source milestone
+    /// @param to Destination milestone
+    /// @param weight Task weight
+    ///
+    /// @return False if there is no draft or a milestone is out of range
+    bool setTask(idxType from, idxType to, wgtType weight);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Removes a task from the draft.
+    ///
+    /// @param from Source milestone
+    /// @param to Destination milestone
+    ///
+    /// @return False if there is no draft or no such task
+    bool removeTask(idxType from, idxType to);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Analyses the draft and makes it the current version, then
+    /// frees the retired versions no reader can still hold.  A draft whose
+    /// tasks make a cycle is abandoned instead.
+    ///
+    /// @return True if the draft was published
+    bool publish();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Drops the draft, the current version stays.
+    void abandon();
+
+    /// -----------------------------------------------------------------------
+    /// @return # of replaced versions not yet freed
+    std::size_t retiredCount() const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Applies an edit script and prints each version it publishes,
+    /// as a reader would see it.  Lines are "add <from> <to> <weight>"
+    /// (adds a task or sets its weight), "remove <from> <to>" and
+    /// "publish"; edits left after the last "publish" are published at the
+    /// end.  A version whose tasks make a cycle is reported and dropped.
+    ///
+    /// @param editFile Edit script
+    /// @param out Output stream
+    ///
+    /// @return False if the script can not be read, a line is malformed or
+    /// names a milestone or task that does not exist
+    bool readEdits(const std::string& editFile, std::ostream& out = std::cout);
+
+private:
+    /// -----------------------------------------------------------------------
+    /// @brief Block of a draft milestone the draft alone holds, copying
+    /// its chunk and block if they are shared.
+    ///
+    /// @param v Milestone
+    ///
+    /// @return The block
+    block_t* writableBlock(idxType v);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Finds the early and late starts, the duration and the
+    /// critical path of a version.
+    ///
+    /// @param version Version
+    ///
+    /// @return False if its tasks make a cycle
+    bool analyse(version_t *version) const;
+
+    /// -----------------------------------------------------------------------
+    /// @brief Frees the retired versions no pinned reader can hold.
+    void reclaim();
+
+    /// -----------------------------------------------------------------------
+    /// @brief Prints one line of the version table.
+    ///
+    /// @param out Output stream
+    /// @param version Version
+    static void printVersion(std::ostream& out, const version_t *version);
+
+    /// -----------------------------------------------------------------------
+    /// @brief Frees a version and the chunks and blocks only it holds.
+    ///
+    /// @param version Version
+    static void release(version_t *version);
+};
+
+#endif /* H_VERSIONEDGRAPH */